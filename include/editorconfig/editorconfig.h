@@ -44,6 +44,9 @@
  * If more than one path specified on the command line, or the paths are
  * reading from stdin (even only one path is read from stdin), the output
  * format would be INI format, instead of the simple "key=value" lines.
+ * The paths read from stdin together are grouped by directory, so that the
+ * EditorConfig files of each directory are read once for all of them, and
+ * their sections are printed in the order of the paths.
  *
  * @htmlonly
  * <table cellpadding="5" cellspacing="5">
@@ -59,6 +62,69 @@
  * </tr>
  *
  * <tr>
+ * <td><em>--property</em> NAME</td>
+ * <td>Only print the property NAME. Can be repeated.</td>
+ * </tr>
+ *
+ * <tr>
+ * <td><em>--watch</em></td>
+ * <td>Keep running after printing the files, and print the files whose
+ * properties change when an EditorConfig file is edited again, until
+ * interrupted. Each file is printed with its path in brackets, even if there
+ * is only one. Only supported on Linux.</td>
+ * </tr>
+ *
+ * <tr>
+ * <td><em>--cache</em></td>
+ * <td>Keep the parsed EditorConfig files in a cache file shared by all the
+ * runs, editorconfig/cache in $XDG_CACHE_HOME or ~/.cache, so that the next
+ * runs only check that the EditorConfig files are unchanged instead of
+ * parsing them and compiling their longer section patterns. Only supported on
+ * POSIX systems.</td>
+ * </tr>
+ *
+ * <tr>
+ * <td><em>--compile-index</em> DIR [<em>-o</em> FILE]</td>
+ * <td>Write an index of the EditorConfig files in the directory tree DIR to
+ * FILE, DIR/.editorconfig.idx by default, instead of printing properties.
+ * FILE must be in DIR or in a parent directory of DIR. See
+ * editorconfig_write_index(). Only supported on POSIX systems.</td>
+ * </tr>
+ *
+ * <tr>
+ * <td><em>--index</em> FILE</td>
+ * <td>Take the EditorConfig files of the directory of FILE and its
+ * subdirectories from the index FILE when their size and modification time
+ * have not changed since it was written. See
+ * editorconfig_handle_set_index(). Only supported on POSIX systems.</td>
+ * </tr>
+ *
+ * <tr>
+ * <td><em>--group</em></td>
+ * <td>Print each distinct set of properties once, and each file as a line
+ * with the ID of its set, instead of the properties of each file. See
+ * @ref grouped.</td>
+ * </tr>
+ *
+ * <tr>
+ * <td><em>--group-binary</em></td>
+ * <td>Write the sets and the files of <em>--group</em> in a binary format that
+ * can be mapped in memory. See @ref grouped.</td>
+ * </tr>
+ *
+ * <tr>
+ * <td><em>--daemon</em></td>
+ * <td>Ask editorconfig-daemon for the properties of the files if it is
+ * running, and parse them in process otherwise. See @ref server.</td>
+ * </tr>
+ *
+ * <tr>
+ * <td><em>--server</em></td>
+ * <td>Answer the requests of an editor read from stdin until its end, instead
+ * of the FILEPATHs. See @ref server.</td>
+ * </tr>
+ *
+ * <tr>
  * <td><em>-h</em> OR <em>--help</em></td>
  * <td>Print this help message.</td>
  * </tr>
@@ -76,12 +142,128 @@
  *
  * \-b             Specify version (used by devs to test compatibility).
  *
+ * \-\-property NAME   Only print the property NAME. Can be repeated.
+ *
+ * \-\-watch        Keep running after printing the files, and print the files
+ * whose properties change when an EditorConfig file is edited again, until
+ * interrupted. Each file is printed with its path in brackets, even if there
+ * is only one. Only supported on Linux.
+ *
+ * \-\-cache        Keep the parsed EditorConfig files in a cache file shared by
+ * all the runs, editorconfig/cache in $XDG_CACHE_HOME or ~/.cache, so that the
+ * next runs only check that the EditorConfig files are unchanged instead of
+ * parsing them and compiling their longer section patterns. Only supported on
+ * POSIX systems.
+ *
+ * \-\-compile-index DIR [\-o FILE]   Write an index of the EditorConfig files in
+ * the directory tree DIR to FILE, DIR/.editorconfig.idx by default, instead of
+ * printing properties. FILE must be in DIR or in a parent directory of DIR.
+ * Only supported on POSIX systems.
+ *
+ * \-\-index FILE   Take the EditorConfig files of the directory of FILE and its
+ * subdirectories from the index FILE when their size and modification time
+ * have not changed since it was written. Only supported on POSIX systems.
+ *
+ * \-\-group        Print each distinct set of properties once, and each file as
+ * a line with the ID of its set, instead of the properties of each file. See
+ * the GROUPED OUTPUT section.
+ *
+ * \-\-group-binary   Write the sets and the files of \-\-group in a binary
+ * format that can be mapped in memory. See the GROUPED OUTPUT section.
+ *
+ * \-\-daemon       Ask editorconfig-daemon for the properties of the files if it
+ * is running, and parse them in process otherwise. See the SERVER section.
+ *
+ * \-\-server       Answer the requests of an editor read from stdin until its
+ * end, instead of the FILEPATHs. See the SERVER section.
+ *
  * \-h OR \-\-help   Print this help message.
  *
  * \-\-version      Display version information.
  *
  * @endmanonly
  *
+ * @section grouped Grouped Output
+ *
+ * Most files of a tree share their properties with many others. With the
+ * `--group` option, each distinct set of properties is given an ID from 1,
+ * and is printed once, before the first file that has it, as its ID in
+ * brackets followed by its NAME=VALUE lines and an empty line. Each file is
+ * then printed as its path, a tab and the ID of its properties. A file whose
+ * parsing failed has the ID 0, and is followed by the error as a comment
+ * starting with ";". For instance, where the paths are followed by a tab:
+ *
+ *     [1]
+ *     indent_style=space
+ *     indent_size=4
+ *     tab_width=4
+ *
+ *     /home/user/project/a.c 1
+ *     /home/user/project/b.c 1
+ *
+ * With the `--group-binary` option, the same sets and files are written at
+ * the end in a binary format made of 32-bit little-endian integers:
+ *
+ * - A header of six integers: the bytes "ECGR", the version of the format,
+ *   which is 1, the number of sets, the number of properties, the number of
+ *   files and the size of the strings.
+ * - The sets, by ID, each made of the index of its first property and the
+ *   number of its properties. The set 0 is empty.
+ * - The properties, each made of the offsets of its name and of its value in
+ *   the strings.
+ * - The files, in the order they are printed otherwise, each made of the
+ *   offset of its path in the strings and the ID of its set.
+ * - The strings, each followed by a null character.
+ *
+ * The errors are not written in this format.
+ *
+ * @section server Server
+ *
+ * With the `--server` option, the command answers the requests written on its
+ * stdin, so that an editor can start it once and ask for the properties of
+ * each file it opens. The EditorConfig files are kept between the requests,
+ * and are only read again when they were created, modified or removed, which
+ * is seen with inotify on Linux and with stat() elsewhere.
+ *
+ * Each request and each response is a frame made of the decimal length of its
+ * payload in bytes, a newline, and the payload. The payload of a request is
+ * made of lines of the form NAME=VALUE:
+ *
+ * - `file=PATH`: the full path of the file, which is required.
+ * - `conf=NAME`: the name of the EditorConfig files, instead of the one given
+ *   with `-f` or ".editorconfig".
+ * - `version=X.Y.Z`: the version to be compatible with, instead of the one
+ *   given with `-b`.
+ * - `property=NAME`: only return the property NAME. Can be repeated.
+ *
+ * The other lines are ignored. The payload of the response is made of the
+ * NAME=VALUE lines of the properties of the file, or of a single line starting
+ * with ";" that describes the error. For instance, this request and its
+ * response:
+ *
+ *     28
+ *     file=/home/user/project/a.c
+ *
+ *     45
+ *     indent_style=space
+ *     indent_size=4
+ *     tab_width=4
+ *
+ * The command exits when stdin ends, or with the exit status 1 if a frame is
+ * invalid.
+ *
+ * On Linux, the `editorconfig-daemon` command answers the same requests on a
+ * Unix domain socket, so that all the tools of a user share the EditorConfig
+ * files it keeps. A connection can send any number of requests, and gets the
+ * responses in the same order. The socket is `$EDITORCONFIG_SOCKET`,
+ * `$XDG_RUNTIME_DIR/editorconfig.sock` or
+ * `/tmp/editorconfig-UID/editorconfig.sock`, unless another one is given with
+ * `--socket`. The directory in /tmp must belong to the user and be closed to
+ * the other users. The daemon and the command only talk to a process of the
+ * same user at the other end of the socket. With the `--daemon` option, the
+ * `editorconfig` command sends its requests to the daemon, and parses the
+ * files itself if the daemon is not running or stops answering.
+ *
  * @section related Related Pages
  *
  * @ref editorconfig-format
@@ -217,6 +399,8 @@
 # define EDITORCONFIG_EXPORT
 #endif
 
+#include <stddef.h>
+
 #include <editorconfig/editorconfig_handle.h>
 
 #ifdef __cplusplus
@@ -260,6 +444,84 @@ extern "C" {
 EDITORCONFIG_EXPORT
 int editorconfig_parse(const char* full_filename, editorconfig_handle h);
 
+/*!
+ * @brief The type of the callback called by editorconfig_parse_cb() for each
+ * property of the file.
+ *
+ * @param name The name of the property, which is lowercased.
+ *
+ * @param name_len The length of name.
+ *
+ * @param value The value of the property.
+ *
+ * @param value_len The length of value.
+ *
+ * @param user The user pointer given to editorconfig_parse_cb().
+ *
+ * @return 0 to get the next property, nonzero to stop.
+ *
+ * name and value are null-terminated, but they are only valid until the
+ * callback returns and must not be modified.
+ */
+typedef int (*editorconfig_property_cb)(const char* name, size_t name_len,
+        const char* value, size_t value_len, void* user);
+
+/*!
+ * @brief Parse editorconfig files corresponding to the file path given by
+ * full_filename, and pass each resulting property to callback.
+ *
+ * This is the same as editorconfig_parse(), except that the properties are
+ * not copied into h: they are given to callback, in the same order as
+ * editorconfig_handle_get_name_value() would return them, without allocating
+ * memory for each of them. The name value pairs held by h are left unchanged.
+ *
+ * @param full_filename The full path of a file that is edited by the editor
+ * for which the parsing result is.
+ *
+ * @param h The @ref editorconfig_handle to be used. The @ref
+ * editorconfig_handle should be created by editorconfig_handle_init().
+ *
+ * @param callback The function called for each property, until it returns
+ * nonzero.
+ *
+ * @param user A pointer passed as is to callback.
+ *
+ * @return The same values as editorconfig_parse(). callback is not called if
+ * an error occurs. Stopping early from callback is not an error.
+ */
+EDITORCONFIG_EXPORT
+int editorconfig_parse_cb(const char* full_filename, editorconfig_handle h,
+        editorconfig_property_cb callback, void* user);
+
+/*!
+ * @brief Get the value of a single property of the file given by
+ * full_filename.
+ *
+ * The result is the same as the value of name after editorconfig_parse(), but
+ * only the sections that may set name are matched, and the EditorConfig files
+ * are read from the directory of the file upwards, stopping as soon as the
+ * value is known. As a consequence, parsing errors in the EditorConfig files
+ * that are not read are not reported.
+ *
+ * @param full_filename The full path of a file that is edited by the editor
+ * for which the parsing result is.
+ *
+ * @param h The @ref editorconfig_handle to be used. The @ref
+ * editorconfig_handle should be created by editorconfig_handle_init(). The
+ * name value pairs held by h are left unchanged.
+ *
+ * @param name The name of the property, which is case insensitive.
+ *
+ * @param value The pointer pointed by value is set to the value of the
+ * property, or NULL if the property is not set. It is valid until h is used
+ * again or destroyed.
+ *
+ * @return The same values as editorconfig_parse().
+ */
+EDITORCONFIG_EXPORT
+int editorconfig_get_property(const char* full_filename, editorconfig_handle h,
+        const char* name, const char** value);
+
 /*!
  * @brief Get the error message from the error number returned by
  * editorconfig_parse().
@@ -290,6 +552,103 @@ const char* editorconfig_get_error_msg(int err_num);
  */
 #define EDITORCONFIG_PARSE_VERSION_TOO_NEW              (-4)
 
+/*!
+ * @brief The functions all the memory of the library is allocated with,
+ * including the memory of PCRE2.
+ *
+ * The functions must be thread safe if the library is used from several
+ * threads, or if it was built with threads, since large EditorConfig files are
+ * then parsed in parallel.
+ */
+typedef struct editorconfig_allocator
+{
+    /*! Allocate size bytes, suitably aligned for any type, or return NULL.
+     * size is never 0. */
+    void*   (*malloc_fn)(size_t size, void* user);
+    /*! Resize the memory at ptr to size bytes, as realloc() does, or return
+     * NULL. ptr is never NULL and size is never 0. */
+    void*   (*realloc_fn)(void* ptr, size_t size, void* user);
+    /*! Free the memory at ptr, which is never NULL. */
+    void    (*free_fn)(void* ptr, void* user);
+    /*! Passed as is to the functions */
+    void*   user;
+} editorconfig_allocator;
+
+/*!
+ * @brief Set the allocator used by the library.
+ *
+ * This must be called while no other thread uses the library and no object
+ * of the library, such as an @ref editorconfig_handle or an @ref
+ * editorconfig_result, exists, since they may not be freed by the allocator
+ * that allocated them otherwise. Typically, it is called once at startup.
+ *
+ * @param allocator The allocator, which is copied, or NULL to restore the
+ * default allocator, which uses malloc(), realloc() and free().
+ *
+ * @retval 0 Success.
+ *
+ * @retval EDITORCONFIG_PARSE_MEMORY_ERROR A memory error occurs while setting
+ * up PCRE2 to use allocator. The default allocator is restored.
+ */
+EDITORCONFIG_EXPORT
+int editorconfig_set_allocator(const editorconfig_allocator* allocator);
+
+/*!
+ * @brief Make the library allocate all its memory from a block of memory.
+ *
+ * This sets an allocator that only uses the given block, with the same
+ * restrictions as editorconfig_set_allocator(). When the block is exhausted,
+ * functions such as editorconfig_parse() return
+ * EDITORCONFIG_PARSE_MEMORY_ERROR. The memory is given back when the objects
+ * of the library are freed, for instance by editorconfig_handle_destroy().
+ * The allocator is not thread safe, so large EditorConfig files are not
+ * parsed in parallel while it is used.
+ *
+ * When the static library is built with the BUILD_FIXED_MEMORY_STATIC_LIB
+ * CMake option, it never calls malloc(): this, or
+ * editorconfig_set_allocator(), must be called before anything else.
+ *
+ * @param memory The block of memory, which must stay valid until another
+ * allocator is set.
+ *
+ * @param size The size of the block, in bytes.
+ *
+ * @retval 0 Success.
+ *
+ * @retval EDITORCONFIG_PARSE_MEMORY_ERROR The block is too small.
+ */
+EDITORCONFIG_EXPORT
+int editorconfig_set_memory(void* memory, size_t size);
+
+/*!
+ * @brief Write an index of EditorConfig files, to be used with
+ * editorconfig_handle_set_index().
+ *
+ * The index holds the parsed content of each file, with its size and
+ * modification time. The section patterns are not compiled in the index,
+ * which may be shared by other users, but in the cache of
+ * editorconfig_handle_set_persistent_cache(). It is written to a
+ * temporary file which then replaces the index file, so that the processes
+ * using the previous index are not disturbed. This is only supported on POSIX
+ * systems.
+ *
+ * @param path The full path of the index file.
+ *
+ * @param conf_files The full paths of the EditorConfig files to index, which
+ * must be in the directory of the index file or its subdirectories.
+ *
+ * @param count The number of paths in conf_files.
+ *
+ * @return 0 if successful, -1 if the index cannot be written, path is not a
+ * full path, or the index cannot be used on this platform, and
+ * EDITORCONFIG_PARSE_MEMORY_ERROR if an OOM occurs. A positive number n means
+ * that the nth path of conf_files cannot be read or is outside the directory
+ * of the index, in which case nothing is written.
+ */
+EDITORCONFIG_EXPORT
+int editorconfig_write_index(const char* path, const char* const* conf_files,
+        int count);
+
 /*!
  * @brief Get the version number of EditorConfig.
  *
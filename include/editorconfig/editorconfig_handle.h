@@ -40,6 +40,8 @@
 # define EDITORCONFIG_EXPORT
 #endif
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -49,6 +51,104 @@ extern "C" {
  */
 typedef void*   editorconfig_handle;
 
+/*!
+ * @brief The type of the immutable, reference counted parsing results of an
+ * editorconfig_handle.
+ *
+ * All the files parsed with the same handle that have the same properties, in
+ * the same order, share the same result. Two results obtained from the same
+ * handle are thus equal if and only if they are the same pointer.
+ */
+typedef void*   editorconfig_result;
+
+/*!
+ * @brief Value of the integer fields of editorconfig_properties when the
+ * property is not set or is not a positive integer.
+ */
+#define EDITORCONFIG_VALUE_UNSET        0
+
+/*!
+ * @brief Value of editorconfig_properties::indent_size when indent_size is
+ * "tab".
+ */
+#define EDITORCONFIG_VALUE_TAB          (-1)
+
+/*!
+ * @brief Value of editorconfig_properties::max_line_length when
+ * max_line_length is "off".
+ */
+#define EDITORCONFIG_VALUE_OFF          (-2)
+
+/*!
+ * @brief The values of indent_style.
+ */
+typedef enum editorconfig_indent_style
+{
+    EDITORCONFIG_INDENT_STYLE_UNSET = 0,
+    EDITORCONFIG_INDENT_STYLE_TAB,
+    EDITORCONFIG_INDENT_STYLE_SPACE
+} editorconfig_indent_style;
+
+/*!
+ * @brief The values of end_of_line.
+ */
+typedef enum editorconfig_end_of_line
+{
+    EDITORCONFIG_END_OF_LINE_UNSET = 0,
+    EDITORCONFIG_END_OF_LINE_LF,
+    EDITORCONFIG_END_OF_LINE_CRLF,
+    EDITORCONFIG_END_OF_LINE_CR
+} editorconfig_end_of_line;
+
+/*!
+ * @brief The values of charset.
+ */
+typedef enum editorconfig_charset
+{
+    EDITORCONFIG_CHARSET_UNSET = 0,
+    EDITORCONFIG_CHARSET_LATIN1,
+    EDITORCONFIG_CHARSET_UTF_8,
+    EDITORCONFIG_CHARSET_UTF_8_BOM,
+    EDITORCONFIG_CHARSET_UTF_16BE,
+    EDITORCONFIG_CHARSET_UTF_16LE
+} editorconfig_charset;
+
+/*!
+ * @brief The values of the boolean properties.
+ */
+typedef enum editorconfig_bool
+{
+    EDITORCONFIG_BOOL_UNSET = 0,
+    EDITORCONFIG_BOOL_FALSE,
+    EDITORCONFIG_BOOL_TRUE
+} editorconfig_bool;
+
+/*!
+ * @brief The properties defined by the EditorConfig specification, parsed
+ * from the name and value pairs of a result.
+ *
+ * A property that is not set, or whose value is not one of the values defined
+ * by the specification, is unset: its enumeration value is the *_UNSET one and
+ * its integer value is #EDITORCONFIG_VALUE_UNSET. Its raw value is still
+ * available from the name and value pairs.
+ */
+typedef struct editorconfig_properties
+{
+    editorconfig_indent_style   indent_style;
+    /*! A positive integer, #EDITORCONFIG_VALUE_TAB or
+     * #EDITORCONFIG_VALUE_UNSET */
+    int                         indent_size;
+    /*! A positive integer or #EDITORCONFIG_VALUE_UNSET */
+    int                         tab_width;
+    editorconfig_end_of_line    end_of_line;
+    editorconfig_charset        charset;
+    editorconfig_bool           trim_trailing_whitespace;
+    editorconfig_bool           insert_final_newline;
+    /*! A positive integer, #EDITORCONFIG_VALUE_OFF or
+     * #EDITORCONFIG_VALUE_UNSET */
+    int                         max_line_length;
+} editorconfig_properties;
+
 /*!
  * @brief Create and initialize a default editorconfig_handle object.
  *
@@ -71,6 +171,22 @@ editorconfig_handle editorconfig_handle_init(void);
 EDITORCONFIG_EXPORT
 int editorconfig_handle_destroy(editorconfig_handle h);
 
+/*!
+ * @brief Clear the parsing result and the err_file field of an
+ * editorconfig_handle object, so that it can be used for another file.
+ *
+ * The version and conf_file_name fields are left unchanged. The memory used
+ * for the result and the EditorConfig files already parsed are kept, so
+ * reusing a handle for many files is faster than creating one for each file.
+ * editorconfig_parse() does the same before parsing.
+ *
+ * @param h The editorconfig_handle object to be reset.
+ *
+ * @return None.
+ */
+EDITORCONFIG_EXPORT
+void editorconfig_handle_reset(editorconfig_handle h);
+
 /*!
  * @brief Get the err_file field of an editorconfig_handle object
  *
@@ -154,6 +270,139 @@ void editorconfig_handle_set_conf_file_name(editorconfig_handle h,
 EDITORCONFIG_EXPORT
 const char* editorconfig_handle_get_conf_file_name(const editorconfig_handle h);
 
+/*!
+ * @brief Make an editorconfig_handle object remember which EditorConfig files
+ * apply to each directory.
+ *
+ * When it is enabled, the EditorConfig files of a directory are found from
+ * those of its parent directory the first time a file in the directory is
+ * parsed, and the next files in the same directory are parsed without reading
+ * any EditorConfig file. In exchange, changes to the EditorConfig files are
+ * not seen until the cache is disabled, which empties it. This is meant for
+ * processing a whole directory tree at once, as the --walk option of the
+ * editorconfig command does. It is disabled by default.
+ *
+ * @param h The editorconfig_handle object whose cache is set.
+ *
+ * @param enabled Nonzero to enable the cache, zero to disable and empty it.
+ *
+ * @return None.
+ */
+EDITORCONFIG_EXPORT
+void editorconfig_handle_set_directory_cache(editorconfig_handle h,
+        int enabled);
+
+/*!
+ * @brief Make an editorconfig_handle object watch the directories whose
+ * EditorConfig files it reads, so that it can cache them for long.
+ *
+ * When it is enabled, the EditorConfig files that apply to each directory are
+ * cached as with editorconfig_handle_set_directory_cache(), and each directory
+ * is watched for changes to its EditorConfig file. When an EditorConfig file
+ * is created, modified or removed, only the directories it applies to are
+ * removed from the cache, so the next parses see the change without checking
+ * the files on disk each time. The changes are taken into account at the
+ * beginning of each parse, or by editorconfig_handle_process_watch_events().
+ * A directory that cannot be watched, for example because the limit of
+ * watches is reached, is not cached. This is only supported on Linux, with
+ * inotify. It is disabled by default.
+ *
+ * @param h The editorconfig_handle object whose directories are watched.
+ *
+ * @param enabled Nonzero to enable watching, zero to disable it and empty the
+ * cache.
+ *
+ * @return 0 if successful, -1 if directories cannot be watched on this
+ * platform or for lack of resources.
+ */
+EDITORCONFIG_EXPORT
+int editorconfig_handle_set_watch(editorconfig_handle h, int enabled);
+
+/*!
+ * @brief Get the file descriptor that becomes readable when a directory
+ * watched by an editorconfig_handle object changes.
+ *
+ * It may be given to poll() or select() to wait for changes, which are then
+ * processed by editorconfig_handle_process_watch_events().
+ *
+ * @param h The editorconfig_handle object whose file descriptor is obtained.
+ *
+ * @return The file descriptor, or -1 if watching is not enabled.
+ */
+EDITORCONFIG_EXPORT
+int editorconfig_handle_get_watch_fd(const editorconfig_handle h);
+
+/*!
+ * @brief Process the pending changes to the directories watched by an
+ * editorconfig_handle object.
+ *
+ * @param h The editorconfig_handle object whose changes are processed.
+ *
+ * @return The number of changes to the EditorConfig files seen since the last
+ * call, including those processed at the beginning of each parse. If it is
+ * zero, the results of the parses are unchanged.
+ */
+EDITORCONFIG_EXPORT
+int editorconfig_handle_process_watch_events(editorconfig_handle h);
+
+/*!
+ * @brief Make an editorconfig_handle object keep the parsed EditorConfig files
+ * in a cache file shared by all the processes.
+ *
+ * When it is enabled, each EditorConfig file is looked up in the cache file by
+ * its path, and its parsed content is taken from there if its device, inode,
+ * size, modification and change times are those recorded. A process that
+ * parses a single file thus only needs to stat() the EditorConfig files that
+ * might apply to it. The files that are not in the cache, or that changed,
+ * are parsed as usual and added to the cache file when the cache is disabled
+ * or the handle is destroyed. The longer section patterns are kept as compiled
+ * by PCRE2 as well, so that they are not compiled again by the next processes
+ * using the same version of PCRE2. The cache file is mapped in memory and is
+ * replaced as a whole when it is written, so that any number of processes may
+ * use it at the same time. A cache file that is not owned by the user, or that
+ * other users can write, is treated as empty. This is only supported on POSIX
+ * systems. It is disabled by default.
+ *
+ * @param h The editorconfig_handle object whose cache is set.
+ *
+ * @param enabled Nonzero to enable the cache, zero to disable it.
+ *
+ * @param path The path of the cache file, or NULL for editorconfig/cache in
+ * $XDG_CACHE_HOME, or in ~/.cache if it is not set.
+ *
+ * @return 0 if successful, -1 if the cache cannot be used on this platform or
+ * there is no default path, and EDITORCONFIG_PARSE_MEMORY_ERROR if an OOM
+ * occurs.
+ */
+EDITORCONFIG_EXPORT
+int editorconfig_handle_set_persistent_cache(editorconfig_handle h,
+        int enabled, const char* path);
+
+/*!
+ * @brief Make an editorconfig_handle object take the parsed EditorConfig files
+ * from an index written by editorconfig_write_index().
+ *
+ * The index applies to the EditorConfig files in the directory of the index
+ * file and its subdirectories. Such a file is taken from the index if its size
+ * and modification time are those recorded, which the copies of the file that
+ * keep its modification time have too, so that the index can be shipped with
+ * a copy of the directory tree. The other files are parsed as usual. The index
+ * is mapped in memory and is never written. An index written by another
+ * version of the library is ignored. This is only supported on POSIX systems.
+ *
+ * @param h The editorconfig_handle object whose index is set.
+ *
+ * @param path The full path of the index file, or NULL to stop using an
+ * index.
+ *
+ * @return 0 if successful, -1 if an index cannot be used on this platform or
+ * path is not a full path, and EDITORCONFIG_PARSE_MEMORY_ERROR if an OOM
+ * occurs. A missing or invalid index file is not an error, and is treated as
+ * empty.
+ */
+EDITORCONFIG_EXPORT
+int editorconfig_handle_set_index(editorconfig_handle h, const char* path);
+
 /*!
  * @brief Get the nth name and value fields of an editorconfig_handle object.
  *
@@ -185,6 +434,133 @@ void editorconfig_handle_get_name_value(const editorconfig_handle h, int n,
 EDITORCONFIG_EXPORT
 int editorconfig_handle_get_name_value_count(const editorconfig_handle h);
 
+/*!
+ * @brief Get the parsing result of an editorconfig_handle object.
+ *
+ * @param h The editorconfig_handle object whose result needs to be obtained.
+ *
+ * @retval NULL No file has been parsed successfully since the last
+ * editorconfig_handle_reset().
+ *
+ * @retval non-NULL A new reference to the result of the last call to
+ * editorconfig_parse(), which must be released with
+ * editorconfig_result_unref(). The result stays valid after the handle is
+ * reused or destroyed.
+ */
+EDITORCONFIG_EXPORT
+editorconfig_result editorconfig_handle_get_result(const editorconfig_handle h);
+
+/*!
+ * @brief Add a reference to an editorconfig_result.
+ *
+ * @param r The editorconfig_result, which may be NULL.
+ *
+ * @return r.
+ */
+EDITORCONFIG_EXPORT
+editorconfig_result editorconfig_result_ref(editorconfig_result r);
+
+/*!
+ * @brief Release a reference to an editorconfig_result, freeing it when it is
+ * not referenced anymore.
+ *
+ * Results are not thread safe: a result shared between threads must only be
+ * referenced and released by one thread at a time.
+ *
+ * @param r The editorconfig_result, which may be NULL.
+ *
+ * @return None.
+ */
+EDITORCONFIG_EXPORT
+void editorconfig_result_unref(editorconfig_result r);
+
+/*!
+ * @brief Get the nth name and value of an editorconfig_result.
+ *
+ * @param r The editorconfig_result whose name and value need to be obtained.
+ *
+ * @param n The zero-based index of the name and value to be obtained.
+ *
+ * @param name If not null, *name will be set to point to the obtained name.
+ *
+ * @param value If not null, *value will be set to point to the obtained value.
+ *
+ * @return None.
+ */
+EDITORCONFIG_EXPORT
+void editorconfig_result_get_name_value(const editorconfig_result r, int n,
+        const char** name, const char** value);
+
+/*!
+ * @brief Get the count of names and values of an editorconfig_result.
+ *
+ * @param r The editorconfig_result, which may be NULL.
+ *
+ * @return The count of names and values of r, 0 if r is NULL.
+ */
+EDITORCONFIG_EXPORT
+int editorconfig_result_get_name_value_count(const editorconfig_result r);
+
+/*!
+ * @brief Get the parsed values of the properties defined by the EditorConfig
+ * specification of an editorconfig_result.
+ *
+ * They are computed once, when the result is created, so this is cheap enough
+ * to be called whenever a property is needed.
+ *
+ * @param r The editorconfig_result, which may be NULL.
+ *
+ * @return The parsed properties, valid as long as r is referenced. All of
+ * them are unset if r is NULL.
+ */
+EDITORCONFIG_EXPORT
+const editorconfig_properties* editorconfig_result_get_properties(
+        const editorconfig_result r);
+
+/*!
+ * @brief Get the parsed values of the properties defined by the EditorConfig
+ * specification of the file last parsed by editorconfig_parse().
+ *
+ * @param h The editorconfig_handle object whose properties need to be
+ * obtained.
+ *
+ * @return The parsed properties, valid until the next call to
+ * editorconfig_parse() or editorconfig_handle_reset() with h. All of them are
+ * unset if no file has been parsed successfully.
+ */
+EDITORCONFIG_EXPORT
+const editorconfig_properties* editorconfig_handle_get_properties(
+        const editorconfig_handle h);
+
+/*!
+ * @brief Get a fingerprint of the effective configuration of the file last
+ * parsed by editorconfig_parse() with an editorconfig_handle object.
+ *
+ * Both hashes only depend on their inputs, so they are stable across
+ * processes, platforms and handles and can be used as cache keys.
+ *
+ * @param h The editorconfig_handle object whose fingerprint needs to be
+ * obtained.
+ *
+ * @param properties_hash If not null, *properties_hash will be set to the
+ * 64-bit FNV-1a hash of the names and values of the result, each followed by a
+ * null character, in order. Files with the same properties have the same
+ * properties_hash.
+ *
+ * @param sources_hash If not null, *sources_hash will be set to a 64-bit hash
+ * of the paths and contents of the EditorConfig files the result was resolved
+ * from: all the existing ones from the last one with root = true down to the
+ * directory of the file.
+ *
+ * @retval 0 Success.
+ *
+ * @retval -1 No file has been parsed successfully since the last
+ * editorconfig_handle_reset(). Neither hash is set.
+ */
+EDITORCONFIG_EXPORT
+int editorconfig_handle_get_fingerprint(const editorconfig_handle h,
+        uint64_t* properties_hash, uint64_t* sources_hash);
+
 #ifdef __cplusplus
 }
 #endif
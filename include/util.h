@@ -31,6 +31,11 @@
 #ifndef UTIL_H__
 #define UTIL_H__
 
+#include <ctype.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
 /*
  * An version of atoi that handles strings corresponding to integers that are
  * out of range.
@@ -40,4 +45,37 @@ static inline int ec_atoi(const char* str)
     return (int) strtol(str, (char **) NULL, 10);
 }
 
+/*
+ * Lowercase str in place and return it, as the names of the properties are.
+ */
+static inline char* ec_lowercase(char* str)
+{
+    char*       p;
+
+    for (p = str; *p; ++p)
+        *p = (char) tolower((unsigned char) *p);
+
+    return str;
+}
+
+/* the hash of no data, to start hashing with ec_fnv_hash() */
+#define EC_FNV_HASH_INIT    0xcbf29ce484222325ULL
+
+/*
+ * Continue a 64-bit FNV-1a hash with the size bytes at data and return it.
+ */
+static inline uint64_t ec_fnv_hash(uint64_t hash, const void* data,
+        size_t size)
+{
+    const unsigned char*    p = (const unsigned char*) data;
+    size_t                  i;
+
+    for (i = 0; i < size; ++i) {
+        hash ^= p[i];
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
 #endif /* !UTIL_H__ */
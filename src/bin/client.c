@@ -0,0 +1,343 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef HAVE_SYS_UN_H
+# include <errno.h>
+# include <sys/socket.h>
+# include <sys/stat.h>
+# include <sys/time.h>
+# include <sys/types.h>
+# include <sys/un.h>
+# include <unistd.h>
+#endif
+
+#include "client.h"
+#include "server.h"
+
+#ifdef HAVE_SYS_UN_H
+
+#ifndef MSG_NOSIGNAL
+# define MSG_NOSIGNAL       0
+#endif
+
+/* The largest response payload accepted */
+#define MAX_RESPONSE_SIZE   (64 * 1024 * 1024)
+
+/* How long to wait for the daemon before parsing in process */
+#define TIMEOUT_SECONDS     10
+
+struct client
+{
+    int                 fd;
+    /* the bytes received of the current response */
+    char*               buffer;
+    size_t              size;
+    size_t              capacity;
+};
+
+/*
+ * Checks that dir is a directory that belongs to the user and that nobody
+ * else can enter, creating it if is_creating is set. Returns 0 if it is, -1
+ * otherwise.
+ */
+static int check_private_dir(const char* dir, int is_creating)
+{
+    struct stat         st;
+
+    if (is_creating && mkdir(dir, 0700) != 0 && errno != EEXIST)
+        return -1;
+
+    /* another user may have made it first, or replaced it with a link */
+    if (lstat(dir, &st) != 0 || !S_ISDIR(st.st_mode) ||
+            st.st_uid != getuid() || (st.st_mode & 077) != 0)
+        return -1;
+
+    return 0;
+}
+
+/*
+ * See header file
+ */
+int client_get_socket_path(char* path, size_t size, int is_creating)
+{
+    const char*         env;
+    int                 len;
+
+    if ((env = getenv("EDITORCONFIG_SOCKET")) != NULL && *env)
+        len = snprintf(path, size, "%s", env);
+    else if ((env = getenv("XDG_RUNTIME_DIR")) != NULL && *env)
+        len = snprintf(path, size, "%s/editorconfig.sock", env);
+    else {
+        /* /tmp is shared with the other users, who must not be able to take
+         * the name of the socket */
+        len = snprintf(path, size, "/tmp/editorconfig-%lu/editorconfig.sock",
+                (unsigned long) getuid());
+        if (len < 0 || (size_t) len >= size)
+            return -1;
+
+        *strrchr(path, '/') = '\0';
+        if (check_private_dir(path, is_creating) != 0)
+            return -2;
+        path[strlen(path)] = '/';
+    }
+
+    return len < 0 || (size_t) len >= size ? -1 : 0;
+}
+
+/*
+ * See header file
+ */
+int client_check_peer(int fd)
+{
+#if defined(HAVE_GETPEEREID)
+    uid_t               uid;
+    gid_t               gid;
+
+    if (getpeereid(fd, &uid, &gid) != 0)
+        return -1;
+    return uid == getuid() ? 0 : -1;
+#elif defined(SO_PEERCRED)
+    struct ucred        cred;
+    socklen_t           len = sizeof(cred);
+
+    if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0 ||
+            len != sizeof(cred))
+        return -1;
+    return cred.uid == getuid() ? 0 : -1;
+#else
+    /* the user cannot be told, so the peer cannot be trusted */
+    (void) fd;
+    return -1;
+#endif
+}
+
+/*
+ * See header file
+ */
+client* client_connect(const char* socket_path)
+{
+    struct sockaddr_un  addr;
+    struct timeval      timeout;
+    client*             c;
+    int                 fd;
+
+    if (strlen(socket_path) >= sizeof(addr.sun_path))
+        return NULL;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, socket_path);
+
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return NULL;
+    /* anybody can listen on a path that the user can write to, so only a
+     * daemon of the same user is trusted */
+    if (connect(fd, (struct sockaddr*) &addr, sizeof(addr)) != 0 ||
+            client_check_peer(fd) != 0) {
+        close(fd);
+        return NULL;
+    }
+
+    /* a daemon that hangs must not hang its clients */
+    timeout.tv_sec = TIMEOUT_SECONDS;
+    timeout.tv_usec = 0;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+#ifdef SO_NOSIGPIPE
+    {
+        int             on = 1;
+
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+    }
+#endif
+
+    c = (client*) calloc(1, sizeof(client));
+    if (c == NULL) {
+        close(fd);
+        return NULL;
+    }
+    c->fd = fd;
+
+    return c;
+}
+
+static int send_all(int fd, const char* data, size_t size)
+{
+    while (size > 0) {
+        ssize_t         n = send(fd, data, size, MSG_NOSIGNAL);
+
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        data += n;
+        size -= (size_t) n;
+    }
+
+    return 0;
+}
+
+/*
+ * Receives more bytes of the response, making room for at least min_capacity
+ * bytes in the buffer. Returns -1 if the connection is closed or fails.
+ */
+static int receive(client* c, size_t min_capacity)
+{
+    ssize_t             n;
+
+    if (min_capacity <= c->size)
+        min_capacity = c->size + 1;
+    if (min_capacity > c->capacity) {
+        size_t          new_capacity = c->capacity ? c->capacity : 4096;
+        char*           new_buffer;
+
+        while (new_capacity < min_capacity)
+            new_capacity *= 2;
+        new_buffer = (char*) realloc(c->buffer, new_capacity);
+        if (new_buffer == NULL)
+            return -1;
+        c->buffer = new_buffer;
+        c->capacity = new_capacity;
+    }
+
+    do
+        n = recv(c->fd, c->buffer + c->size, c->capacity - c->size, 0);
+    while (n < 0 && errno == EINTR);
+    if (n <= 0)
+        return -1;
+    c->size += (size_t) n;
+
+    return 0;
+}
+
+/*
+ * See header file
+ */
+int client_request(client* c, const char* payload, size_t payload_size,
+        const char** response, size_t* response_size)
+{
+    char                header[32];
+    size_t              header_size;
+    size_t              size;
+    int                 ret;
+
+    sprintf(header, "%lu\n", (unsigned long) payload_size);
+    if (send_all(c->fd, header, strlen(header)) != 0 ||
+            send_all(c->fd, payload, payload_size) != 0)
+        return -1;
+
+    /* one request is sent at a time, so the bytes received are all part of
+     * its response */
+    c->size = 0;
+    while ((ret = parse_frame_header(c->buffer, c->size, MAX_RESPONSE_SIZE,
+                    &header_size, &size)) == 0)
+        if (receive(c, 0) != 0)
+            return -1;
+    if (ret < 0)
+        return -1;
+    while (c->size < header_size + size)
+        if (receive(c, header_size + size) != 0)
+            return -1;
+
+    *response = c->buffer + header_size;
+    *response_size = size;
+
+    return 0;
+}
+
+/*
+ * See header file
+ */
+void client_close(client* c)
+{
+    if (c == NULL)
+        return;
+
+    close(c->fd);
+    free(c->buffer);
+    free(c);
+}
+
+#else /* HAVE_SYS_UN_H */
+
+/*
+ * See header file
+ */
+int client_get_socket_path(char* path, size_t size, int is_creating)
+{
+    (void) path;
+    (void) size;
+    (void) is_creating;
+    return -1;
+}
+
+/*
+ * See header file
+ */
+int client_check_peer(int fd)
+{
+    (void) fd;
+    return -1;
+}
+
+/*
+ * See header file
+ */
+client* client_connect(const char* socket_path)
+{
+    (void) socket_path;
+    return NULL;
+}
+
+/*
+ * See header file
+ */
+int client_request(client* c, const char* payload, size_t payload_size,
+        const char** response, size_t* response_size)
+{
+    (void) c;
+    (void) payload;
+    (void) payload_size;
+    (void) response;
+    (void) response_size;
+    return -1;
+}
+
+/*
+ * See header file
+ */
+void client_close(client* c)
+{
+    (void) c;
+}
+
+#endif /* HAVE_SYS_UN_H */
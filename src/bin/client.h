@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CLIENT_H__
+#define CLIENT_H__
+
+#include <stddef.h>
+
+/*
+ * The client of editorconfig-daemon, which sends it the requests described in
+ * server.c over a Unix domain socket.
+ */
+typedef struct client client;
+
+/*
+ * Stores in path, of size bytes, the path of the socket of the daemon, which
+ * is $EDITORCONFIG_SOCKET, $XDG_RUNTIME_DIR/editorconfig.sock or
+ * /tmp/editorconfig-UID/editorconfig.sock. The directory in /tmp is created if
+ * is_creating is set, and must belong to the user and be closed to the other
+ * users. Returns 0 on success, -1 if the path is too long, -2 if the directory
+ * in /tmp is missing or cannot be trusted.
+ */
+int client_get_socket_path(char* path, size_t size, int is_creating);
+
+/*
+ * Returns 0 if the process at the other end of the Unix domain socket fd runs
+ * as the same user as this one, -1 if it does not or if it cannot be told.
+ */
+int client_check_peer(int fd);
+
+/*
+ * Connects to the daemon listening on socket_path. Returns NULL if it is not
+ * running, or if it cannot be reached on this platform.
+ */
+client* client_connect(const char* socket_path);
+
+/*
+ * Sends the request payload of payload_size bytes and waits for the response,
+ * whose payload is stored in *response and *response_size and is valid until
+ * the next call. Returns 0 on success, -1 if the daemon could not be reached
+ * or did not answer in time, in which case the client can only be closed.
+ */
+int client_request(client* c, const char* payload, size_t payload_size,
+        const char** response, size_t* response_size);
+
+void client_close(client* c);
+
+#endif /* !CLIENT_H__ */
@@ -0,0 +1,892 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * editorconfig-daemon answers the requests of the editorconfig command and of
+ * other tools over a Unix domain socket, so that all of them share the same
+ * parsed EditorConfig files. The requests and the responses are the frames of
+ * the --server option described in server.c, and a connection can send any
+ * number of requests, one after the other.
+ *
+ * The main thread waits for the sockets with epoll and reads and writes them
+ * without blocking. Each complete request is given to a worker thread, which
+ * answers it with its own server. A request goes to the worker chosen by the
+ * directory of its file, so that the files of a directory are always parsed
+ * by the same worker, which has its EditorConfig files in its cache, and the
+ * workers need no lock around their caches.
+ */
+
+#include "config.h"
+#include <ctype.h>
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <editorconfig/editorconfig.h>
+
+#include "client.h"
+#include "server.h"
+#include "util.h"
+
+/* The most worker threads */
+#define MAX_WORKERS         64
+
+/* The most bytes kept in the buffers of a connection before it is no longer
+ * read until its client reads the responses */
+#define MAX_BUFFERED_SIZE   (SERVER_MAX_REQUEST_SIZE + 32)
+
+#define READ_SIZE           (64 * 1024)
+
+/* The most events handled by a call to epoll_wait() */
+#define MAX_EVENTS          64
+
+/* The most connections open at once. The daemon stops accepting beyond it,
+ * and when it runs out of file descriptors, until a connection is closed */
+#define MAX_CONNECTIONS     1024
+
+/* The milliseconds after which the daemon tries to accept again when it has
+ * no connection whose closing would resume it */
+#define ACCEPT_RETRY_DELAY  1000
+
+typedef struct connection
+{
+    /* the list of all the connections */
+    struct connection*  prev;
+    struct connection*  next;
+    /* the next connection in a queue of requests or responses */
+    struct connection*  next_in_queue;
+
+    int                 fd;
+    /* the events the connection is waiting for */
+    uint32_t            events;
+
+    /* the bytes received and not given to a worker yet */
+    char*               input;
+    size_t              input_size;
+    size_t              input_capacity;
+
+    /* the bytes not sent yet, from output_pos */
+    char*               output;
+    size_t              output_pos;
+    size_t              output_size;
+    size_t              output_capacity;
+
+    /* the payload of the request being answered by a worker, and the frame of
+     * its response, which only the worker uses while is_busy is set */
+    char*               request;
+    size_t              request_size;
+    size_t              request_capacity;
+    char*               response;
+    size_t              response_size;
+    size_t              response_capacity;
+
+    _Bool               is_busy;
+    /* set by the worker when there is no memory for the response */
+    _Bool               is_failed;
+    /* set when the client sent all its requests */
+    _Bool               is_eof;
+    /* set when the connection failed, which is closed once it is not busy */
+    _Bool               is_closed;
+} connection;
+
+/*
+ * A queue of connections, protected by its mutex.
+ */
+typedef struct
+{
+    pthread_mutex_t     mutex;
+    pthread_cond_t      cond;
+    connection*         head;
+    connection*         tail;
+    _Bool               is_stopped;
+} connection_queue;
+
+typedef struct
+{
+    pthread_t           thread;
+    connection_queue    requests;
+    server*             server;
+    /* the daemon, for its queue of responses */
+    struct daemon_state* daemon;
+} worker;
+
+typedef struct daemon_state
+{
+    int                 epoll_fd;
+    int                 listen_fd;
+    /* signaled by the workers when they add to responses */
+    int                 wake_fd;
+    int                 signal_fd;
+
+    connection*         connections;
+    int                 connection_count;
+    /* whether epoll waits for the connections on listen_fd */
+    int                 is_accepting;
+
+    worker*             workers;
+    int                 worker_count;
+    connection_queue    responses;
+} daemon_state;
+
+/* The epoll data of the file descriptors that are not connections */
+static char             listen_token;
+static char             wake_token;
+static char             signal_token;
+
+static void version(FILE* stream)
+{
+    int     major;
+    int     minor;
+    int     patch;
+
+    editorconfig_get_version(&major, &minor, &patch);
+
+    fprintf(stream, "EditorConfig Daemon Version %d.%d.%d%s\n",
+            major, minor, patch, editorconfig_get_version_suffix());
+}
+
+static void usage(FILE* stream, const char* command)
+{
+    fprintf(stream, "Usage: %s [OPTIONS]\n", command);
+    fprintf(stream, "Answer the requests of \"editorconfig --daemon\" and of other tools on a Unix\n");
+    fprintf(stream, "domain socket until SIGINT or SIGTERM is received.\n");
+
+    fprintf(stream, "\n");
+    fprintf(stream, "--socket PATH      Listen on PATH instead of $EDITORCONFIG_SOCKET,\n");
+    fprintf(stream, "                   $XDG_RUNTIME_DIR/editorconfig.sock or\n");
+    fprintf(stream, "                   /tmp/editorconfig-UID/editorconfig.sock.\n");
+    fprintf(stream, "--workers N        Answer the requests with N threads instead of one per\n");
+    fprintf(stream, "                   processor.\n");
+    fprintf(stream, "-h OR --help       Print this help message.\n");
+    fprintf(stream, "-v OR --version    Display version information.\n");
+}
+
+/*
+ * Makes buffer hold at least size bytes. Returns 0 on success, -1 if the
+ * memory cannot be allocated.
+ */
+static int reserve(char** buffer, size_t* capacity, size_t size)
+{
+    char*               new_buffer;
+    size_t              new_capacity;
+
+    if (size <= *capacity)
+        return 0;
+
+    new_capacity = *capacity ? *capacity : 4096;
+    while (new_capacity < size)
+        new_capacity *= 2;
+    new_buffer = (char*) realloc(*buffer, new_capacity);
+    if (new_buffer == NULL)
+        return -1;
+    *buffer = new_buffer;
+    *capacity = new_capacity;
+
+    return 0;
+}
+
+static int queue_init(connection_queue* q)
+{
+    memset(q, 0, sizeof(connection_queue));
+    if (pthread_mutex_init(&q->mutex, NULL) != 0)
+        return -1;
+    if (pthread_cond_init(&q->cond, NULL) != 0) {
+        pthread_mutex_destroy(&q->mutex);
+        return -1;
+    }
+
+    return 0;
+}
+
+static void queue_destroy(connection_queue* q)
+{
+    pthread_cond_destroy(&q->cond);
+    pthread_mutex_destroy(&q->mutex);
+}
+
+/*
+ * Adds c to the queue. Returns whether the queue was empty.
+ */
+static _Bool queue_push(connection_queue* q, connection* c)
+{
+    _Bool               was_empty;
+
+    pthread_mutex_lock(&q->mutex);
+    c->next_in_queue = NULL;
+    was_empty = q->head == NULL;
+    if (was_empty)
+        q->head = c;
+    else
+        q->tail->next_in_queue = c;
+    q->tail = c;
+    pthread_cond_signal(&q->cond);
+    pthread_mutex_unlock(&q->mutex);
+
+    return was_empty;
+}
+
+/*
+ * Takes all the connections of the queue, waiting for one if wait is set.
+ * Returns NULL if the queue is empty, or if it is stopped while waiting.
+ */
+static connection* queue_take(connection_queue* q, _Bool wait)
+{
+    connection*         head;
+
+    pthread_mutex_lock(&q->mutex);
+    while (wait && q->head == NULL && !q->is_stopped)
+        pthread_cond_wait(&q->cond, &q->mutex);
+    head = q->head;
+    q->head = q->tail = NULL;
+    pthread_mutex_unlock(&q->mutex);
+
+    return head;
+}
+
+static void queue_stop(connection_queue* q)
+{
+    pthread_mutex_lock(&q->mutex);
+    q->is_stopped = 1;
+    pthread_cond_broadcast(&q->cond);
+    pthread_mutex_unlock(&q->mutex);
+}
+
+/*
+ * Answers the request of a connection and stores the frame of the response.
+ * Sets is_failed if there is no memory for the response.
+ */
+static void answer(worker* w, connection* c)
+{
+    const char*         response;
+    size_t              response_size;
+    char                header[32];
+    char                error[128];
+    size_t              header_size;
+
+    if (server_respond(w->server, c->request, c->request_size, &response,
+                &response_size) != 0) {
+        sprintf(error, "; %s\n",
+                editorconfig_get_error_msg(EDITORCONFIG_PARSE_MEMORY_ERROR));
+        response = error;
+        response_size = strlen(error);
+    }
+
+    sprintf(header, "%lu\n", (unsigned long) response_size);
+    header_size = strlen(header);
+    if (reserve(&c->response, &c->response_capacity,
+                header_size + response_size) != 0) {
+        c->is_failed = 1;
+        return;
+    }
+    memcpy(c->response, header, header_size);
+    memcpy(c->response + header_size, response, response_size);
+    c->response_size = header_size + response_size;
+}
+
+static void* worker_main(void* arg)
+{
+    worker*             w = (worker*) arg;
+    connection*         c;
+
+    while ((c = queue_take(&w->requests, 1)) != NULL) {
+        while (c != NULL) {
+            connection*     next = c->next_in_queue;
+            uint64_t        one = 1;
+
+            answer(w, c);
+            if (queue_push(&w->daemon->responses, c) &&
+                    write(w->daemon->wake_fd, &one, sizeof(one)) < 0 &&
+                    errno != EAGAIN)
+                perror("Failed to wake up the main thread");
+            c = next;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Returns the worker for the request payload of size bytes, chosen by the
+ * directory of its file.
+ */
+static worker* choose_worker(daemon_state* d, const char* payload, size_t size)
+{
+    const char*         end = payload + size;
+    const char*         line = payload;
+    uint64_t            hash = EC_FNV_HASH_INIT;
+
+    while (line < end) {
+        const char*     eol = (const char*) memchr(line, '\n',
+                (size_t) (end - line));
+
+        if (eol == NULL)
+            eol = end;
+        if (eol - line > 5 && !memcmp(line, "file=", 5)) {
+            const char* dir_end = eol;
+
+            while (dir_end > line + 5 && dir_end[-1] != '/')
+                -- dir_end;
+            hash = ec_fnv_hash(hash, line + 5,
+                    (size_t) (dir_end - (line + 5)));
+            break;
+        }
+        line = eol + 1;
+    }
+
+    return &d->workers[hash % (uint64_t) d->worker_count];
+}
+
+static void set_events(daemon_state* d, connection* c, uint32_t events)
+{
+    struct epoll_event  ev;
+
+    if (events == c->events)
+        return;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events = events;
+    ev.data.ptr = c;
+    if (epoll_ctl(d->epoll_fd, EPOLL_CTL_MOD, c->fd, &ev) != 0)
+        c->is_closed = 1;
+    else
+        c->events = events;
+}
+
+/*
+ * Makes epoll wait or stop waiting for the connections on the listening
+ * socket. The connections are then left in its backlog.
+ */
+static void set_accepting(daemon_state* d, int is_accepting)
+{
+    struct epoll_event  ev;
+
+    if (d->is_accepting == is_accepting || d->listen_fd < 0)
+        return;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events = is_accepting ? EPOLLIN : 0;
+    ev.data.ptr = &listen_token;
+    if (epoll_ctl(d->epoll_fd, EPOLL_CTL_MOD, d->listen_fd, &ev) == 0)
+        d->is_accepting = is_accepting;
+}
+
+static void destroy_connection(daemon_state* d, connection* c)
+{
+    if (c->prev != NULL)
+        c->prev->next = c->next;
+    else
+        d->connections = c->next;
+    if (c->next != NULL)
+        c->next->prev = c->prev;
+
+    close(c->fd);
+    free(c->input);
+    free(c->output);
+    free(c->request);
+    free(c->response);
+    free(c);
+
+    -- d->connection_count;
+    set_accepting(d, 1);
+}
+
+/*
+ * Gives the next complete request of the connection to a worker, updates the
+ * events the connection waits for, and closes it if it is done. Closing is
+ * delayed while a worker answers it.
+ */
+static void update_connection(daemon_state* d, connection* c)
+{
+    uint32_t            events = 0;
+    size_t              pending = c->output_size - c->output_pos;
+
+    if (!c->is_closed && !c->is_busy && pending < MAX_BUFFERED_SIZE) {
+        size_t          header_size;
+        size_t          size;
+        int             ret = parse_frame_header(c->input, c->input_size,
+                SERVER_MAX_REQUEST_SIZE, &header_size, &size);
+
+        if (ret < 0)
+            c->is_closed = 1;
+        else if (ret > 0 && c->input_size >= header_size + size) {
+            if (reserve(&c->request, &c->request_capacity, size + 1) != 0)
+                c->is_closed = 1;
+            else {
+                memcpy(c->request, c->input + header_size, size);
+                c->request_size = size;
+                c->input_size -= header_size + size;
+                memmove(c->input, c->input + header_size + size,
+                        c->input_size);
+                c->is_busy = 1;
+                queue_push(&choose_worker(d, c->request, size)->requests, c);
+            }
+        }
+    }
+
+    /* what is left of the input after the end of the connection is a
+     * truncated request */
+    if (c->is_closed || (c->is_eof && !c->is_busy && pending == 0)) {
+        if (!c->is_busy)
+            destroy_connection(d, c);
+        else if (c->events != 0) {
+            /* stop the events, including EPOLLHUP, until the worker is
+             * done */
+            epoll_ctl(d->epoll_fd, EPOLL_CTL_DEL, c->fd, NULL);
+            c->events = 0;
+        }
+        return;
+    }
+
+    if (!c->is_eof && c->input_size < MAX_BUFFERED_SIZE)
+        events |= EPOLLIN;
+    if (pending > 0)
+        events |= EPOLLOUT;
+    set_events(d, c, events);
+}
+
+static void read_connection(connection* c)
+{
+    for (;;) {
+        ssize_t         n;
+
+        if (c->input_size >= MAX_BUFFERED_SIZE)
+            return;
+        if (reserve(&c->input, &c->input_capacity,
+                    c->input_size + READ_SIZE) != 0) {
+            c->is_closed = 1;
+            return;
+        }
+
+        n = recv(c->fd, c->input + c->input_size,
+                c->input_capacity - c->input_size, 0);
+        if (n > 0)
+            c->input_size += (size_t) n;
+        else if (n == 0) {
+            c->is_eof = 1;
+            return;
+        } else if (errno != EINTR) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                c->is_closed = 1;
+            return;
+        }
+    }
+}
+
+static void write_connection(connection* c)
+{
+    while (c->output_pos < c->output_size) {
+        ssize_t         n = send(c->fd, c->output + c->output_pos,
+                c->output_size - c->output_pos, MSG_NOSIGNAL);
+
+        if (n >= 0)
+            c->output_pos += (size_t) n;
+        else if (errno != EINTR) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                c->is_closed = 1;
+            return;
+        }
+    }
+    c->output_pos = c->output_size = 0;
+}
+
+static void accept_connections(daemon_state* d)
+{
+    for (;;) {
+        struct epoll_event  ev;
+        connection*         c;
+        int                 fd;
+
+        if (d->connection_count >= MAX_CONNECTIONS) {
+            set_accepting(d, 0);
+            return;
+        }
+
+        fd = accept4(d->listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+            /* the pending connection would wake epoll again at once */
+            if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS ||
+                    errno == ENOMEM)
+                set_accepting(d, 0);
+            else if (errno != EAGAIN && errno != EWOULDBLOCK)
+                perror("Failed to accept a connection");
+            return;
+        }
+
+        /* the socket may be reachable by the other users */
+        if (client_check_peer(fd) != 0) {
+            close(fd);
+            continue;
+        }
+
+        c = (connection*) calloc(1, sizeof(connection));
+        if (c == NULL) {
+            close(fd);
+            continue;
+        }
+        c->fd = fd;
+        c->events = EPOLLIN;
+
+        memset(&ev, 0, sizeof(ev));
+        ev.events = c->events;
+        ev.data.ptr = c;
+        if (epoll_ctl(d->epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            close(fd);
+            free(c);
+            continue;
+        }
+
+        c->next = d->connections;
+        if (c->next != NULL)
+            c->next->prev = c;
+        d->connections = c;
+        ++ d->connection_count;
+    }
+}
+
+/*
+ * Sends the responses the workers are done with, and goes on with the next
+ * requests of their connections.
+ */
+static void send_responses(daemon_state* d)
+{
+    uint64_t            count;
+    connection*         c;
+
+    if (read(d->wake_fd, &count, sizeof(count)) < 0 && errno != EAGAIN)
+        perror("Failed to read the wake up event");
+
+    c = queue_take(&d->responses, 0);
+    while (c != NULL) {
+        connection*     next = c->next_in_queue;
+
+        c->is_busy = 0;
+        if (c->is_failed)
+            c->is_closed = 1;
+        else if (!c->is_closed) {
+            if (reserve(&c->output, &c->output_capacity,
+                        c->output_size + c->response_size) != 0)
+                c->is_closed = 1;
+            else {
+                memcpy(c->output + c->output_size, c->response,
+                        c->response_size);
+                c->output_size += c->response_size;
+                write_connection(c);
+            }
+        }
+        update_connection(d, c);
+        c = next;
+    }
+}
+
+/*
+ * Binds a socket listening on path, replacing a socket left by a daemon that
+ * is no longer running. Returns the socket, or -1 on error.
+ */
+static int listen_socket(const char* path)
+{
+    struct sockaddr_un  addr;
+    mode_t              old_mask;
+    int                 fd;
+    int                 ret;
+
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "The socket path is too long: \"%s\"\n", path);
+        return -1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        perror("Failed to create the socket");
+        return -1;
+    }
+
+    /* only the user can connect */
+    old_mask = umask(077);
+    ret = bind(fd, (struct sockaddr*) &addr, sizeof(addr));
+    if (ret != 0 && errno == EADDRINUSE) {
+        client*         other = client_connect(path);
+
+        if (other != NULL) {
+            client_close(other);
+            fprintf(stderr, "A daemon is already listening on \"%s\"\n", path);
+            umask(old_mask);
+            close(fd);
+            return -1;
+        }
+        unlink(path);
+        ret = bind(fd, (struct sockaddr*) &addr, sizeof(addr));
+    }
+    umask(old_mask);
+
+    if (ret != 0 || listen(fd, SOMAXCONN) != 0) {
+        fprintf(stderr, "Failed to listen on \"%s\": %s\n", path,
+                strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+static int add_fd(daemon_state* d, int fd, void* token)
+{
+    struct epoll_event  ev;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.ptr = token;
+
+    return epoll_ctl(d->epoll_fd, EPOLL_CTL_ADD, fd, &ev);
+}
+
+/*
+ * Starts the workers. Returns 0 on success, -1 on error, in which case the
+ * workers started are left to stop_workers().
+ */
+static int start_workers(daemon_state* d, int worker_count)
+{
+    d->workers = (worker*) calloc((size_t) worker_count, sizeof(worker));
+    if (d->workers == NULL)
+        return -1;
+
+    for (; d->worker_count < worker_count; ++ d->worker_count) {
+        worker*         w = &d->workers[d->worker_count];
+
+        w->daemon = d;
+        w->server = server_init(NULL, -1, -1, -1);
+        if (w->server == NULL)
+            return -1;
+        if (queue_init(&w->requests) != 0) {
+            server_destroy(w->server);
+            return -1;
+        }
+        if (pthread_create(&w->thread, NULL, worker_main, w) != 0) {
+            queue_destroy(&w->requests);
+            server_destroy(w->server);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static void stop_workers(daemon_state* d)
+{
+    int                 i;
+
+    for (i = 0; i < d->worker_count; ++i)
+        queue_stop(&d->workers[i].requests);
+    for (i = 0; i < d->worker_count; ++i) {
+        worker*         w = &d->workers[i];
+
+        pthread_join(w->thread, NULL);
+        queue_destroy(&w->requests);
+        server_destroy(w->server);
+    }
+    free(d->workers);
+}
+
+/*
+ * Answers the requests until SIGINT or SIGTERM is received.
+ */
+static void run(daemon_state* d)
+{
+    struct epoll_event  events[MAX_EVENTS];
+
+    for (;;) {
+        int             count = epoll_wait(d->epoll_fd, events, MAX_EVENTS,
+                d->is_accepting ? -1 : ACCEPT_RETRY_DELAY);
+        int             i;
+
+        if (count < 0) {
+            if (errno == EINTR)
+                continue;
+            perror("Failed to wait for the sockets");
+            return;
+        }
+        if (count == 0 && d->connection_count < MAX_CONNECTIONS)
+            set_accepting(d, 1);
+
+        for (i = 0; i < count; ++i) {
+            void*       token = events[i].data.ptr;
+            connection* c;
+
+            if (token == &listen_token) {
+                accept_connections(d);
+                continue;
+            }
+            if (token == &wake_token) {
+                send_responses(d);
+                continue;
+            }
+            if (token == &signal_token)
+                return;
+
+            /* a client that closed its connection cannot get the responses */
+            c = (connection*) token;
+            if (events[i].events & (EPOLLHUP | EPOLLERR))
+                c->is_closed = 1;
+            else {
+                if (events[i].events & EPOLLIN)
+                    read_connection(c);
+                if (events[i].events & EPOLLOUT)
+                    write_connection(c);
+            }
+            update_connection(d, c);
+        }
+    }
+}
+
+int main(int argc, const char* argv[])
+{
+    daemon_state        d;
+    char                default_socket_path[256];
+    const char*         socket_path = NULL;
+    int                 worker_count = 0;
+    sigset_t            signals;
+    int                 exit_status = 1;
+    int                 i;
+
+    for (i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--version") == 0 ||
+                strcmp(argv[i], "-v") == 0) {
+            version(stdout);
+            exit(0);
+        } else if (strcmp(argv[i], "--help") == 0 ||
+                strcmp(argv[i], "-h") == 0) {
+            version(stdout);
+            usage(stdout, argv[0]);
+            exit(0);
+        } else if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc)
+            socket_path = argv[++i];
+        else if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            worker_count = ec_atoi(argv[++i]);
+            if (worker_count <= 0 || worker_count > MAX_WORKERS) {
+                fprintf(stderr, "The number of workers must be between 1 and %d.\n",
+                        MAX_WORKERS);
+                exit(1);
+            }
+        } else {
+            usage(stderr, argv[0]);
+            exit(1);
+        }
+    }
+
+    if (socket_path == NULL) {
+        int             ret = client_get_socket_path(default_socket_path,
+                sizeof(default_socket_path), 1);
+
+        if (ret == -1) {
+            fprintf(stderr, "The socket path is too long.\n");
+            exit(1);
+        } else if (ret != 0) {
+            fprintf(stderr, "\"%s\" must be a directory of the user that the other users cannot enter.\n",
+                    default_socket_path);
+            exit(1);
+        }
+        socket_path = default_socket_path;
+    }
+
+    if (worker_count == 0) {
+        long            cpu_count = sysconf(_SC_NPROCESSORS_ONLN);
+
+        worker_count = cpu_count < 1 ? 1 :
+            cpu_count > MAX_WORKERS ? MAX_WORKERS : (int) cpu_count;
+    }
+
+    /* the signals are received by the main thread through signal_fd, and the
+     * workers, which inherit the mask, never see them */
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigaddset(&signals, SIGHUP);
+    pthread_sigmask(SIG_BLOCK, &signals, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    memset(&d, 0, sizeof(d));
+    d.listen_fd = d.wake_fd = d.signal_fd = -1;
+    d.epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (d.epoll_fd < 0) {
+        perror("Failed to create the epoll instance");
+        exit(1);
+    }
+    if (queue_init(&d.responses) != 0) {
+        perror("Failed to create a mutex");
+        exit(1);
+    }
+
+    d.wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    d.signal_fd = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (d.wake_fd < 0 || d.signal_fd < 0 ||
+            add_fd(&d, d.wake_fd, &wake_token) != 0 ||
+            add_fd(&d, d.signal_fd, &signal_token) != 0)
+        perror("Failed to set up the events");
+    else if (start_workers(&d, worker_count) != 0)
+        perror("Failed to start the workers");
+    else if ((d.listen_fd = listen_socket(socket_path)) >= 0) {
+        if (add_fd(&d, d.listen_fd, &listen_token) != 0)
+            perror("Failed to set up the events");
+        else {
+            d.is_accepting = 1;
+            run(&d);
+            exit_status = 0;
+        }
+        unlink(socket_path);
+        close(d.listen_fd);
+        d.listen_fd = -1;
+    }
+
+    stop_workers(&d);
+
+    /* the workers are done with the connections */
+    while (d.connections != NULL)
+        destroy_connection(&d, d.connections);
+
+    queue_destroy(&d.responses);
+    if (d.wake_fd >= 0)
+        close(d.wake_fd);
+    if (d.signal_fd >= 0)
+        close(d.signal_fd);
+    close(d.epoll_fd);
+
+    exit(exit_status);
+}
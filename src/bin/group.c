@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "group.h"
+#include "util.h"
+
+/* Version of the format of --group-binary */
+#define GROUP_BINARY_VERSION    1
+
+static void put_u32(unsigned char* p, uint32_t n)
+{
+    p[0] = (unsigned char) n;
+    p[1] = (unsigned char) (n >> 8);
+    p[2] = (unsigned char) (n >> 16);
+    p[3] = (unsigned char) (n >> 24);
+}
+
+/*
+ * Adds the null-terminated string of len bytes at s to the strings of g, and
+ * returns its offset.
+ */
+static uint32_t add_string(property_groups* g, const char* s, size_t len)
+{
+    size_t              offset = g->strings.size;
+
+    if ((uint64_t) offset + len >= UINT32_MAX) {
+        fprintf(stderr, "The output of --group-binary is too large.\n");
+        exit(1);
+    }
+    buffer_append(&g->strings, s, len);
+    buffer_append(&g->strings, "", 1);
+
+    return (uint32_t) offset;
+}
+
+/*
+ * Adds the properties of the new set, which are NAME=VALUE lines, to the
+ * tables of --group-binary.
+ */
+static void add_binary_set(property_groups* g, const property_set* set)
+{
+    const char*         line = g->texts.data + set->start;
+    const char*         end = line + set->size;
+    uint32_t            first = g->property_count;
+    unsigned char       entry[8];
+
+    while (line < end) {
+        const char*     eol = (const char*) memchr(line, '\n', end - line);
+        const char*     eq;
+        const char*     value;
+
+        if (eol == NULL)
+            eol = end;
+        eq = (const char*) memchr(line, '=', eol - line);
+        if (eq == NULL)
+            eq = eol;
+        value = eq < eol ? eq + 1 : eol;
+        put_u32(entry, add_string(g, line, eq - line));
+        put_u32(entry + 4, add_string(g, value, eol - value));
+        buffer_append(&g->property_table, entry, 8);
+        ++ g->property_count;
+        line = eol + 1;
+    }
+
+    put_u32(entry, first);
+    put_u32(entry + 4, g->property_count - first);
+    buffer_append(&g->set_table, entry, 8);
+}
+
+/*
+ * See header file
+ */
+size_t group_find_set(property_groups* g, const char* text, size_t len,
+        _Bool* is_new)
+{
+    uint64_t            hash = ec_fnv_hash(EC_FNV_HASH_INIT, text, len);
+    property_set*       set;
+    size_t              i;
+
+    /* keep the table at most half full */
+    if (2 * (g->set_count + 1) > g->bucket_count) {
+        size_t          j;
+
+        free(g->buckets);
+        g->bucket_count = g->bucket_count ? g->bucket_count * 2 : 256;
+        g->buckets = (size_t*) calloc(g->bucket_count, sizeof(size_t));
+        if (g->buckets == NULL) {
+            perror("Unable to allocate memory");
+            exit(2);
+        }
+        for (j = 0; j < g->set_count; ++j) {
+            i = (size_t) g->sets[j].hash & (g->bucket_count - 1);
+            while (g->buckets[i] != 0)
+                i = (i + 1) & (g->bucket_count - 1);
+            g->buckets[i] = j + 1;
+        }
+    }
+
+    *is_new = 0;
+    for (i = (size_t) hash & (g->bucket_count - 1); g->buckets[i] != 0;
+            i = (i + 1) & (g->bucket_count - 1)) {
+        set = &g->sets[g->buckets[i] - 1];
+        if (set->hash == hash && set->size == len && (len == 0 ||
+                    memcmp(g->texts.data + set->start, text, len) == 0))
+            return g->buckets[i];
+    }
+
+    if (g->set_count == g->set_capacity) {
+        property_set*   new_sets;
+
+        g->set_capacity = g->set_capacity ? g->set_capacity * 2 : 64;
+        new_sets = (property_set*) realloc(g->sets,
+                g->set_capacity * sizeof(property_set));
+        if (new_sets == NULL) {
+            perror("Unable to allocate memory");
+            exit(2);
+        }
+        g->sets = new_sets;
+    }
+
+    set = &g->sets[g->set_count ++];
+    set->hash = hash;
+    set->start = g->texts.size;
+    set->size = len;
+    buffer_append(&g->texts, text, len);
+    g->buckets[i] = g->set_count;
+    *is_new = 1;
+
+    if (g->is_binary)
+        add_binary_set(g, set);
+
+    return g->set_count;
+}
+
+/*
+ * See header file
+ */
+void group_write_set(const property_groups* g, output* out, size_t id)
+{
+    const property_set* set = &g->sets[id - 1];
+    char                line[32];
+
+    sprintf(line, "[%lu]\n", (unsigned long) id);
+    output_puts(out, line);
+    if (set->size > 0)
+        output_write(out, g->texts.data + set->start, set->size);
+    output_write(out, "\n", 1);
+}
+
+/*
+ * See header file
+ */
+void group_write_file(property_groups* g, output* out, const char* file,
+        size_t id)
+{
+    char                line[32];
+
+    if (g->is_binary) {
+        unsigned char   entry[8];
+
+        put_u32(entry, add_string(g, file, strlen(file)));
+        put_u32(entry + 4, (uint32_t) id);
+        output_write(out, (const char*) entry, 8);
+        return;
+    }
+
+    output_puts(out, file);
+    sprintf(line, "\t%lu\n", (unsigned long) id);
+    output_puts(out, line);
+}
+
+static void output_table(output* out, const byte_buffer* table)
+{
+    if (table->size > 0)
+        output_write(out, table->data, table->size);
+}
+
+/*
+ * See header file. Since each entry has its own path in the strings, the
+ * counts fit in 32 bits as the offsets do.
+ */
+void group_write_binary(const property_groups* g, output* out)
+{
+    unsigned char       header[24];
+    unsigned char       no_set[8] = { 0 };
+
+    memcpy(header, "ECGR", 4);
+    put_u32(header + 4, GROUP_BINARY_VERSION);
+    put_u32(header + 8, (uint32_t) g->set_count + 1);
+    put_u32(header + 12, g->property_count);
+    put_u32(header + 16, (uint32_t) (g->file_table.size / 8));
+    put_u32(header + 20, (uint32_t) g->strings.size);
+
+    out->redirect = NULL;
+    output_write(out, (const char*) header, sizeof(header));
+    /* the ID 0 is for the files whose parsing failed */
+    output_write(out, (const char*) no_set, sizeof(no_set));
+    output_table(out, &g->set_table);
+    output_table(out, &g->property_table);
+    output_table(out, &g->file_table);
+    output_table(out, &g->strings);
+}
+
+void group_destroy(property_groups* g)
+{
+    free(g->sets);
+    free(g->texts.data);
+    free(g->buckets);
+    free(g->set_table.data);
+    free(g->property_table.data);
+    free(g->file_table.data);
+    free(g->strings.data);
+}
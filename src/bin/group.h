@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef GROUP_H__
+#define GROUP_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "output.h"
+
+typedef struct
+{
+    uint64_t            hash;
+    /* the properties as printed by the editorconfig command, in texts */
+    size_t              start;
+    size_t              size;
+} property_set;
+
+/*
+ * The sets of properties of --group and --group-binary. With --group, each
+ * distinct set of properties is given an ID from 1 and printed once, before
+ * the first file that has it, and each file is printed as a line with its path
+ * and the ID of its properties. With --group-binary, the output only gathers
+ * the entries of the files in file_table, and the whole result is written at
+ * the end by group_write_binary(). See the documentation of the options for
+ * the formats.
+ */
+typedef struct
+{
+    _Bool               is_binary;
+
+    /* the set with the ID i is sets[i - 1] */
+    property_set*       sets;
+    size_t              set_count;
+    size_t              set_capacity;
+    byte_buffer         texts;
+    /* the IDs of the sets, by hash, with 0 for the empty buckets */
+    size_t*             buckets;
+    size_t              bucket_count;
+
+    /* With --group-binary, the tables of the sets and of their properties,
+     * the entries of the files, and the null-terminated names, values and
+     * paths they point to */
+    byte_buffer         set_table;
+    byte_buffer         property_table;
+    byte_buffer         file_table;
+    byte_buffer         strings;
+    uint32_t            property_count;
+} property_groups;
+
+/*
+ * Returns the ID of the set of properties printed as the len bytes at text,
+ * adding it if it is new, in which case *is_new is set to 1.
+ */
+size_t group_find_set(property_groups* g, const char* text, size_t len,
+        _Bool* is_new);
+
+/*
+ * Writes the set with the given ID to out, as [ID] followed by its properties
+ * and an empty line, for --group.
+ */
+void group_write_set(const property_groups* g, output* out, size_t id);
+
+/*
+ * Writes the entry of the file whose properties are the set with the given
+ * ID, or 0 if its parsing failed, to out.
+ */
+void group_write_file(property_groups* g, output* out, const char* file,
+        size_t id);
+
+/*
+ * Writes the result of --group-binary to stdout through out, once the entries
+ * of all the files were gathered in file_table by redirecting out there.
+ */
+void group_write_binary(const property_groups* g, output* out);
+
+void group_destroy(property_groups* g);
+
+#endif /* !GROUP_H__ */
@@ -26,13 +26,31 @@
 
 #include "config.h"
 #include <ctype.h>
+#include <limits.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <editorconfig/editorconfig.h>
 
+#ifdef HAVE_SYS_INOTIFY_H
+# define HAVE_WATCH
+# include <errno.h>
+# include <poll.h>
+#endif
+
+#ifdef WIN32
+# include <fcntl.h>
+# include <io.h>
+#endif
+
+#include "client.h"
+#include "group.h"
+#include "output.h"
+#include "server.h"
 #include "util.h"
+#include "walk.h"
 
 
 static void version(FILE* stream)
@@ -51,14 +69,750 @@ static void usage(FILE* stream, const char* command)
 {
     fprintf(stream, "Usage: %s [OPTIONS] FILEPATH1 [FILEPATH2 FILEPATH3 ...]\n", command);
     fprintf(stream, "FILEPATH can be a hyphen (-) if you want to path(s) to be read from stdin.\n");
+    fprintf(stream, "The errors of the paths read from stdin are printed as comments starting with\n");
+    fprintf(stream, "\";\" and do not stop the processing of the following paths.\n");
 
     fprintf(stream, "\n");
     fprintf(stream, "-f                 Specify conf filename other than \".editorconfig\".\n");
     fprintf(stream, "-b                 Specify version (used by devs to test compatibility).\n");
+    fprintf(stream, "--property NAME    Only print the property NAME. Can be repeated.\n");
+    fprintf(stream, "-z                 Paths read from stdin are separated by null characters\n");
+    fprintf(stream, "                   instead of newlines.\n");
+#ifdef HAVE_WALK
+    fprintf(stream, "--walk DIR         Print the properties of every file in the directory tree\n");
+    fprintf(stream, "                   DIR, with the errors printed as for stdin. Can be repeated.\n");
+    fprintf(stream, "--exclude PATTERN  Skip the files and directories whose name matches the glob\n");
+    fprintf(stream, "                   PATTERN in the trees of --walk and --compile-index. Can be\n");
+    fprintf(stream, "                   repeated.\n");
+    fprintf(stream, "--compile-index DIR\n");
+    fprintf(stream, "                   Write an index of the EditorConfig files in the directory\n");
+    fprintf(stream, "                   tree DIR to DIR/.editorconfig.idx, instead of printing\n");
+    fprintf(stream, "                   properties.\n");
+    fprintf(stream, "-o FILE            Write the index of --compile-index to FILE, which must be\n");
+    fprintf(stream, "                   in DIR or in a parent directory of DIR.\n");
+    fprintf(stream, "--index FILE       Take the EditorConfig files of the directory of FILE and\n");
+    fprintf(stream, "                   its subdirectories from the index FILE when they have not\n");
+    fprintf(stream, "                   changed since it was written.\n");
+#endif
+#ifdef HAVE_WATCH
+    fprintf(stream, "--watch            Keep running after printing the files, and print the\n");
+    fprintf(stream, "                   files whose properties change when an EditorConfig file\n");
+    fprintf(stream, "                   is edited again, until interrupted.\n");
+#endif
+    fprintf(stream, "--cache            Keep the parsed EditorConfig files and their compiled\n");
+    fprintf(stream, "                   patterns for the next runs in\n");
+    fprintf(stream, "                   $XDG_CACHE_HOME/editorconfig/cache.\n");
+    fprintf(stream, "--group            Print each distinct set of properties once, as [ID]\n");
+    fprintf(stream, "                   followed by its properties and an empty line, and each\n");
+    fprintf(stream, "                   file as its path, a tab and the ID of its properties, 0\n");
+    fprintf(stream, "                   if its parsing failed.\n");
+    fprintf(stream, "--group-binary     Write the sets and the files of --group in a binary\n");
+    fprintf(stream, "                   format that can be mapped in memory.\n");
+    fprintf(stream, "--daemon           Ask editorconfig-daemon for the properties of the files\n");
+    fprintf(stream, "                   if it is running, and parse them in process otherwise.\n");
+    fprintf(stream, "--server           Answer the requests of an editor read from stdin until\n");
+    fprintf(stream, "                   its end, instead of the FILEPATHs.\n");
     fprintf(stream, "-h OR --help       Print this help message.\n");
     fprintf(stream, "-v OR --version    Display version information.\n");
 }
 
+/* Returned instead of the error of the parsing of a file when the daemon
+ * reported it, in which case daemon_error is the line describing it */
+#define DAEMON_ERROR        INT_MIN
+
+#ifdef HAVE_WATCH
+/*
+ * The files printed with --watch, with a hash of their last section.
+ */
+typedef struct
+{
+    char*               path;
+    uint64_t            hash;
+} watched_file;
+
+/* The time to wait for more changes after a change, in milliseconds, since
+ * saving a file usually makes several of them */
+#define WATCH_SETTLE_DELAY  50
+#endif
+
+/*
+ * The paths read from stdin are resolved by windows of the paths that were
+ * already read, grouped by directory so that the EditorConfig files of each
+ * directory are only loaded once per window, and their sections are printed
+ * in their input order at the end of each window. Since a window never waits
+ * for more input, the sections of the paths given so far are printed as soon
+ * as they are resolved. The paths given as arguments are resolved by windows
+ * as well.
+ */
+#define WINDOW_SIZE         1024
+
+typedef struct
+{
+    const char*         path;
+    /* the length of the directory of path, without the last '/' */
+    size_t              dir_len;
+    /* the position of path in the input */
+    int                 index;
+} window_path;
+
+/* the section of each path of the window in the capture, by input position */
+typedef struct
+{
+    const char*         path;
+    size_t              start;
+    size_t              size;
+    _Bool               is_failed;
+} window_section;
+
+/*
+ * Everything needed to print the properties of the files.
+ */
+typedef struct
+{
+    editorconfig_handle eh;
+    /* The properties given with --property, all printed if there is none */
+    const char**        properties;
+    int                 property_count;
+
+    output              out;
+
+    /* With --group and --group-binary, the sets of properties printed so
+     * far */
+    _Bool               is_grouping;
+    property_groups     groups;
+
+    /* The connection to editorconfig-daemon with --daemon, which is closed if
+     * the daemon stops answering, and the lines the requests end with */
+    client*             daemon_client;
+    char*               daemon_options;
+    char*               daemon_request;
+    size_t              daemon_request_capacity;
+    const char*         daemon_error;
+    size_t              daemon_error_size;
+
+#ifdef HAVE_WATCH
+    /* With --watch, each section is captured so that it is only printed again
+     * when it changes */
+    _Bool               is_watching;
+    watched_file*       watched_files;
+    size_t              watched_count;
+    size_t              watched_capacity;
+#endif
+
+    window_path         window_paths[WINDOW_SIZE];
+    window_section      window_sections[WINDOW_SIZE];
+} printer;
+
+/*
+ * Prints the error returned by the parsing of a file and exits.
+ */
+static void parse_error(printer* p, int err_num)
+{
+    output_flush(&p->out);
+    fflush(stdout);
+    if (err_num == DAEMON_ERROR) {
+        /* skip the "; " the line starts with */
+        fwrite(p->daemon_error + 2, 1, p->daemon_error_size - 2, stderr);
+        exit(1);
+    }
+    fputs(editorconfig_get_error_msg(err_num), stderr);
+    if (err_num > 0)
+        fprintf(stderr, ":%d \"%s\"", err_num,
+                editorconfig_handle_get_err_file(p->eh));
+    fprintf(stderr, "\n");
+    exit(1);
+}
+
+/*
+ * Prints the error returned by the parsing of a file as a comment of the
+ * output, so that the processing of the following files can go on.
+ */
+static void output_error(printer* p, int err_num)
+{
+    char        line[32];
+
+    if (err_num == DAEMON_ERROR) {
+        output_write(&p->out, p->daemon_error, p->daemon_error_size);
+        return;
+    }
+
+    output_puts(&p->out, "; ");
+    output_puts(&p->out, editorconfig_get_error_msg(err_num));
+    if (err_num > 0) {
+        sprintf(line, ":%d \"", err_num);
+        output_puts(&p->out, line);
+        output_puts(&p->out, editorconfig_handle_get_err_file(p->eh));
+        output_puts(&p->out, "\"");
+    }
+    output_puts(&p->out, "\n");
+}
+
+/*
+ * Reads the paths given on stdin. They are read in large blocks and returned
+ * in place, so that reading them costs little more than copying them.
+ */
+typedef struct
+{
+    /* the character each path ends with */
+    char                delimiter;
+    char*               buffer;
+    /* the number of bytes read in buffer */
+    size_t              size;
+    size_t              capacity;
+    /* the beginning of the next path in buffer */
+    size_t              pos;
+    _Bool               is_eof;
+} path_reader;
+
+/*
+ * Returns the next path of stdin, or NULL if there is none left. The path is
+ * valid until a call that reads more of stdin, which only happens when
+ * has_buffered_path() returns 0.
+ */
+static char* read_path(path_reader* reader)
+{
+    for (;;) {
+        char*       path = reader->buffer + reader->pos;
+        char*       end = NULL;
+        size_t      count;
+
+        if (reader->pos < reader->size)
+            end = (char*) memchr(path, reader->delimiter,
+                    reader->size - reader->pos);
+
+        if (end != NULL) {
+            *end = '\0';
+            reader->pos = (size_t) (end + 1 - reader->buffer);
+            return path;
+        }
+
+        if (reader->is_eof) {
+            /* the last path might not end with the delimiter */
+            if (reader->pos == reader->size)
+                return NULL;
+            reader->buffer[reader->size] = '\0';
+            reader->pos = reader->size;
+            return path;
+        }
+
+        /* move the beginning of the next path to the beginning of the buffer,
+         * keeping room for a null character */
+        if (reader->pos > 0)
+            memmove(reader->buffer, path, reader->size - reader->pos);
+        reader->size -= reader->pos;
+        reader->pos = 0;
+        if (reader->size + 1 >= reader->capacity) {
+            char*       new_buffer;
+
+            reader->capacity = reader->capacity ?
+                reader->capacity * 2 : IO_BUFFER_SIZE;
+            new_buffer = (char*) realloc(reader->buffer, reader->capacity);
+            if (new_buffer == NULL) {
+                perror("Unable to allocate memory");
+                exit(2);
+            }
+            reader->buffer = new_buffer;
+        }
+
+        count = fread(reader->buffer + reader->size, 1,
+                reader->capacity - reader->size - 1, stdin);
+        reader->size += count;
+        if (count == 0) {
+            if (ferror(stdin))
+                perror("Failed to read stdin");
+            reader->is_eof = 1;
+        }
+    }
+}
+
+/*
+ * Returns 1 if the next path of stdin was already read, so that read_path()
+ * returns it without reading more of stdin, 0 otherwise.
+ */
+static _Bool has_buffered_path(const path_reader* reader)
+{
+    if (reader->pos >= reader->size)
+        return 0;
+
+    return reader->is_eof || memchr(reader->buffer + reader->pos,
+            reader->delimiter, reader->size - reader->pos) != NULL;
+}
+
+/*
+ * Trims the space characters around a path read from stdin if the paths are
+ * lines, and returns the trimmed path, which is empty for a blank line.
+ */
+static char* trim_path(const path_reader* reader, char* path)
+{
+    size_t          len;
+
+    if (reader->delimiter != '\n')
+        return path;
+
+    len = strlen(path);
+    while (len > 0 && isspace((unsigned char) path[len - 1]))
+        -- len;
+    path[len] = '\0';
+    while (isspace((unsigned char) *path))
+        ++ path;
+
+    return path;
+}
+
+
+/*
+ * Connects to editorconfig-daemon, if it is running, and prepares the lines
+ * of the requests given by the options.
+ */
+static void daemon_connect(printer* p, const char* conf_filename,
+        int version_major, int version_minor, int version_patch)
+{
+    char                socket_path[256];
+    size_t              size = 1;
+    int                 j;
+
+    if (client_get_socket_path(socket_path, sizeof(socket_path), 0) != 0 ||
+            (p->daemon_client = client_connect(socket_path)) == NULL)
+        return;
+
+    if (conf_filename)
+        size += strlen(conf_filename) + sizeof("conf=\n");
+    size += 3 * 12 + sizeof("version=\n");
+    for (j = 0; j < p->property_count; ++j)
+        size += strlen(p->properties[j]) + sizeof("property=\n");
+
+    p->daemon_options = (char*) malloc(size);
+    if (p->daemon_options == NULL) {
+        perror("Unable to allocate memory");
+        exit(2);
+    }
+    p->daemon_options[0] = '\0';
+
+    if (conf_filename)
+        sprintf(p->daemon_options + strlen(p->daemon_options), "conf=%s\n",
+                conf_filename);
+    /* the numbers not given with -b are 0, as in the handle */
+    if (version_major >= 0 || version_minor >= 0 || version_patch >= 0)
+        sprintf(p->daemon_options + strlen(p->daemon_options),
+                "version=%d.%d.%d\n",
+                version_major > 0 ? version_major : 0,
+                version_minor > 0 ? version_minor : 0,
+                version_patch > 0 ? version_patch : 0);
+    for (j = 0; j < p->property_count; ++j)
+        sprintf(p->daemon_options + strlen(p->daemon_options),
+                "property=%s\n", p->properties[j]);
+}
+
+/*
+ * Asks the daemon for the properties of the file and prints them. Returns 0 on
+ * success, DAEMON_ERROR if the daemon reported an error, and -1 if it did not
+ * answer, in which case the files are parsed in process from then on.
+ */
+static int daemon_print_properties(printer* p, const char* file)
+{
+    size_t              file_len = strlen(file);
+    size_t              options_len = strlen(p->daemon_options);
+    size_t              size = sizeof("file=\n") - 1 + file_len + options_len;
+    const char*         response;
+    size_t              response_size;
+
+    if (size > p->daemon_request_capacity) {
+        char*           new_request = (char*) realloc(p->daemon_request, size);
+
+        if (new_request == NULL) {
+            perror("Unable to allocate memory");
+            exit(2);
+        }
+        p->daemon_request = new_request;
+        p->daemon_request_capacity = size;
+    }
+    memcpy(p->daemon_request, "file=", 5);
+    memcpy(p->daemon_request + 5, file, file_len);
+    p->daemon_request[5 + file_len] = '\n';
+    memcpy(p->daemon_request + 6 + file_len, p->daemon_options, options_len);
+
+    if (client_request(p->daemon_client, p->daemon_request, size, &response,
+                &response_size) != 0) {
+        client_close(p->daemon_client);
+        p->daemon_client = NULL;
+        return -1;
+    }
+
+    if (response_size >= 2 && response[0] == ';') {
+        p->daemon_error = response;
+        p->daemon_error_size = response_size;
+        return DAEMON_ERROR;
+    }
+    output_write(&p->out, response, response_size);
+
+    return 0;
+}
+
+/*
+ * Prints the properties of the file, or only the given ones if property_count
+ * is not 0. Returns the error of the parsing, if any.
+ */
+static int print_properties(printer* p, const char* file)
+{
+    int                 err_num;
+    int                 name_value_count;
+    int                 j;
+
+    /* the requests cannot hold a path with a newline */
+    if (p->daemon_client != NULL && strchr(file, '\n') == NULL) {
+        err_num = daemon_print_properties(p, file);
+        if (err_num != -1)
+            return err_num;
+    }
+
+    /* only look for the requested properties */
+    if (p->property_count > 0) {
+        for (j = 0; j < p->property_count; ++j) {
+            const char*         value;
+
+            err_num = editorconfig_get_property(file, p->eh, p->properties[j],
+                    &value);
+            if (err_num != 0)
+                return err_num;
+
+            if (value != NULL) {
+                output_puts(&p->out, p->properties[j]);
+                output_write(&p->out, "=", 1);
+                output_puts(&p->out, value);
+                output_write(&p->out, "\n", 1);
+            }
+        }
+        return 0;
+    }
+
+    /* parsing the editorconfig files */
+    err_num = editorconfig_parse(file, p->eh);
+    if (err_num != 0)
+        return err_num;
+
+    /* print the result */
+    name_value_count = editorconfig_handle_get_name_value_count(p->eh);
+    for (j = 0; j < name_value_count; ++j) {
+        const char*         name;
+        const char*         value;
+
+        editorconfig_handle_get_name_value(p->eh, j, &name, &value);
+        output_puts(&p->out, name);
+        output_write(&p->out, "=", 1);
+        output_puts(&p->out, value);
+        output_write(&p->out, "\n", 1);
+    }
+
+    return 0;
+}
+
+/*
+ * Writes the entry of the file for --group and --group-binary, after its set
+ * of properties if the set is new, and returns the same as write_section().
+ * The new sets are not captured with the entry, so that they come before the
+ * captured entries that refer to them.
+ */
+static int write_group_entry(printer* p, const char* file)
+{
+    output*             out = &p->out;
+    _Bool               was_capturing = out->is_capturing;
+    size_t              start = was_capturing ? out->capture.size : 0;
+    size_t              id = 0;
+    _Bool               is_new = 0;
+    int                 err_num;
+
+    out->capture.size = start;
+    out->is_capturing = 1;
+    err_num = print_properties(p, file);
+    out->is_capturing = 0;
+    if (err_num == 0)
+        id = group_find_set(&p->groups, out->capture.data + start,
+                out->capture.size - start, &is_new);
+    out->capture.size = start;
+
+    if (is_new && !p->groups.is_binary)
+        group_write_set(&p->groups, out, id);
+    out->is_capturing = was_capturing;
+
+    group_write_file(&p->groups, out, file, id);
+    if (err_num != 0 && !p->groups.is_binary)
+        output_error(p, err_num);
+
+    return err_num != 0;
+}
+
+/*
+ * Writes the file path with [] followed by its properties, or the error of its
+ * parsing as a comment, or the entry of the file with --group. Returns 1 if
+ * there is an error, 0 otherwise.
+ */
+static int write_section(printer* p, const char* file)
+{
+    int                 err_num;
+
+    if (p->is_grouping)
+        return write_group_entry(p, file);
+
+    output_write(&p->out, "[", 1);
+    output_puts(&p->out, file);
+    output_write(&p->out, "]\n", 2);
+
+    err_num = print_properties(p, file);
+    if (err_num != 0) {
+        output_error(p, err_num);
+        return 1;
+    }
+
+    return 0;
+}
+
+#ifdef HAVE_WATCH
+/*
+ * Writes the section of the file to the capture buffer. Returns the same as
+ * write_section().
+ */
+static int capture_section(printer* p, const char* file)
+{
+    int                 status;
+
+    p->out.capture.size = 0;
+    p->out.is_capturing = 1;
+    status = write_section(p, file);
+    p->out.is_capturing = 0;
+
+    return status;
+}
+
+/*
+ * Adds the file whose section was just captured to the watched files.
+ */
+static void add_watched_file(printer* p, const char* file)
+{
+    watched_file*       wf;
+
+    if (p->watched_count == p->watched_capacity) {
+        watched_file*   new_files;
+
+        p->watched_capacity = p->watched_capacity ?
+            p->watched_capacity * 2 : 64;
+        new_files = (watched_file*) realloc(p->watched_files,
+                p->watched_capacity * sizeof(watched_file));
+        if (new_files == NULL) {
+            perror("Unable to allocate memory");
+            exit(2);
+        }
+        p->watched_files = new_files;
+    }
+
+    wf = &p->watched_files[p->watched_count ++];
+    wf->path = strdup(file);
+    if (wf->path == NULL) {
+        perror("Unable to allocate memory");
+        exit(2);
+    }
+    wf->hash = ec_fnv_hash(EC_FNV_HASH_INIT, p->out.capture.data,
+            p->out.capture.size);
+}
+
+/*
+ * Waits for the EditorConfig files watched by the handle to change, and prints
+ * the sections of the watched files that changed, until interrupted or an
+ * error occurs.
+ */
+static void watch(printer* p)
+{
+    struct pollfd       pfd;
+
+    pfd.fd = editorconfig_handle_get_watch_fd(p->eh);
+    pfd.events = POLLIN;
+
+    for (;;) {
+        int             change_count = 0;
+        size_t          i;
+
+        output_flush(&p->out);
+        if (fflush(stdout) != 0) {
+            perror("Failed to write stdout");
+            exit(1);
+        }
+
+        if (poll(&pfd, 1, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            perror("Failed to wait for changes");
+            exit(1);
+        }
+
+        /* take the changes made meanwhile too, so that the files are only
+         * printed once */
+        do
+            change_count += editorconfig_handle_process_watch_events(p->eh);
+        while (poll(&pfd, 1, WATCH_SETTLE_DELAY) > 0);
+
+        if (change_count == 0)
+            continue;
+
+        for (i = 0; i < p->watched_count; ++i) {
+            watched_file*   wf = &p->watched_files[i];
+            uint64_t        hash;
+
+            capture_section(p, wf->path);
+            hash = ec_fnv_hash(EC_FNV_HASH_INIT, p->out.capture.data,
+                    p->out.capture.size);
+            if (hash != wf->hash) {
+                wf->hash = hash;
+                output_write(&p->out, p->out.capture.data,
+                        p->out.capture.size);
+            }
+        }
+    }
+}
+#endif /* HAVE_WATCH */
+
+/*
+ * Prints the file path with [] followed by its properties, or the error of its
+ * parsing as a comment, and watches the file with --watch. Returns 1 if there
+ * is an error, 0 otherwise.
+ */
+static int print_section(printer* p, const char* file)
+{
+#ifdef HAVE_WATCH
+    if (p->is_watching) {
+        int             status = capture_section(p, file);
+
+        add_watched_file(p, file);
+        output_write(&p->out, p->out.capture.data, p->out.capture.size);
+        return status;
+    }
+#endif
+
+    return write_section(p, file);
+}
+
+#ifdef HAVE_WALK
+/*
+ * Calls print_section() for the files found by walk().
+ */
+static int print_walked_file(const char* path, void* data)
+{
+    return print_section((printer*) data, path);
+}
+#endif
+
+/*
+ * Adds path to the window of count paths.
+ */
+static void add_window_path(printer* p, const char* path, int count)
+{
+    const char*         slash = strrchr(path, '/');
+
+    p->window_paths[count].path = path;
+    p->window_paths[count].dir_len = slash ? (size_t) (slash - path) : 0;
+    p->window_paths[count].index = count;
+    p->window_sections[count].path = path;
+}
+
+static int compare_window_paths(const void* a, const void* b)
+{
+    const window_path*  wa = (const window_path*) a;
+    const window_path*  wb = (const window_path*) b;
+    int                 cmp;
+
+    cmp = memcmp(wa->path, wb->path,
+            wa->dir_len < wb->dir_len ? wa->dir_len : wb->dir_len);
+    if (cmp != 0)
+        return cmp;
+    if (wa->dir_len != wb->dir_len)
+        return wa->dir_len < wb->dir_len ? -1 : 1;
+
+    /* keep the input order in a directory */
+    return wa->index - wb->index;
+}
+
+/*
+ * Prints the sections of the count paths of the window. If exits_on_error is
+ * set, as for the paths given as arguments without --group, the sections are
+ * printed until the first path whose parsing fails, which is parsed again to
+ * print its error before exiting, as if the paths were parsed one by one.
+ * Returns 1 if there is an error with one of them, 0 otherwise.
+ */
+static int print_window_paths(printer* p, int count, _Bool exits_on_error)
+{
+    output*             out = &p->out;
+    int                 status = 0;
+    int                 i;
+
+    exits_on_error = exits_on_error && !p->is_grouping;
+
+    qsort(p->window_paths, (size_t) count, sizeof(window_path),
+            compare_window_paths);
+
+    /* the EditorConfig files are only cached for the window, so that the
+     * changes made to them later are seen by the next windows */
+    editorconfig_handle_set_directory_cache(p->eh, 1);
+    out->capture.size = 0;
+    out->is_capturing = 1;
+    for (i = 0; i < count; ++i) {
+        window_section*     ws = &p->window_sections[p->window_paths[i].index];
+
+        ws->start = out->capture.size;
+        if (exits_on_error) {
+            size_t          header_end;
+
+            output_write(out, "[", 1);
+            output_puts(out, ws->path);
+            output_write(out, "]\n", 2);
+            header_end = out->capture.size;
+            ws->is_failed = print_properties(p, ws->path) != 0;
+            /* what the parsing printed is printed again with its error */
+            if (ws->is_failed)
+                out->capture.size = header_end;
+        } else
+            ws->is_failed = write_section(p, ws->path) != 0;
+        ws->size = out->capture.size - ws->start;
+    }
+    out->is_capturing = 0;
+    editorconfig_handle_set_directory_cache(p->eh, 0);
+
+    for (i = 0; i < count; ++i) {
+        window_section*     ws = &p->window_sections[i];
+
+        output_write(out, out->capture.data + ws->start, ws->size);
+        if (!ws->is_failed)
+            continue;
+        status = 1;
+        if (exits_on_error) {
+            int             err_num = print_properties(p, ws->path);
+
+            if (err_num != 0)
+                parse_error(p, err_num);
+        }
+    }
+
+    return status;
+}
+
+/*
+ * Prints the sections of path and of the next paths of stdin that were
+ * already read, up to WINDOW_SIZE paths. Returns 1 if there is an error with
+ * one of them, 0 otherwise.
+ */
+static int print_window(printer* p, char* path, path_reader* reader)
+{
+    int                 count = 0;
+
+    for (;;) {
+        if (*path != '\0')
+            add_window_path(p, path, count ++);
+
+        if (count == WINDOW_SIZE || !has_buffered_path(reader))
+            break;
+        path = trim_path(reader, read_path(reader));
+    }
+
+    return print_window_paths(p, count, 0);
+}
+
 /*
  * Returns strdup(s) and exits if it fails.
  */
@@ -75,12 +829,12 @@ static char* xstrdup(const char* s)
 
 int main(int argc, const char* argv[])
 {
-    char*                               full_filename = NULL;
     int                                 err_num;
     int                                 i;
-    int                                 name_value_count;
-    editorconfig_handle                 eh;
-    char**                              file_paths = NULL;
+    /* Too large for the stack */
+    static printer                      pr;
+    printer*                            p = &pr;
+    const char**                        file_paths = NULL;
     int                                 path_count = 0; /* the count of path input*/
     /* Will be a EditorConfig file name if -f is specified on command line */
     const char*                         conf_filename = NULL;
@@ -89,11 +843,41 @@ int main(int argc, const char* argv[])
     int                                 version_minor = -1;
     int                                 version_patch = -1;
 
-    /* File names read from stdin are put in this buffer temporarily */
-    char                                file_line_buffer[FILENAME_MAX + 1];
+    /* File names read from stdin, separated by newlines unless -z is
+     * specified */
+    path_reader                         stdin_paths;
+    /* The exit status, which is 1 if the parsing of a path read from stdin
+     * or found by --walk failed */
+    int                                 exit_status = 0;
+
+    /* The directories given with --walk, and the names given with --exclude
+     * to skip in them */
+    const char**                        walk_dirs = NULL;
+    int                                 walk_count = 0;
+    const char**                        excludes = NULL;
+    int                                 exclude_count = 0;
+
+    /* The directory given with --compile-index, the index file given with -o
+     * and the index given with --index */
+    const char*                         compile_root = NULL;
+    const char*                         index_output = NULL;
+    const char*                         index_path = NULL;
 
     _Bool                               f_flag = 0;
     _Bool                               b_flag = 0;
+    _Bool                               property_flag = 0;
+    _Bool                               walk_flag = 0;
+    _Bool                               exclude_flag = 0;
+    _Bool                               compile_index_flag = 0;
+    _Bool                               o_flag = 0;
+    _Bool                               index_flag = 0;
+    _Bool                               server_flag = 0;
+    _Bool                               daemon_flag = 0;
+    _Bool                               watch_flag = 0;
+    _Bool                               cache_flag = 0;
+
+    memset(&stdin_paths, 0, sizeof(stdin_paths));
+    stdin_paths.delimiter = '\n';
 
     if (argc <= 1) {
         version(stderr);
@@ -142,6 +926,47 @@ int main(int argc, const char* argv[])
         } else if (f_flag) {
             f_flag = 0;
             conf_filename = argv[i];
+        } else if (property_flag) {
+            property_flag = 0;
+            if (p->properties == NULL) {
+                p->properties = (const char**) malloc(argc * sizeof(char*));
+                if (p->properties == NULL) {
+                    perror("Unable to allocate memory");
+                    exit(2);
+                }
+            }
+            /* the names are printed as in the full output */
+            p->properties[p->property_count ++] =
+                ec_lowercase(xstrdup(argv[i]));
+        } else if (walk_flag) {
+            walk_flag = 0;
+            if (walk_dirs == NULL) {
+                walk_dirs = (const char**) malloc(argc * sizeof(char*));
+                if (walk_dirs == NULL) {
+                    perror("Unable to allocate memory");
+                    exit(2);
+                }
+            }
+            walk_dirs[walk_count ++] = argv[i];
+        } else if (exclude_flag) {
+            exclude_flag = 0;
+            if (excludes == NULL) {
+                excludes = (const char**) malloc(argc * sizeof(char*));
+                if (excludes == NULL) {
+                    perror("Unable to allocate memory");
+                    exit(2);
+                }
+            }
+            excludes[exclude_count ++] = argv[i];
+        } else if (compile_index_flag) {
+            compile_index_flag = 0;
+            compile_root = argv[i];
+        } else if (o_flag) {
+            o_flag = 0;
+            index_output = argv[i];
+        } else if (index_flag) {
+            index_flag = 0;
+            index_path = argv[i];
         } else if (strcmp(argv[i], "--version") == 0 ||
                 strcmp(argv[i], "-v") == 0) {
             version(stdout);
@@ -155,123 +980,293 @@ int main(int argc, const char* argv[])
             b_flag = 1;
         else if (strcmp(argv[i], "-f") == 0)
             f_flag = 1;
+        else if (strcmp(argv[i], "--property") == 0)
+            property_flag = 1;
+        else if (strcmp(argv[i], "-z") == 0)
+            stdin_paths.delimiter = '\0';
+        else if (strcmp(argv[i], "--walk") == 0) {
+#ifdef HAVE_WALK
+            walk_flag = 1;
+#else
+            fprintf(stderr, "--walk is not supported on this platform.\n");
+            exit(1);
+#endif
+        } else if (strcmp(argv[i], "--exclude") == 0)
+            exclude_flag = 1;
+        else if (strcmp(argv[i], "--compile-index") == 0 ||
+                strcmp(argv[i], "--index") == 0) {
+#ifdef HAVE_WALK
+            if (argv[i][2] == 'c')
+                compile_index_flag = 1;
+            else
+                index_flag = 1;
+#else
+            fprintf(stderr, "%s is not supported on this platform.\n",
+                    argv[i]);
+            exit(1);
+#endif
+        } else if (strcmp(argv[i], "-o") == 0)
+            o_flag = 1;
+        else if (strcmp(argv[i], "--server") == 0)
+            server_flag = 1;
+        else if (strcmp(argv[i], "--daemon") == 0)
+            daemon_flag = 1;
+        else if (strcmp(argv[i], "--cache") == 0)
+            cache_flag = 1;
+        else if (strcmp(argv[i], "--group") == 0)
+            p->is_grouping = 1;
+        else if (strcmp(argv[i], "--group-binary") == 0) {
+            p->is_grouping = 1;
+            p->groups.is_binary = 1;
+        }
+        else if (strcmp(argv[i], "--watch") == 0) {
+#ifdef HAVE_WATCH
+            watch_flag = 1;
+#else
+            fprintf(stderr, "--watch is not supported on this platform.\n");
+            exit(1);
+#endif
+        }
         else if (i < argc) {
             /* If there are other args left, regard them as file names */
 
             path_count = argc - i;
-            file_paths = (char**) malloc(path_count * sizeof(char*));
+            file_paths = argv + i;
+            break;
+        } else {
+            usage(stderr, argv[0]);
+            exit(1);
+        }
+    }
 
-            if (file_paths == NULL)
-            {
-                perror("Unable to allocate memory");
-                exit(2);
-            }
+    if (server_flag) {
+        server*         s;
 
-            for (; i < argc; ++i)
-                file_paths[path_count + i - argc] = xstrdup(argv[i]);
-        } else {
+        if (file_paths || walk_count > 0 || p->property_count > 0 ||
+                watch_flag || p->is_grouping) {
             usage(stderr, argv[0]);
             exit(1);
         }
+
+#ifdef WIN32
+        /* the lengths of the frames count the bytes as they are sent */
+        _setmode(_fileno(stdin), _O_BINARY);
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+
+        s = server_init(conf_filename,
+                version_major, version_minor, version_patch);
+        if (s == NULL) {
+            perror("Unable to allocate memory");
+            exit(2);
+        }
+        exit_status = server_run(s, stdin, stdout);
+        server_destroy(s);
+        exit(exit_status);
     }
 
-    if (!file_paths) { /* No filename is set */ 
+#ifdef HAVE_WALK
+    if (compile_root != NULL) {
+        if (file_paths || walk_count > 0 || p->property_count > 0 ||
+                watch_flag || p->is_grouping) {
+            usage(stderr, argv[0]);
+            exit(1);
+        }
+        exit(compile_index(compile_root, index_output, conf_filename,
+                    excludes, exclude_count));
+    }
+#endif
+
+    /* the files printed again with --watch cannot be grouped */
+    if ((!file_paths && walk_count == 0) || (watch_flag && p->is_grouping)) {
         usage(stderr, argv[0]);
         exit(1);
     }
 
-    /* Go through all the files in the argument list */
-    for (i = 0; i < path_count; ++i) {
+    /* the entries of the files are gathered until the tables of the sets are
+     * complete */
+    if (p->groups.is_binary) {
+#ifdef WIN32
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+        p->out.redirect = &p->groups.file_table;
+    }
 
-        int             j;
+    /* Initialize the EditorConfig handle, which is used for all the files so
+     * that the EditorConfig files they share are only parsed once */
+    p->eh = editorconfig_handle_init();
 
-        full_filename = file_paths[i];
+    if (p->eh == NULL)
+    {
+        perror("Unable to create EditorConfig handle");
+        exit(3);
+    }
 
-        /* Print the file path first, with [], if more than one file is
-         * specified */
-        if (path_count > 1 && strcmp(full_filename, "-"))
-            printf("[%s]\n", full_filename);
+    /* Set conf file name */
+    if (conf_filename)
+        editorconfig_handle_set_conf_file_name(p->eh, conf_filename);
 
-        if (!strcmp(full_filename, "-")) {
-            size_t          len;
+    /* Set the version to be compatible with */
+    editorconfig_handle_set_version(p->eh,
+            version_major, version_minor, version_patch);
 
-            /* Read a line from stdin. If EOF encountered, continue */
-            if (!fgets(file_line_buffer, FILENAME_MAX + 1, stdin)) {
-                if (!feof(stdin))
-                    perror("Failed to read stdin");
+    /* The cache is only an optimization, so it is skipped where it cannot be
+     * used */
+    if (cache_flag &&
+            editorconfig_handle_set_persistent_cache(p->eh, 1, NULL) ==
+            EDITORCONFIG_PARSE_MEMORY_ERROR) {
+        perror("Unable to allocate memory");
+        exit(2);
+    }
 
-                free(full_filename);
-                continue;
-            }
+#ifdef HAVE_WALK
+    /* Like the cache, the index is skipped where it cannot be used */
+    if (index_path != NULL) {
+        char*           full_index_path = full_path(index_path);
 
-            -- i;
+        if (full_index_path == NULL)
+            exit(1);
+        if (editorconfig_handle_set_index(p->eh, full_index_path) ==
+                EDITORCONFIG_PARSE_MEMORY_ERROR) {
+            perror("Unable to allocate memory");
+            exit(2);
+        }
+        free(full_index_path);
+    }
+#endif
 
-            /* trim the trailing space characters */
-            len = strlen(file_line_buffer);
-            while (len > 0 && isspace(file_line_buffer[len - 1]))
-                -- len;
-            if (len == 0) /* we meet a blank line */
-                continue;
-            file_line_buffer[len] = '\0';
+#ifdef HAVE_WATCH
+    /* The changes are only seen in process */
+    if (watch_flag) {
+        if (editorconfig_handle_set_watch(p->eh, 1) != 0) {
+            perror("Unable to watch the EditorConfig files");
+            exit(1);
+        }
+        p->is_watching = 1;
+        daemon_flag = 0;
+    }
+#endif
 
-            full_filename = file_line_buffer;
-            while (isspace(*full_filename))
-                ++ full_filename;
+    if (daemon_flag)
+        daemon_connect(p, conf_filename, version_major, version_minor,
+                version_patch);
 
-            full_filename = xstrdup(full_filename);
+    /* Go through all the files in the argument list */
+    for (i = 0; i < path_count; ++i) {
 
-            printf("[%s]\n", full_filename);
-        }
+        const char*     full_filename = file_paths[i];
+        char*           path;
 
-        /* Initialize the EditorConfig handle */
-        eh = editorconfig_handle_init();
+        /* The files given one after the other are resolved by windows, like
+         * the paths of stdin, unless a single file is given without a
+         * section, or they are watched or sent to the daemon */
+        if (strcmp(full_filename, "-") && !watch_flag &&
+                p->daemon_client == NULL &&
+                (path_count > 1 || p->is_grouping)) {
+            int         count = 0;
 
-        if (eh == NULL)
-        {
-            perror("Unable to create EditorConfig handle");
-            exit(3);
+            while (i < path_count && strcmp(file_paths[i], "-") &&
+                    count < WINDOW_SIZE)
+                add_window_path(p, file_paths[i ++], count ++);
+            -- i;
+
+            if (print_window_paths(p, count, 1) != 0)
+                exit_status = 1;
+            continue;
         }
 
-        /* Set conf file name */
-        if (conf_filename)
-            editorconfig_handle_set_conf_file_name(eh, conf_filename);
+        if (strcmp(full_filename, "-")) {
+            /* The watched files are all printed as sections, since those
+             * printed again must be told apart, and the grouped files all
+             * have their entry */
+            if (watch_flag || p->is_grouping) {
+                if (print_section(p, full_filename) != 0)
+                    exit_status = 1;
+                continue;
+            }
 
-        /* Set the version to be compatible with */
-        editorconfig_handle_set_version(eh,
-                version_major, version_minor, version_patch);
+            /* Print the file path first, with [], if more than one file is
+             * specified */
+            if (path_count > 1) {
+                output_write(&p->out, "[", 1);
+                output_puts(&p->out, full_filename);
+                output_write(&p->out, "]\n", 2);
+            }
 
-        /* parsing the editorconfig files */
-        err_num = editorconfig_parse(full_filename, eh);
-        free(full_filename);
-
-        if (err_num != 0) {
-            /* print error message */
-            fputs(editorconfig_get_error_msg(err_num), stderr);
-            if (err_num > 0)
-                fprintf(stderr, ":%d \"%s\"", err_num,
-                        editorconfig_handle_get_err_file(eh));
-            fprintf(stderr, "\n");
-            exit(1);
+            err_num = print_properties(p, full_filename);
+            if (err_num != 0)
+                parse_error(p, err_num);
+            continue;
         }
 
-        /* print the result */
-        name_value_count = editorconfig_handle_get_name_value_count(eh);
-        for (j = 0; j < name_value_count; ++j) {
-            const char*         name;
-            const char*         value;
+        /* Go through the paths read from stdin, which do not stop at the
+         * first error */
+        while ((path = read_path(&stdin_paths)) != NULL) {
+            path = trim_path(&stdin_paths, path);
+            if (*path == '\0') /* we meet a blank line */
+                continue;
 
-            editorconfig_handle_get_name_value(eh, j, &name, &value);
-            printf("%s=%s\n", name, value);
-        }
+            /* the watched files are cached anyway, and the daemon keeps its
+             * own cache */
+            if (watch_flag || p->daemon_client != NULL) {
+                if (print_section(p, path) != 0)
+                    exit_status = 1;
+                continue;
+            }
 
-        if (editorconfig_handle_destroy(eh) != 0) {
-            fprintf(stderr, "Failed to destroy editorconfig_handle.\n");
-            exit(1);
+            if (print_window(p, path, &stdin_paths) != 0)
+                exit_status = 1;
         }
     }
 
-    free(file_paths);
+#ifdef HAVE_WALK
+    /* The directory cache makes the walk faster in process than through the
+     * daemon */
+    client_close(p->daemon_client);
+    p->daemon_client = NULL;
+
+    /* Each directory only needs the EditorConfig files of its parent and its
+     * own one, if any, and the watched directories are cached anyway */
+    if (walk_count > 0 && !watch_flag)
+        editorconfig_handle_set_directory_cache(p->eh, 1);
+    for (i = 0; i < walk_count; ++i)
+        if (walk(walk_dirs[i], excludes, exclude_count, print_walked_file,
+                    p) != 0)
+            exit_status = 1;
+#endif
+
+#ifdef HAVE_WATCH
+    if (watch_flag)
+        watch(p);
+#endif
+
+    output_flush(&p->out);
+    if (p->groups.is_binary) {
+        group_write_binary(&p->groups, &p->out);
+        output_flush(&p->out);
+    }
+    if (fflush(stdout) != 0) {
+        perror("Failed to write stdout");
+        exit(1);
+    }
+
+    if (editorconfig_handle_destroy(p->eh) != 0) {
+        fprintf(stderr, "Failed to destroy editorconfig_handle.\n");
+        exit(1);
+    }
+
+    client_close(p->daemon_client);
+    free(p->daemon_options);
+    free(p->daemon_request);
+    output_destroy(&p->out);
+    group_destroy(&p->groups);
+    free(stdin_paths.buffer);
+    for (i = 0; i < p->property_count; ++i)
+        free((char*) p->properties[i]);
+    free(p->properties);
+    free(walk_dirs);
+    free(excludes);
 
-    exit(0);
+    exit(exit_status);
 }
 
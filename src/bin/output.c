@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "output.h"
+
+/*
+ * See header file
+ */
+void buffer_append(byte_buffer* b, const void* s, size_t len)
+{
+    /* data is NULL until something is added */
+    if (len == 0)
+        return;
+    if (b->size + len > b->capacity) {
+        char*       new_data;
+
+        b->capacity = (b->size + len) * 2;
+        new_data = (char*) realloc(b->data, b->capacity);
+        if (new_data == NULL) {
+            perror("Unable to allocate memory");
+            exit(2);
+        }
+        b->data = new_data;
+    }
+    memcpy(b->data + b->size, s, len);
+    b->size += len;
+}
+
+static void output_sink(output* out, const char* s, size_t len)
+{
+    if (out->redirect != NULL) {
+        buffer_append(out->redirect, s, len);
+        return;
+    }
+    if (fwrite(s, 1, len, stdout) != len) {
+        perror("Failed to write stdout");
+        exit(1);
+    }
+}
+
+/*
+ * See header file
+ */
+void output_flush(output* out)
+{
+    if (out->size > 0)
+        output_sink(out, out->buffer, out->size);
+    out->size = 0;
+}
+
+void output_write(output* out, const char* s, size_t len)
+{
+    if (out->is_capturing) {
+        buffer_append(&out->capture, s, len);
+        return;
+    }
+    if (len > IO_BUFFER_SIZE - out->size) {
+        output_flush(out);
+        if (len > IO_BUFFER_SIZE) {
+            output_sink(out, s, len);
+            return;
+        }
+    }
+    memcpy(out->buffer + out->size, s, len);
+    out->size += len;
+}
+
+void output_puts(output* out, const char* s)
+{
+    output_write(out, s, strlen(s));
+}
+
+/*
+ * See header file
+ */
+void output_destroy(output* out)
+{
+    free(out->capture.data);
+    out->capture.data = NULL;
+    out->capture.size = out->capture.capacity = 0;
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OUTPUT_H__
+#define OUTPUT_H__
+
+#include <stddef.h>
+
+/* Size of the buffers of stdin and stdout */
+#define IO_BUFFER_SIZE      (64 * 1024)
+
+/*
+ * A growing block of memory.
+ */
+typedef struct
+{
+    char*               data;
+    size_t              size;
+    size_t              capacity;
+} byte_buffer;
+
+/*
+ * The output of the editorconfig command. It is gathered in a large buffer and
+ * written with fwrite(), which is much cheaper than a printf() for each line
+ * when many files are processed.
+ */
+typedef struct
+{
+    char                buffer[IO_BUFFER_SIZE];
+    size_t              size;
+    /* If not NULL, the output is gathered there instead of being written to
+     * stdout */
+    byte_buffer*        redirect;
+    /* If set, the output is added to capture instead of being buffered, so
+     * that it can be printed later or compared with an earlier output */
+    _Bool               is_capturing;
+    byte_buffer         capture;
+} output;
+
+/*
+ * Appends the len bytes at s to b, and exits if it cannot grow.
+ */
+void buffer_append(byte_buffer* b, const void* s, size_t len);
+
+/*
+ * Writes the buffered output to stdout, or to out->redirect if it is set, and
+ * exits if it cannot be written.
+ */
+void output_flush(output* out);
+
+void output_write(output* out, const char* s, size_t len);
+
+void output_puts(output* out, const char* s);
+
+/*
+ * Frees the capture of out. The buffered output must have been flushed.
+ */
+void output_destroy(output* out);
+
+#endif /* !OUTPUT_H__ */
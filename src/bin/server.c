@@ -0,0 +1,714 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * The requests and the responses of the server are frames made of the decimal
+ * length of their payload in bytes, a newline and the payload. The payload of
+ * a request is made of lines of the form NAME=VALUE:
+ *
+ *   file=PATH          the full path of the file, required
+ *   conf=NAME          the name of the EditorConfig files, if it is not the
+ *                      one given with -f or ".editorconfig"
+ *   version=X.Y.Z      the version to be compatible with, if it is not the one
+ *                      given with -b
+ *   property=NAME      only return the property NAME, can be repeated
+ *
+ * The other lines are ignored. The payload of a response is made of the
+ * NAME=VALUE lines of the properties of the file, or of a single line starting
+ * with ";" describing the error, as printed for the paths read from stdin.
+ *
+ * There is a handle for each EditorConfig file name, whose directory cache
+ * spares reading the EditorConfig files for each request. Where the library
+ * can watch the directories, it removes the directories whose EditorConfig
+ * files changed from the cache itself. Otherwise, before a file is parsed, the
+ * EditorConfig files that might apply to it are checked with stat(), and the
+ * directory cache is emptied if any of them was created, modified or removed
+ * since it was last checked.
+ */
+
+#include "config.h"
+#include <ctype.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <editorconfig/editorconfig.h>
+
+#include "server.h"
+#include "util.h"
+
+/*
+ * What stat() tells about an EditorConfig file, which changes when the file
+ * changes. A missing file has a signature too, so that its creation is seen.
+ */
+typedef struct
+{
+    _Bool               exists;
+    dev_t               dev;
+    ino_t               ino;
+    off_t               size;
+    time_t              mtime;
+    long                mtime_nsec;
+    time_t              ctime;
+    long                ctime_nsec;
+} file_signature;
+
+/*
+ * An EditorConfig file checked by a handle. It is allocated as a single block
+ * holding the path.
+ */
+typedef struct conf_file
+{
+    struct conf_file*   next;
+    uint64_t            hash;
+    file_signature      sig;
+    char*               path;
+} conf_file;
+
+/*
+ * The handle used for the requests with the same EditorConfig file name.
+ */
+typedef struct server_handle
+{
+    struct server_handle*   next;
+    /* NULL for the default name */
+    char*                   conf_file_name;
+    editorconfig_handle     eh;
+    /* whether eh watches the directories, so that no file is checked */
+    _Bool                   is_watching;
+    /* the EditorConfig files checked, in a hash table */
+    conf_file**             buckets;
+    size_t                  bucket_count;
+    size_t                  count;
+} server_handle;
+
+struct server
+{
+    char*               conf_file_name;
+    int                 version[3];
+    server_handle*      handles;
+
+    /* the properties of the current request */
+    const char**        properties;
+    int                 property_count;
+    int                 property_capacity;
+
+    /* the path of the EditorConfig file being checked */
+    char*               path;
+    size_t              path_capacity;
+
+    char*               response;
+    size_t              response_size;
+    size_t              response_capacity;
+
+    /* the payload of the request read by server_run() */
+    char*               request;
+    size_t              request_capacity;
+
+    /* set when the memory of the current request cannot be allocated */
+    _Bool               is_out_of_memory;
+};
+
+/*
+ * Makes buffer hold at least size bytes. Returns 0 on success, -1 if the
+ * memory cannot be allocated.
+ */
+static int reserve(char** buffer, size_t* capacity, size_t size)
+{
+    char*               new_buffer;
+    size_t              new_capacity;
+
+    if (size <= *capacity)
+        return 0;
+
+    new_capacity = *capacity ? *capacity : 256;
+    while (new_capacity < size)
+        new_capacity *= 2;
+    new_buffer = (char*) realloc(*buffer, new_capacity);
+    if (new_buffer == NULL)
+        return -1;
+    *buffer = new_buffer;
+    *capacity = new_capacity;
+
+    return 0;
+}
+
+static void response_write(server* s, const char* str, size_t len)
+{
+    if (reserve(&s->response, &s->response_capacity,
+                s->response_size + len) != 0) {
+        s->is_out_of_memory = 1;
+        return;
+    }
+    memcpy(s->response + s->response_size, str, len);
+    s->response_size += len;
+}
+
+static void response_puts(server* s, const char* str)
+{
+    response_write(s, str, strlen(str));
+}
+
+static void response_property(server* s, const char* name, const char* value)
+{
+    response_puts(s, name);
+    response_write(s, "=", 1);
+    response_puts(s, value);
+    response_write(s, "\n", 1);
+}
+
+/*
+ * Replaces the response with the error returned by the parsing of a file.
+ */
+static void response_error(server* s, int err_num, editorconfig_handle eh)
+{
+    char                line[32];
+
+    s->response_size = 0;
+    response_puts(s, "; ");
+    response_puts(s, editorconfig_get_error_msg(err_num));
+    if (err_num > 0) {
+        sprintf(line, ":%d \"", err_num);
+        response_puts(s, line);
+        response_puts(s, editorconfig_handle_get_err_file(eh));
+        response_write(s, "\"", 1);
+    }
+    response_write(s, "\n", 1);
+}
+
+/*
+ * Replaces the response with an error in the request.
+ */
+static void response_invalid(server* s, const char* msg)
+{
+    s->response_size = 0;
+    response_puts(s, "; Invalid request: ");
+    response_puts(s, msg);
+    response_write(s, "\n", 1);
+}
+
+static void get_signature(const char* path, file_signature* sig)
+{
+    struct stat         st;
+
+    memset(sig, 0, sizeof(file_signature));
+    if (stat(path, &st) != 0)
+        return;
+
+    sig->exists = 1;
+    sig->dev = st.st_dev;
+    sig->ino = st.st_ino;
+    sig->size = st.st_size;
+    sig->mtime = st.st_mtime;
+    sig->ctime = st.st_ctime;
+#ifdef HAVE_STRUCT_STAT_ST_MTIM
+    sig->mtime_nsec = (long) st.st_mtim.tv_nsec;
+    sig->ctime_nsec = (long) st.st_ctim.tv_nsec;
+#endif
+}
+
+static _Bool signature_equal(const file_signature* a, const file_signature* b)
+{
+    return a->exists == b->exists && a->dev == b->dev && a->ino == b->ino &&
+        a->size == b->size && a->mtime == b->mtime &&
+        a->mtime_nsec == b->mtime_nsec && a->ctime == b->ctime &&
+        a->ctime_nsec == b->ctime_nsec;
+}
+
+static conf_file* find_conf_file(const server_handle* sh, const char* path,
+        uint64_t hash)
+{
+    conf_file*          cf;
+
+    if (sh->bucket_count == 0)
+        return NULL;
+
+    for (cf = sh->buckets[hash % sh->bucket_count]; cf != NULL; cf = cf->next)
+        if (cf->hash == hash && !strcmp(cf->path, path))
+            return cf;
+
+    return NULL;
+}
+
+/*
+ * Adds an EditorConfig file to the hash table of a handle. Returns 0 on
+ * success, -1 if the memory cannot be allocated.
+ */
+static int add_conf_file(server_handle* sh, const char* path,
+        uint64_t hash, const file_signature* sig)
+{
+    size_t              path_size = strlen(path) + 1;
+    conf_file*          cf;
+    size_t              bucket;
+
+    if (sh->count >= sh->bucket_count) {
+        conf_file**     new_buckets;
+        size_t          new_bucket_count;
+        size_t          i;
+
+        new_bucket_count = sh->bucket_count ? sh->bucket_count * 2 : 64;
+        new_buckets = (conf_file**) calloc(new_bucket_count,
+                sizeof(conf_file*));
+        if (new_buckets == NULL)
+            return -1;
+
+        for (i = 0; i < sh->bucket_count; ++i) {
+            conf_file*  c = sh->buckets[i];
+
+            while (c != NULL) {
+                conf_file*  next = c->next;
+
+                bucket = c->hash % new_bucket_count;
+                c->next = new_buckets[bucket];
+                new_buckets[bucket] = c;
+                c = next;
+            }
+        }
+        free(sh->buckets);
+        sh->buckets = new_buckets;
+        sh->bucket_count = new_bucket_count;
+    }
+
+    cf = (conf_file*) malloc(sizeof(conf_file) + path_size);
+    if (cf == NULL)
+        return -1;
+    cf->hash = hash;
+    cf->sig = *sig;
+    cf->path = (char*) (cf + 1);
+    memcpy(cf->path, path, path_size);
+
+    bucket = hash % sh->bucket_count;
+    cf->next = sh->buckets[bucket];
+    sh->buckets[bucket] = cf;
+    ++ sh->count;
+
+    return 0;
+}
+
+/*
+ * Checks the EditorConfig files that might apply to file, in the same
+ * directories as the library, and empties the directory cache of the handle if
+ * any of them changed since it was last checked. They are checked before they
+ * are read, so that a change made while they are read is seen by the next
+ * request. A file that was never checked needs no emptying: the directory
+ * cache only holds the directories of the files of previous requests, whose
+ * EditorConfig files were all checked.
+ */
+static void check_conf_files(server* s, server_handle* sh, const char* file)
+{
+    const char*         name = sh->conf_file_name ? sh->conf_file_name :
+        ".editorconfig";
+    size_t              name_size = strlen(name) + 1;
+    const char*         slash;
+    _Bool               is_changed = 0;
+
+    if (reserve(&s->path, &s->path_capacity,
+                strlen(file) + name_size + 1) != 0) {
+        s->is_out_of_memory = 1;
+        return;
+    }
+
+    for (slash = strchr(file, '/'); slash != NULL;
+            slash = strchr(slash + 1, '/')) {
+        size_t          dir_len = (size_t) (slash - file);
+        uint64_t        hash;
+        file_signature  sig;
+        conf_file*      cf;
+
+        memcpy(s->path, file, dir_len);
+        s->path[dir_len] = '/';
+        memcpy(s->path + dir_len + 1, name, name_size);
+
+        get_signature(s->path, &sig);
+        hash = ec_fnv_hash(EC_FNV_HASH_INIT, s->path, strlen(s->path));
+        cf = find_conf_file(sh, s->path, hash);
+        if (cf == NULL) {
+            if (add_conf_file(sh, s->path, hash, &sig) != 0) {
+                s->is_out_of_memory = 1;
+                return;
+            }
+        } else if (!signature_equal(&cf->sig, &sig)) {
+            cf->sig = sig;
+            is_changed = 1;
+        }
+    }
+
+    if (is_changed) {
+        editorconfig_handle_set_directory_cache(sh->eh, 0);
+        editorconfig_handle_set_directory_cache(sh->eh, 1);
+    }
+}
+
+static void destroy_handle(server_handle* sh)
+{
+    size_t              i;
+
+    for (i = 0; i < sh->bucket_count; ++i) {
+        conf_file*      cf = sh->buckets[i];
+
+        while (cf != NULL) {
+            conf_file*  next = cf->next;
+
+            free(cf);
+            cf = next;
+        }
+    }
+    free(sh->buckets);
+    editorconfig_handle_destroy(sh->eh);
+    free(sh->conf_file_name);
+    free(sh);
+}
+
+/*
+ * Returns the handle for the EditorConfig file name, which is NULL for the
+ * default one, creating it if needed. Returns NULL if the memory cannot be
+ * allocated.
+ */
+static server_handle* get_handle(server* s, const char* conf_file_name)
+{
+    server_handle*      sh;
+
+    for (sh = s->handles; sh != NULL; sh = sh->next)
+        if (conf_file_name == NULL ? sh->conf_file_name == NULL :
+                sh->conf_file_name != NULL &&
+                !strcmp(sh->conf_file_name, conf_file_name))
+            return sh;
+
+    sh = (server_handle*) calloc(1, sizeof(server_handle));
+    if (sh == NULL)
+        return NULL;
+    sh->eh = editorconfig_handle_init();
+    if (conf_file_name != NULL)
+        sh->conf_file_name = strdup(conf_file_name);
+    if (sh->eh == NULL ||
+            (conf_file_name != NULL && sh->conf_file_name == NULL)) {
+        destroy_handle(sh);
+        return NULL;
+    }
+
+    /* the handle does not copy the name */
+    if (sh->conf_file_name != NULL)
+        editorconfig_handle_set_conf_file_name(sh->eh, sh->conf_file_name);
+    if (editorconfig_handle_set_watch(sh->eh, 1) == 0)
+        sh->is_watching = 1;
+    else
+        editorconfig_handle_set_directory_cache(sh->eh, 1);
+
+    sh->next = s->handles;
+    s->handles = sh;
+
+    return sh;
+}
+
+/*
+ * Parses a version of the form X.Y.Z, whose missing numbers are 0. Returns 0
+ * on success, -1 if the version is invalid.
+ */
+static int parse_version(const char* str, int version[3])
+{
+    int                 i;
+
+    version[0] = version[1] = version[2] = 0;
+    for (i = 0; i < 3; ++i) {
+        char*           end;
+        long            n = strtol(str, &end, 10);
+
+        if (end == str || n < 0 || n > INT_MAX)
+            return -1;
+        version[i] = (int) n;
+        if (*end == '\0')
+            return 0;
+        if (*end != '.')
+            return -1;
+        str = end + 1;
+    }
+
+    return -1;
+}
+
+/*
+ * Adds the properties of the request to the response, or the error of the
+ * parsing.
+ */
+static void respond_properties(server* s, const char* file,
+        editorconfig_handle eh)
+{
+    int                 err_num;
+    int                 count;
+    int                 i;
+
+    /* only look for the requested properties */
+    if (s->property_count > 0) {
+        for (i = 0; i < s->property_count; ++i) {
+            const char*     value;
+
+            err_num = editorconfig_get_property(file, eh, s->properties[i],
+                    &value);
+            if (err_num != 0) {
+                response_error(s, err_num, eh);
+                return;
+            }
+            if (value != NULL)
+                response_property(s, s->properties[i], value);
+        }
+        return;
+    }
+
+    err_num = editorconfig_parse(file, eh);
+    if (err_num != 0) {
+        response_error(s, err_num, eh);
+        return;
+    }
+
+    count = editorconfig_handle_get_name_value_count(eh);
+    for (i = 0; i < count; ++i) {
+        const char*     name;
+        const char*     value;
+
+        editorconfig_handle_get_name_value(eh, i, &name, &value);
+        response_property(s, name, value);
+    }
+}
+
+/*
+ * See header file
+ */
+server* server_init(const char* conf_file_name, int version_major,
+        int version_minor, int version_patch)
+{
+    server*             s = (server*) calloc(1, sizeof(server));
+
+    if (s == NULL)
+        return NULL;
+
+    if (conf_file_name != NULL) {
+        s->conf_file_name = strdup(conf_file_name);
+        if (s->conf_file_name == NULL) {
+            free(s);
+            return NULL;
+        }
+    }
+
+    /* 0.0.0 stands for the current version */
+    s->version[0] = version_major > 0 ? version_major : 0;
+    s->version[1] = version_minor > 0 ? version_minor : 0;
+    s->version[2] = version_patch > 0 ? version_patch : 0;
+
+    return s;
+}
+
+/*
+ * See header file
+ */
+int server_respond(server* s, char* payload, size_t payload_size,
+        const char** response, size_t* response_size)
+{
+    char*               line = payload;
+    char*               end = payload + payload_size;
+    const char*         file = NULL;
+    const char*         conf_file_name = s->conf_file_name;
+    const char*         version_str = NULL;
+    int                 version[3];
+    server_handle*      sh;
+
+    s->response_size = 0;
+    s->property_count = 0;
+    s->is_out_of_memory = 0;
+
+    /* split the payload into lines */
+    *end = '\0';
+    while (line < end) {
+        char*           eol = (char*) memchr(line, '\n', (size_t) (end - line));
+        char*           value;
+
+        if (eol == NULL)
+            eol = end;
+        *eol = '\0';
+
+        value = strchr(line, '=');
+        if (value != NULL) {
+            *value++ = '\0';
+            if (!strcmp(line, "file"))
+                file = value;
+            else if (!strcmp(line, "conf"))
+                conf_file_name = *value ? value : s->conf_file_name;
+            else if (!strcmp(line, "version"))
+                version_str = value;
+            else if (!strcmp(line, "property")) {
+                if (s->property_count == s->property_capacity) {
+                    int             new_capacity = s->property_capacity ?
+                        s->property_capacity * 2 : 8;
+                    const char**    new_properties = (const char**) realloc(
+                            (void*) s->properties,
+                            new_capacity * sizeof(char*));
+
+                    if (new_properties == NULL)
+                        return -2;
+                    s->properties = new_properties;
+                    s->property_capacity = new_capacity;
+                }
+                s->properties[s->property_count ++] = ec_lowercase(value);
+            }
+        }
+
+        line = eol + 1;
+    }
+
+    if (file == NULL || *file == '\0')
+        response_invalid(s, "no file");
+    else if (version_str != NULL && parse_version(version_str, version) != 0)
+        response_invalid(s, "invalid version");
+    else if ((sh = get_handle(s, conf_file_name)) == NULL)
+        return -2;
+    else {
+        if (version_str == NULL)
+            memcpy(version, s->version, sizeof(version));
+        editorconfig_handle_set_version(sh->eh,
+                version[0], version[1], version[2]);
+
+        if (!sh->is_watching)
+            check_conf_files(s, sh, file);
+        if (!s->is_out_of_memory)
+            respond_properties(s, file, sh->eh);
+    }
+
+    if (s->is_out_of_memory)
+        return -2;
+
+    *response = s->response;
+    *response_size = s->response_size;
+
+    return 0;
+}
+
+/*
+ * See header file
+ */
+int parse_frame_header(const char* data, size_t size, size_t max_size,
+        size_t* header_size, size_t* payload_size)
+{
+    size_t              n = 0;
+    size_t              i;
+
+    for (i = 0; i < size && data[i] >= '0' && data[i] <= '9'; ++i) {
+        n = n * 10 + (size_t) (data[i] - '0');
+        if (n > max_size)
+            return -1;
+    }
+    if (i == size)
+        return i < 20 ? 0 : -1;
+    if (i == 0 || data[i] != '\n')
+        return -1;
+
+    *header_size = i + 1;
+    *payload_size = n;
+
+    return 1;
+}
+
+/*
+ * See header file
+ */
+int server_run(server* s, FILE* in, FILE* out)
+{
+    for (;;) {
+        size_t          size = 0;
+        int             digit_count = 0;
+        int             c;
+        const char*     response;
+        size_t          response_size;
+
+        /* the length of the payload */
+        c = getc(in);
+        if (c == EOF) {
+            if (ferror(in)) {
+                perror("Failed to read the requests");
+                return 1;
+            }
+            return 0;
+        }
+        while (c >= '0' && c <= '9' && size <= SERVER_MAX_REQUEST_SIZE) {
+            size = size * 10 + (size_t) (c - '0');
+            ++ digit_count;
+            c = getc(in);
+        }
+        if (digit_count == 0 || c != '\n' || size > SERVER_MAX_REQUEST_SIZE) {
+            fprintf(stderr, "Invalid request frame.\n");
+            return 1;
+        }
+
+        if (reserve(&s->request, &s->request_capacity, size + 1) != 0) {
+            perror("Unable to allocate memory");
+            return 1;
+        }
+        if (fread(s->request, 1, size, in) != size) {
+            if (ferror(in))
+                perror("Failed to read the requests");
+            else
+                fprintf(stderr, "Truncated request.\n");
+            return 1;
+        }
+
+        if (server_respond(s, s->request, size, &response,
+                    &response_size) != 0) {
+            perror("Unable to allocate memory");
+            return 1;
+        }
+
+        if (fprintf(out, "%lu\n", (unsigned long) response_size) < 0 ||
+                fwrite(response, 1, response_size, out) != response_size ||
+                fflush(out) != 0) {
+            perror("Failed to write the response");
+            return 1;
+        }
+    }
+}
+
+/*
+ * See header file
+ */
+void server_destroy(server* s)
+{
+    if (s == NULL)
+        return;
+
+    while (s->handles != NULL) {
+        server_handle*  next = s->handles->next;
+
+        destroy_handle(s->handles);
+        s->handles = next;
+    }
+    free(s->conf_file_name);
+    free((void*) s->properties);
+    free(s->path);
+    free(s->response);
+    free(s->request);
+    free(s);
+}
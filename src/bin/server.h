@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SERVER_H__
+#define SERVER_H__
+
+#include <stddef.h>
+#include <stdio.h>
+
+/*
+ * The server of the --server option, which answers the requests of an editor
+ * with the same handles, so that the EditorConfig files are only read again
+ * when they change. See server.c for the format of the requests.
+ */
+typedef struct server server;
+
+/* The largest request payload accepted */
+#define SERVER_MAX_REQUEST_SIZE     (1024 * 1024)
+
+/*
+ * Parses the header of a frame at the beginning of the size bytes of data.
+ * Returns 1 and stores the sizes of the header and of the payload if it is
+ * complete, 0 if more bytes are needed, and -1 if it is invalid or announces
+ * a payload larger than max_size.
+ */
+int parse_frame_header(const char* data, size_t size, size_t max_size,
+        size_t* header_size, size_t* payload_size);
+
+/*
+ * Creates a server. conf_file_name and version, whose numbers are -1 if they
+ * are not given, are used for the requests that do not give theirs. Returns
+ * NULL if the memory cannot be allocated.
+ */
+server* server_init(const char* conf_file_name, int version_major,
+        int version_minor, int version_patch);
+
+/*
+ * Answers the request payload of payload_size bytes, which is modified and
+ * must be followed by one more byte that can be written. The response payload is stored in *response and *response_size, and is valid
+ * until the next call. Returns 0 on success, -2 if the memory cannot be
+ * allocated.
+ */
+int server_respond(server* s, char* payload, size_t payload_size,
+        const char** response, size_t* response_size);
+
+/*
+ * Answers the requests read from in on out until the end of in. Returns 0 if
+ * in ends after a request, 1 otherwise.
+ */
+int server_run(server* s, FILE* in, FILE* out);
+
+void server_destroy(server* s);
+
+#endif /* !SERVER_H__ */
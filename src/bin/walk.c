@@ -0,0 +1,426 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <editorconfig/editorconfig.h>
+
+#include "walk.h"
+
+#ifdef HAVE_WALK
+# include <dirent.h>
+# include <errno.h>
+# include <fcntl.h>
+# include <fnmatch.h>
+# include <sys/stat.h>
+# include <unistd.h>
+
+/*
+ * Walks directory trees with openat() and readdir(), which reads the entries
+ * of a directory in large blocks with getdents64() on Linux.
+ */
+typedef struct
+{
+    walk_callback       print_file;
+    void*               data;
+    const char**        excludes;
+    int                 exclude_count;
+    /* if not NULL, the files with this name are collected in conf_files
+     * instead of all the files being printed */
+    const char*         conf_name;
+    char**              conf_files;
+    int                 conf_count;
+    int                 conf_capacity;
+    /* the path of the current file or directory, without a trailing slash */
+    char*               path;
+    size_t              path_len;
+    size_t              path_capacity;
+    int                 exit_status;
+} tree_walker;
+
+/*
+ * Sets the path of the walker to its first len characters followed by name,
+ * after a slash if name is not NULL.
+ */
+static void walker_set_path(tree_walker* w, size_t len, const char* name)
+{
+    size_t              name_len = name ? strlen(name) + 1 : 0;
+
+    if (len + name_len + 1 > w->path_capacity) {
+        char*           new_path;
+
+        w->path_capacity = (len + name_len + 1) * 2;
+        new_path = (char*) realloc(w->path, w->path_capacity);
+        if (new_path == NULL) {
+            perror("Unable to allocate memory");
+            exit(2);
+        }
+        w->path = new_path;
+    }
+
+    if (name != NULL) {
+        w->path[len] = '/';
+        memcpy(w->path + len + 1, name, name_len);
+    }
+    w->path_len = len + name_len;
+    w->path[w->path_len] = '\0';
+}
+
+static void walker_error(tree_walker* w, const char* action)
+{
+    fprintf(stderr, "Failed to %s \"%s\": %s\n", action, w->path,
+            strerror(errno));
+    w->exit_status = 1;
+}
+
+/*
+ * Adds a copy of the path of the walker to its EditorConfig files.
+ */
+static void walker_add_conf_file(tree_walker* w)
+{
+    if (w->conf_count == w->conf_capacity) {
+        char**          new_files;
+
+        w->conf_capacity = w->conf_capacity ? w->conf_capacity * 2 : 64;
+        new_files = (char**) realloc(w->conf_files,
+                w->conf_capacity * sizeof(char*));
+        if (new_files == NULL) {
+            perror("Unable to allocate memory");
+            exit(2);
+        }
+        w->conf_files = new_files;
+    }
+
+    w->conf_files[w->conf_count] = strdup(w->path);
+    if (w->conf_files[w->conf_count] == NULL) {
+        perror("Unable to allocate memory");
+        exit(2);
+    }
+    ++ w->conf_count;
+}
+
+static int compare_entries(const void* a, const void* b)
+{
+    /* the first character of an entry is its type */
+    return strcmp(*(char* const*) a + 1, *(char* const*) b + 1);
+}
+
+/*
+ * Calls print_file for or collects the files of the directory open as dir_fd,
+ * whose path is the path of the walker, and of its subdirectories, in the
+ * order of their names. Closes dir_fd.
+ */
+static void walk_dir(tree_walker* w, int dir_fd)
+{
+    DIR*                dir = fdopendir(dir_fd);
+    struct dirent*      entry;
+    /* the entries of the directory, each made of its type and its name */
+    char*               names = NULL;
+    size_t              names_size = 0;
+    size_t              names_capacity = 0;
+    char**              entries;
+    size_t              entry_count = 0;
+    size_t              dir_len = w->path_len;
+    size_t              i;
+
+    if (dir == NULL) {
+        walker_error(w, "open directory");
+        close(dir_fd);
+        return;
+    }
+
+    /* read the whole directory first, so that the files are sorted and only
+     * one descriptor per level is open */
+    errno = 0;
+    while ((entry = readdir(dir)) != NULL) {
+        size_t          len = strlen(entry->d_name) + 2;
+        int             j;
+
+        if (!strcmp(entry->d_name, ".") || !strcmp(entry->d_name, ".."))
+            continue;
+        for (j = 0; j < w->exclude_count; ++j)
+            if (fnmatch(w->excludes[j], entry->d_name, 0) == 0)
+                break;
+        if (j < w->exclude_count)
+            continue;
+
+        if (names_size + len > names_capacity) {
+            char*       new_names;
+
+            names_capacity = names_capacity ? names_capacity * 2 : 4096;
+            if (names_capacity < names_size + len)
+                names_capacity = names_size + len;
+            new_names = (char*) realloc(names, names_capacity);
+            if (new_names == NULL) {
+                perror("Unable to allocate memory");
+                exit(2);
+            }
+            names = new_names;
+        }
+        names[names_size] = (char) entry->d_type;
+        memcpy(names + names_size + 1, entry->d_name, len - 1);
+        names_size += len;
+        ++ entry_count;
+    }
+    if (errno != 0)
+        walker_error(w, "read directory");
+
+    entries = (char**) malloc((entry_count ? entry_count : 1) *
+            sizeof(char*));
+    if (entries == NULL) {
+        perror("Unable to allocate memory");
+        exit(2);
+    }
+    for (i = 0; i < entry_count; ++i)
+        entries[i] = i ? entries[i - 1] + strlen(entries[i - 1] + 1) + 2 :
+            names;
+    qsort(entries, entry_count, sizeof(char*), compare_entries);
+
+    for (i = 0; i < entry_count; ++i) {
+        const char*     name = entries[i] + 1;
+        unsigned char   type = (unsigned char) entries[i][0];
+        struct stat     st;
+
+        walker_set_path(w, dir_len, name);
+
+        /* links to directories are not followed, to avoid cycles */
+        if (type == DT_UNKNOWN || type == DT_LNK) {
+            if (fstatat(dirfd(dir), name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+                walker_error(w, "stat");
+                continue;
+            }
+            if (S_ISDIR(st.st_mode))
+                type = DT_DIR;
+            else if (S_ISLNK(st.st_mode) &&
+                    fstatat(dirfd(dir), name, &st, 0) == 0 &&
+                    S_ISREG(st.st_mode))
+                type = DT_REG;
+            else if (S_ISREG(st.st_mode))
+                type = DT_REG;
+        }
+
+        if (type == DT_DIR) {
+            int         fd = openat(dirfd(dir), name,
+                    O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+
+            if (fd < 0)
+                walker_error(w, "open directory");
+            else
+                walk_dir(w, fd);
+        } else if (type == DT_REG) {
+            if (w->conf_name != NULL) {
+                if (strcmp(name, w->conf_name) == 0)
+                    walker_add_conf_file(w);
+            } else if (w->print_file(w->path, w->data) != 0)
+                w->exit_status = 1;
+        }
+    }
+
+    walker_set_path(w, dir_len, NULL);
+    free(entries);
+    free(names);
+    closedir(dir);
+}
+
+/*
+ * Sets the path of the walker to the full path of path, without the trailing
+ * slashes. Returns 1 if there is an error, 0 otherwise.
+ */
+static int walker_set_full_path(tree_walker* w, const char* path)
+{
+    size_t              len;
+
+    /* EditorConfig needs full paths */
+    if (path[0] != '/') {
+        char            cwd[FILENAME_MAX + 1];
+
+        if (getcwd(cwd, sizeof(cwd)) == NULL) {
+            perror("Failed to get the current directory");
+            return 1;
+        }
+        len = strlen(cwd);
+        while (len > 0 && cwd[len - 1] == '/')
+            -- len;
+        cwd[len] = '\0';
+        walker_set_path(w, 0, cwd[0] ? cwd + 1 : NULL);
+        if (strcmp(path, ".") != 0)
+            walker_set_path(w, w->path_len, path);
+    } else {
+        walker_set_path(w, 0, path + 1);
+    }
+
+    /* remove the trailing slashes, which leaves an empty path for / */
+    len = w->path_len;
+    while (len > 0 && w->path[len - 1] == '/')
+        -- len;
+    walker_set_path(w, len, NULL);
+
+    return 0;
+}
+
+/*
+ * Calls print_file for or collects the files of the directory tree root.
+ * Returns 1 if there is an error, 0 otherwise.
+ */
+static int walk_tree(tree_walker* w, const char* root)
+{
+    int                 fd;
+
+    if (walker_set_full_path(w, root) != 0)
+        return 1;
+
+    fd = open(w->path_len ? w->path : "/", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0)
+        walker_error(w, "open directory");
+    else
+        walk_dir(w, fd);
+
+    return w->exit_status;
+}
+
+/*
+ * See header file
+ */
+int walk(const char* root, const char** excludes, int exclude_count,
+        walk_callback print_file, void* data)
+{
+    tree_walker         w;
+    int                 exit_status;
+
+    memset(&w, 0, sizeof(w));
+    w.print_file = print_file;
+    w.data = data;
+    w.excludes = excludes;
+    w.exclude_count = exclude_count;
+
+    exit_status = walk_tree(&w, root);
+    free(w.path);
+
+    return exit_status;
+}
+
+/*
+ * See header file
+ */
+int compile_index(const char* root, const char* index_path,
+        const char* conf_name, const char** excludes, int exclude_count)
+{
+    tree_walker         w;
+    const char*         full_index_path;
+    int                 err_num;
+    int                 i;
+
+    memset(&w, 0, sizeof(w));
+    w.excludes = excludes;
+    w.exclude_count = exclude_count;
+    w.conf_name = conf_name ? conf_name : ".editorconfig";
+
+    /* a file which cannot be read would be missing from the index */
+    if (walk_tree(&w, root) != 0) {
+        err_num = 1;
+        goto cleanup;
+    }
+
+    if (index_path == NULL)
+        walker_set_path(&w, w.path_len, ".editorconfig.idx");
+    else if (walker_set_full_path(&w, index_path) != 0) {
+        err_num = 1;
+        goto cleanup;
+    }
+    full_index_path = w.path_len ? w.path : "/";
+
+    err_num = editorconfig_write_index(full_index_path,
+            (const char* const*) w.conf_files, w.conf_count);
+    if (err_num == EDITORCONFIG_PARSE_MEMORY_ERROR) {
+        perror("Unable to allocate memory");
+        exit(2);
+    } else if (err_num > 0) {
+        fprintf(stderr, "Failed to index \"%s\": it cannot be read or is "
+                "not in the directory of \"%s\".\n",
+                w.conf_files[err_num - 1], full_index_path);
+    } else if (err_num != 0) {
+        fprintf(stderr, "Failed to write the index \"%s\".\n",
+                full_index_path);
+    }
+
+cleanup:
+    for (i = 0; i < w.conf_count; ++i)
+        free(w.conf_files[i]);
+    free(w.conf_files);
+    free(w.path);
+
+    return err_num != 0;
+}
+
+/*
+ * See header file
+ */
+char* full_path(const char* path)
+{
+    tree_walker         w;
+
+    memset(&w, 0, sizeof(w));
+    if (walker_set_full_path(&w, path) != 0) {
+        free(w.path);
+        return NULL;
+    }
+
+    return w.path;
+}
+
+#else /* HAVE_WALK */
+
+int walk(const char* root, const char** excludes, int exclude_count,
+        walk_callback print_file, void* data)
+{
+    (void) root;
+    (void) excludes;
+    (void) exclude_count;
+    (void) print_file;
+    (void) data;
+    return 1;
+}
+
+int compile_index(const char* root, const char* index_path,
+        const char* conf_name, const char** excludes, int exclude_count)
+{
+    (void) root;
+    (void) index_path;
+    (void) conf_name;
+    (void) excludes;
+    (void) exclude_count;
+    return 1;
+}
+
+char* full_path(const char* path)
+{
+    (void) path;
+    return NULL;
+}
+
+#endif /* HAVE_WALK */
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef WALK_H__
+#define WALK_H__
+
+/* config.h must be included first */
+#if defined(HAVE_OPENAT) && defined(HAVE_FDOPENDIR) && defined(HAVE_FNMATCH)
+# define HAVE_WALK
+#endif
+
+/*
+ * Called by walk() with the full path of each file found. Returns 1 if there
+ * is an error with the file, 0 otherwise.
+ */
+typedef int (*walk_callback)(const char* path, void* data);
+
+/*
+ * Calls print_file for the files of the directory tree root, in the order of
+ * their names, skipping the files and directories whose name matches one of
+ * the glob patterns of excludes. Returns 1 if there is an error, 0 otherwise.
+ */
+int walk(const char* root, const char** excludes, int exclude_count,
+        walk_callback print_file, void* data);
+
+/*
+ * Writes the index of the EditorConfig files named conf_name, or
+ * ".editorconfig" if it is NULL, in the directory tree root to index_path, or
+ * to .editorconfig.idx in root if it is NULL. Returns 1 if there is an error,
+ * 0 otherwise.
+ */
+int compile_index(const char* root, const char* index_path,
+        const char* conf_name, const char** excludes, int exclude_count);
+
+/*
+ * Returns the full path of path, allocated with malloc(), or NULL if the
+ * current directory cannot be found.
+ */
+char* full_path(const char* path);
+
+#endif /* !WALK_H__ */
@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "global.h"
+
+#include <stdint.h>
+
+#include <editorconfig/editorconfig.h>
+
+#include "ec_alloc.h"
+#include "ec_glob.h"
+
+#ifdef EDITORCONFIG_FIXED_MEMORY
+/* Nothing is allocated until editorconfig_set_memory() or
+ * editorconfig_set_allocator() is called. */
+static void* default_malloc(size_t size, void* user)
+{
+    (void)size;
+    (void)user;
+    return NULL;
+}
+
+static void* default_realloc(void* ptr, size_t size, void* user)
+{
+    (void)ptr;
+    (void)size;
+    (void)user;
+    return NULL;
+}
+
+static void default_free(void* ptr, void* user)
+{
+    (void)ptr;
+    (void)user;
+}
+#else
+static void* default_malloc(size_t size, void* user)
+{
+    (void)user;
+    return malloc(size);
+}
+
+static void* default_realloc(void* ptr, size_t size, void* user)
+{
+    (void)user;
+    return realloc(ptr, size);
+}
+
+static void default_free(void* ptr, void* user)
+{
+    (void)user;
+    free(ptr);
+}
+#endif /* EDITORCONFIG_FIXED_MEMORY */
+
+static const editorconfig_allocator default_allocator = {
+    default_malloc, default_realloc, default_free, NULL
+};
+
+/* the allocator in use */
+static editorconfig_allocator allocator = {
+    default_malloc, default_realloc, default_free, NULL
+};
+
+/*
+ * The allocator of editorconfig_set_memory(). The memory is a sequence of
+ * chunks, each made of a header followed by the memory given out. The free
+ * chunks are also linked in a list, which is searched first fit, so that the
+ * search does not walk through the memory in use, such as the sections of a
+ * large file. A free chunk is merged with the free chunks that follow it when
+ * it is freed or searched.
+ */
+typedef union
+{
+    struct
+    {
+        /* size of the memory after the header */
+        size_t          size;
+        _Bool           is_used;
+    }                   h;
+
+    /* the types with the strictest alignment */
+    long double         ld;
+    long long           ll;
+    void*               p;
+    void                (*f)(void);
+} chunk_header;
+
+/* a free chunk, whose links are in the memory after the header */
+typedef struct free_chunk
+{
+    chunk_header        header;
+    struct free_chunk*  prev;
+    struct free_chunk*  next;
+} free_chunk;
+
+#define CHUNK_ALIGN(size) \
+    (((size) + sizeof(chunk_header) - 1) / sizeof(chunk_header) * \
+     sizeof(chunk_header))
+
+/* the smallest size of the memory after a header */
+#define CHUNK_MIN_SIZE \
+    CHUNK_ALIGN(sizeof(free_chunk) - sizeof(chunk_header))
+
+typedef struct
+{
+    unsigned char*      begin;
+    unsigned char*      end;
+    free_chunk*         free_list;
+} fixed_memory;
+
+static fixed_memory     memory_block;
+
+static chunk_header* next_chunk(chunk_header* chunk)
+{
+    return (chunk_header*)((unsigned char*)(chunk + 1) + chunk->h.size);
+}
+
+static void free_list_insert(fixed_memory* memory, chunk_header* chunk)
+{
+    free_chunk*     fc = (free_chunk*)chunk;
+
+    chunk->h.is_used = 0;
+    fc->prev = NULL;
+    fc->next = memory->free_list;
+    if (fc->next != NULL)
+        fc->next->prev = fc;
+    memory->free_list = fc;
+}
+
+static void free_list_remove(fixed_memory* memory, chunk_header* chunk)
+{
+    free_chunk*     fc = (free_chunk*)chunk;
+
+    if (fc->prev != NULL)
+        fc->prev->next = fc->next;
+    else
+        memory->free_list = fc->next;
+    if (fc->next != NULL)
+        fc->next->prev = fc->prev;
+}
+
+/* merge the free chunks that follow chunk into it */
+static void merge_free_chunks(fixed_memory* memory, chunk_header* chunk)
+{
+    chunk_header*   next;
+
+    while ((unsigned char*)(next = next_chunk(chunk)) < memory->end &&
+            !next->h.is_used) {
+        free_list_remove(memory, next);
+        chunk->h.size += sizeof(chunk_header) + next->h.size;
+    }
+}
+
+/* give the memory of chunk after size bytes back, if it is worth it */
+static void split_chunk(fixed_memory* memory, chunk_header* chunk,
+        size_t size)
+{
+    chunk_header*   rest;
+
+    if (chunk->h.size < size + sizeof(chunk_header) + CHUNK_MIN_SIZE)
+        return;
+
+    rest = (chunk_header*)((unsigned char*)(chunk + 1) + size);
+    rest->h.size = chunk->h.size - size - sizeof(chunk_header);
+    chunk->h.size = size;
+    free_list_insert(memory, rest);
+    merge_free_chunks(memory, rest);
+}
+
+static void* fixed_malloc(size_t size, void* user)
+{
+    fixed_memory*       memory = (fixed_memory*)user;
+    free_chunk*         fc;
+
+    if (size > (size_t)(memory->end - memory->begin))
+        return NULL;
+    size = size < CHUNK_MIN_SIZE ? CHUNK_MIN_SIZE : CHUNK_ALIGN(size);
+
+    for (fc = memory->free_list; fc != NULL; fc = fc->next) {
+        chunk_header*   chunk = &fc->header;
+
+        merge_free_chunks(memory, chunk);
+        if (chunk->h.size >= size) {
+            free_list_remove(memory, chunk);
+            chunk->h.is_used = 1;
+            split_chunk(memory, chunk, size);
+            return chunk + 1;
+        }
+    }
+
+    return NULL;
+}
+
+static void fixed_free(void* ptr, void* user)
+{
+    fixed_memory*       memory = (fixed_memory*)user;
+    chunk_header*       chunk = (chunk_header*)ptr - 1;
+
+    free_list_insert(memory, chunk);
+    merge_free_chunks(memory, chunk);
+}
+
+static void* fixed_realloc(void* ptr, size_t size, void* user)
+{
+    fixed_memory*       memory = (fixed_memory*)user;
+    chunk_header*       chunk = (chunk_header*)ptr - 1;
+    size_t              old_size = chunk->h.size;
+    void*               new_ptr;
+
+    if (size > (size_t)(memory->end - memory->begin))
+        return NULL;
+    size = size < CHUNK_MIN_SIZE ? CHUNK_MIN_SIZE : CHUNK_ALIGN(size);
+
+    /* grow in place if the chunk is followed by enough free memory */
+    merge_free_chunks(memory, chunk);
+    if (chunk->h.size >= size) {
+        split_chunk(memory, chunk, size);
+        return ptr;
+    }
+    split_chunk(memory, chunk, old_size);
+
+    new_ptr = fixed_malloc(size, user);
+    if (new_ptr == NULL)
+        return NULL;
+    memcpy(new_ptr, ptr, old_size);
+    fixed_free(ptr, user);
+
+    return new_ptr;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+void* ec_malloc(size_t size)
+{
+    return allocator.malloc_fn(size ? size : 1, allocator.user);
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+void* ec_calloc(size_t count, size_t size)
+{
+    void*       ptr;
+
+    if (size != 0 && count > (size_t)-1 / size)
+        return NULL;
+
+    ptr = ec_malloc(count * size);
+    if (ptr != NULL)
+        memset(ptr, 0, count * size);
+
+    return ptr;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+void* ec_realloc(void* ptr, size_t size)
+{
+    if (ptr == NULL)
+        return ec_malloc(size);
+
+    return allocator.realloc_fn(ptr, size ? size : 1, allocator.user);
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+void ec_free(void* ptr)
+{
+    if (ptr != NULL)
+        allocator.free_fn(ptr, allocator.user);
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+_Bool ec_alloc_is_thread_safe(void)
+{
+    return allocator.malloc_fn != fixed_malloc;
+}
+
+/*
+ * See the header file for the use of this function
+ */
+EDITORCONFIG_EXPORT
+int editorconfig_set_allocator(const editorconfig_allocator* new_allocator)
+{
+    /* the memory of PCRE2 comes from the current allocator */
+    ec_glob_set_allocator(0);
+
+    if (new_allocator == NULL) {
+        allocator = default_allocator;
+        return 0;
+    }
+
+    allocator = *new_allocator;
+    if (ec_glob_set_allocator(1) != 0) {
+        allocator = default_allocator;
+        return EDITORCONFIG_PARSE_MEMORY_ERROR;
+    }
+
+    return 0;
+}
+
+/*
+ * See the header file for the use of this function
+ */
+EDITORCONFIG_EXPORT
+int editorconfig_set_memory(void* memory, size_t size)
+{
+    editorconfig_allocator  fixed_allocator;
+    unsigned char*          begin = (unsigned char*)memory;
+    size_t                  misalignment;
+    chunk_header*           chunk;
+
+    /* the chunks start at an aligned address */
+    misalignment = (size_t)((uintptr_t)begin % sizeof(chunk_header));
+    if (misalignment != 0) {
+        if (size < sizeof(chunk_header) - misalignment)
+            return EDITORCONFIG_PARSE_MEMORY_ERROR;
+        begin += sizeof(chunk_header) - misalignment;
+        size -= sizeof(chunk_header) - misalignment;
+    }
+    size -= size % sizeof(chunk_header);
+    if (memory == NULL || size < sizeof(chunk_header) + CHUNK_MIN_SIZE)
+        return EDITORCONFIG_PARSE_MEMORY_ERROR;
+
+    ec_glob_set_allocator(0);
+    memory_block.begin = begin;
+    memory_block.end = begin + size;
+    memory_block.free_list = NULL;
+    chunk = (chunk_header*)begin;
+    chunk->h.size = size - sizeof(chunk_header);
+    free_list_insert(&memory_block, chunk);
+
+    fixed_allocator.malloc_fn = fixed_malloc;
+    fixed_allocator.realloc_fn = fixed_realloc;
+    fixed_allocator.free_fn = fixed_free;
+    fixed_allocator.user = &memory_block;
+
+    return editorconfig_set_allocator(&fixed_allocator);
+}
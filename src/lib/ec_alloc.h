@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EC_ALLOC_H__
+#define EC_ALLOC_H__
+
+#include "global.h"
+
+#include <stddef.h>
+
+/*
+ * Allocation functions of the library, which use the allocator set by
+ * editorconfig_set_allocator(). All the memory of the library must be
+ * allocated and freed with them.
+ */
+EDITORCONFIG_LOCAL
+void* ec_malloc(size_t size);
+
+/*
+ * Allocate count zeroed elements of size bytes.
+ */
+EDITORCONFIG_LOCAL
+void* ec_calloc(size_t count, size_t size);
+
+/*
+ * Same as realloc(). ptr may be NULL.
+ */
+EDITORCONFIG_LOCAL
+void* ec_realloc(void* ptr, size_t size);
+
+/*
+ * Same as free(). ptr may be NULL.
+ */
+EDITORCONFIG_LOCAL
+void ec_free(void* ptr);
+
+/*
+ * Whether the allocator in use may be called from several threads at once,
+ * which is not the case of the one of editorconfig_set_memory().
+ */
+EDITORCONFIG_LOCAL
+_Bool ec_alloc_is_thread_safe(void);
+
+#endif /* !EC_ALLOC_H__ */
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "global.h"
+
+#include "ec_alloc.h"
+#include "ec_arena.h"
+
+/* the smallest block allocated */
+#define ARENA_BLOCK_SIZE_MIN    4096
+
+/* a type with the strictest alignment */
+typedef union
+{
+    long double     ld;
+    long long       ll;
+    void*           p;
+    void            (*f)(void);
+} arena_align;
+
+#define ARENA_ALIGN(size) \
+    (((size) + sizeof(arena_align) - 1) / sizeof(arena_align) * \
+     sizeof(arena_align))
+
+struct ec_arena_block
+{
+    ec_arena_block*         next;
+    /* size of the memory after the header, and how much of it is used */
+    size_t                  size;
+    size_t                  used;
+};
+
+/* the memory of a block starts after the header, suitably aligned */
+#define ARENA_HEADER_SIZE       ARENA_ALIGN(sizeof(ec_arena_block))
+
+static ec_arena_block* arena_block_new(size_t size, ec_arena_block* next)
+{
+    ec_arena_block*     block;
+
+    block = (ec_arena_block*)ec_malloc(ARENA_HEADER_SIZE + size);
+    if (block == NULL)
+        return NULL;
+
+    block->next = next;
+    block->size = size;
+    block->used = 0;
+
+    return block;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+void* ec_arena_alloc(ec_arena* arena, size_t size)
+{
+    ec_arena_block*     block = arena->blocks;
+    void*               ptr;
+
+    size = ARENA_ALIGN(size);
+
+    if (block == NULL || block->size - block->used < size) {
+        size_t          block_size = ARENA_BLOCK_SIZE_MIN;
+
+        /* grow geometrically, so that the number of blocks stays small */
+        if (block != NULL && block_size < block->size * 2)
+            block_size = block->size * 2;
+        if (block_size < size)
+            block_size = size;
+
+        block = arena_block_new(block_size, arena->blocks);
+        if (block == NULL)
+            return NULL;
+        arena->blocks = block;
+    }
+
+    ptr = (char*)block + ARENA_HEADER_SIZE + block->used;
+    block->used += size;
+
+    return ptr;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+char* ec_arena_strndup(ec_arena* arena, const char* str, size_t len)
+{
+    char*       copy = (char*)ec_arena_alloc(arena, len + 1);
+
+    if (copy == NULL)
+        return NULL;
+
+    memcpy(copy, str, len);
+    copy[len] = '\0';
+
+    return copy;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+void ec_arena_reset(ec_arena* arena)
+{
+    ec_arena_block*     block = arena->blocks;
+    size_t              total_size = 0;
+
+    if (block == NULL)
+        return;
+
+    if (block->next == NULL) {
+        block->used = 0;
+        return;
+    }
+
+    /* replace the blocks with a single one */
+    for (; block != NULL; block = block->next)
+        total_size += block->size;
+    ec_arena_free(arena);
+    arena->blocks = arena_block_new(total_size, NULL);
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+void ec_arena_free(ec_arena* arena)
+{
+    ec_arena_block*     block = arena->blocks;
+
+    while (block != NULL) {
+        ec_arena_block*     next = block->next;
+
+        ec_free(block);
+        block = next;
+    }
+    arena->blocks = NULL;
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EC_ARENA_H__
+#define EC_ARENA_H__
+
+#include "global.h"
+
+#include <stddef.h>
+
+typedef struct ec_arena_block ec_arena_block;
+
+/*
+ * A bump allocator. Memory is allocated from large blocks and only given back
+ * all at once, by ec_arena_reset() or ec_arena_free(). A zeroed ec_arena is an
+ * empty arena.
+ */
+typedef struct ec_arena
+{
+    /* the block allocations are made from, followed by the older ones */
+    ec_arena_block*         blocks;
+} ec_arena;
+
+/*
+ * Allocate size bytes, suitably aligned for any type. Return NULL if an OOM
+ * occurs.
+ */
+EDITORCONFIG_LOCAL
+void* ec_arena_alloc(ec_arena* arena, size_t size);
+
+/*
+ * Copy the first len characters of str into the arena, followed by a null
+ * character. Return NULL if an OOM occurs.
+ */
+EDITORCONFIG_LOCAL
+char* ec_arena_strndup(ec_arena* arena, const char* str, size_t len);
+
+/*
+ * Release everything allocated from the arena, but keep its memory for the
+ * next allocations. If the arena had to grow since the last reset, its blocks
+ * are merged into one that is large enough for all of them, so an arena used
+ * the same way over and over stops allocating.
+ */
+EDITORCONFIG_LOCAL
+void ec_arena_reset(ec_arena* arena);
+
+/*
+ * Free all the memory of the arena. The arena may be used again afterwards.
+ */
+EDITORCONFIG_LOCAL
+void ec_arena_free(ec_arena* arena);
+
+#endif /* !EC_ARENA_H__ */
@@ -0,0 +1,979 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "global.h"
+#include "misc.h"
+#include "ini.h"
+
+#include "ec_alloc.h"
+#include "ec_conf.h"
+
+/* The fixed memory build creates no thread, since creating a thread
+ * allocates memory */
+#if defined(HAVE_PTHREAD) && !defined(EDITORCONFIG_FIXED_MEMORY)
+# define PARALLEL_PARSE
+# include <pthread.h>
+# include <unistd.h>
+#endif
+
+#ifdef EDITORCONFIG_FIXED_MEMORY
+# include <errno.h>
+# include <fcntl.h>
+# include <unistd.h>
+# define EC_CLOSE(file)     close(file)
+#else
+# define EC_CLOSE(file)     fclose(file)
+#endif
+
+/* The fewest files a cache holds before it is swept */
+#define CONF_CACHE_MIN_SWEEP_COUNT  64
+
+typedef struct
+{
+    ec_conf*                conf;
+    /* raw name of the last section, valid if conf->section_count > 0 */
+    char                    section_name[MAX_SECTION_NAME + 1];
+    /* set if the handler failed because of an OOM */
+    _Bool                   is_oom;
+} conf_parser;
+
+/*
+ * Free the properties of a section, but not the section itself.
+ */
+static void ec_conf_section_clear_properties(ec_conf_section* section)
+{
+    int         i;
+
+    for (i = 0; i < section->property_count; ++i) {
+        ec_free(section->properties[i].name);
+        ec_free(section->properties[i].value);
+    }
+    section->property_count = 0;
+}
+
+/*
+ * Free the sections of conf, but not conf itself.
+ */
+static void ec_conf_clear_sections(ec_conf* conf)
+{
+    int         i;
+
+    for (i = 0; i < conf->section_count; ++i) {
+        ec_conf_section_clear_properties(&conf->sections[i]);
+        ec_free(conf->sections[i].properties);
+        ec_free(conf->sections[i].pattern);
+        ec_glob_free(conf->sections[i].glob);
+    }
+    ec_free(conf->sections);
+    conf->sections = NULL;
+    conf->section_count = 0;
+    conf->max_section_count = 0;
+}
+
+static void ec_conf_free(ec_conf* conf)
+{
+    ec_conf_clear_sections(conf);
+    ec_free(conf->content);
+    ec_free(conf);
+}
+
+/*
+ * Append a new section to conf, with pattern as its pattern, which it then
+ * owns. Return NULL if an OOM occurs.
+ */
+static ec_conf_section* ec_conf_push_section(ec_conf* conf, char* pattern)
+{
+    ec_conf_section*    section;
+
+    if (conf->section_count >= conf->max_section_count) {
+        ec_conf_section*    new_sections;
+        int                 new_max_section_count;
+
+        new_max_section_count = conf->max_section_count ?
+            conf->max_section_count * 2 : 8;
+        new_sections = (ec_conf_section*)ec_realloc(conf->sections,
+                sizeof(ec_conf_section) * new_max_section_count);
+        if (new_sections == NULL)
+            return NULL;
+
+        conf->sections = new_sections;
+        conf->max_section_count = new_max_section_count;
+    }
+
+    section = &conf->sections[conf->section_count ++];
+    memset(section, 0, sizeof(ec_conf_section));
+    section->pattern = pattern;
+
+    return section;
+}
+
+/*
+ * Append a new section named section_name to conf. Return NULL if an OOM
+ * occurs.
+ */
+static ec_conf_section* ec_conf_add_section(ec_conf* conf,
+        const char* section_name)
+{
+    ec_conf_section*    section;
+    char*               pattern;
+
+    /* Pattern would be: [double_star]/[section] if section does not contain
+     * '/', or [section] if section starts with a '/', or /[section] if
+     * section contains '/' but does not start with '/'. */
+    pattern = (char*)ec_malloc(sizeof("**/") + strlen(section_name));
+    if (pattern == NULL)
+        return NULL;
+
+    if (strchr(section_name, '/') == NULL) /* No / is found, append '[star][star]/' */
+        strcpy(pattern, "**/");
+    else if (*section_name != '/') /* The first char is not '/' but section
+                                      contains '/', append a '/' */
+        strcpy(pattern, "/");
+    else
+        *pattern = '\0';
+
+    strcat(pattern, section_name);
+
+    section = ec_conf_push_section(conf, pattern);
+    if (section == NULL)
+        ec_free(pattern);
+
+    return section;
+}
+
+/*
+ * Append a name and value pair to section. Return -1 if an OOM occurs.
+ */
+static int ec_conf_section_add_property(ec_conf_section* section,
+        const char* name, const char* value)
+{
+    ec_conf_property*   property;
+
+    if (section->property_count >= section->max_property_count) {
+        ec_conf_property*   new_properties;
+        int                 new_max_property_count;
+
+        new_max_property_count = section->max_property_count ?
+            section->max_property_count * 2 : 4;
+        new_properties = (ec_conf_property*)ec_realloc(section->properties,
+                sizeof(ec_conf_property) * new_max_property_count);
+        if (new_properties == NULL)
+            return -1;
+
+        section->properties = new_properties;
+        section->max_property_count = new_max_property_count;
+    }
+
+    property = &section->properties[section->property_count];
+    property->name = ec_strdup(name);
+    property->value = ec_strdup(value);
+    if (property->name == NULL || property->value == NULL) {
+        ec_free(property->name);
+        ec_free(property->value);
+        return -1;
+    }
+    property->name_len = strlen(name);
+    property->value_len = strlen(value);
+
+    /* property names are case insensitive, and so are the values of some
+     * properties */
+    strlwr(property->name);
+    property->id = ec_property_lookup(property->name, property->name_len);
+    if (ec_property_is_value_case_insensitive(property->id))
+        strlwr(property->value);
+    property->name_hash = ec_hash(property->name, property->name_len);
+
+    ++ section->property_count;
+
+    return 0;
+}
+
+/*
+ * Accept INI property value and store it in the ec_conf being parsed.
+ */
+static int ini_handler(void* cp, const char* section, const char* name,
+        const char* value)
+{
+    conf_parser*        parser = (conf_parser*)cp;
+    ec_conf*            conf = parser->conf;
+    int                 i;
+
+    /* root = true, ignore all the files above and everything before it */
+    if (*section == '\0' && !strcasecmp(name, "root") &&
+            !strcasecmp(value, "true")) {
+        conf->is_root = 1;
+        for (i = 0; i < conf->section_count; ++i)
+            ec_conf_section_clear_properties(&conf->sections[i]);
+        return 1;
+    }
+
+    if (conf->section_count == 0 || strcmp(section, parser->section_name)) {
+        if (ec_conf_add_section(conf, section) == NULL) {
+            parser->is_oom = 1;
+            return 0;
+        }
+        strcpy(parser->section_name, section);
+    }
+
+    if (ec_conf_section_add_property(&conf->sections[conf->section_count - 1],
+                name, value) != 0) {
+        parser->is_oom = 1;
+        return 0;
+    }
+
+    return 1;
+}
+
+/*
+ * Read the whole content of a file into the read buffer of cache, which is
+ * kept for the next files. Return 0 if successful, -1 if the file cannot be
+ * opened and -2 if an OOM occurs.
+ */
+static int read_file(ec_conf_cache* cache, const char* path, size_t* size)
+{
+#define READ_SIZE_INITIAL       4096
+#ifdef EDITORCONFIG_FIXED_MEMORY
+    /* stdio may allocate its buffers with malloc() */
+    int             file;
+    ssize_t         count;
+#else
+    FILE*           file;
+    size_t          count;
+#endif
+    size_t          length = 0;
+
+#ifdef EDITORCONFIG_FIXED_MEMORY
+    file = open(path, O_RDONLY);
+    if (file < 0)
+        return -1;
+#else
+    file = fopen(path, "r");
+    if (!file)
+        return -1;
+#endif
+
+    do {
+        if (length == cache->read_buffer_size) {
+            char*       new_buffer;
+            size_t      new_size;
+
+            new_size = cache->read_buffer_size ?
+                cache->read_buffer_size * 2 : READ_SIZE_INITIAL;
+            new_buffer = (char*)ec_realloc(cache->read_buffer, new_size);
+            if (new_buffer == NULL) {
+                EC_CLOSE(file);
+                return -2;
+            }
+            cache->read_buffer = new_buffer;
+            cache->read_buffer_size = new_size;
+        }
+
+#ifdef EDITORCONFIG_FIXED_MEMORY
+        do {
+            count = read(file, cache->read_buffer + length,
+                    cache->read_buffer_size - length);
+        } while (count < 0 && errno == EINTR);
+        if (count < 0)
+            count = 0;
+#else
+        count = fread(cache->read_buffer + length, 1,
+                cache->read_buffer_size - length, file);
+#endif
+        length += (size_t)count;
+    } while (count > 0);
+
+    EC_CLOSE(file);
+
+    *size = length;
+
+    return 0;
+#undef READ_SIZE_INITIAL
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+int ec_conf_section_compile(ec_conf_section* section,
+        const ec_glob_cache* cache)
+{
+    int         err_num;
+
+    if (section->is_invalid)
+        return EC_GLOB_NOMATCH;
+
+    if (section->glob != NULL)
+        return 0;
+
+    err_num = ec_glob_compile(section->pattern, cache, &section->glob);
+    if (err_num == -1) { /* the pattern will never compile */
+        section->is_invalid = 1;
+        return EC_GLOB_NOMATCH;
+    }
+
+    return err_num;
+}
+
+/*
+ * Parse size bytes of string into the sections of conf, and set
+ * conf->error_line. Return -2 if an OOM occurs.
+ */
+static int ec_conf_parse_string(ec_conf* conf, const char* string,
+        size_t size)
+{
+    conf_parser*    parser;
+    int             err_num = 0;
+
+    /* The parser holds a section name, which is too large for the stack */
+    parser = (conf_parser*)ec_malloc(sizeof(conf_parser));
+    if (parser == NULL)
+        return -2;
+    parser->conf = conf;
+    parser->is_oom = 0;
+
+    conf->error_line = ini_parse_string(string, size, ini_handler, parser);
+    if (parser->is_oom)
+        err_num = -2;
+
+    ec_free(parser);
+
+    return err_num;
+}
+
+#ifdef PARALLEL_PARSE
+/* Files smaller than this are always parsed by the calling thread */
+# define PARALLEL_PARSE_MIN_SIZE        (256 * 1024)
+/* Do not split a file in chunks smaller than this */
+# define PARALLEL_PARSE_MIN_CHUNK_SIZE  (64 * 1024)
+# define PARALLEL_PARSE_MAX_THREADS     8
+
+/*
+ * A part of a file that is parsed on its own thread. Every chunk but the first
+ * starts with a "[section]" line, so parsing it does not depend on what comes
+ * before.
+ */
+typedef struct
+{
+    const char*             string;
+    size_t                  size;
+    /* the sections found in the chunk */
+    ec_conf                 conf;
+    /* the number of lines in the chunk, used to fix up error line numbers */
+    int                     line_count;
+    int                     err_num;
+    /* whether the patterns of the sections are compiled as well */
+    _Bool                   is_compiling;
+    pthread_t               thread;
+    _Bool                   is_thread_started;
+} conf_chunk;
+
+static void* conf_chunk_parse(void* cc)
+{
+    conf_chunk*     chunk = (conf_chunk*)cc;
+    int             i;
+
+    chunk->err_num = ec_conf_parse_string(&chunk->conf, chunk->string,
+            chunk->size);
+    if (chunk->err_num != 0)
+        return NULL;
+
+    chunk->line_count = ini_count_lines(chunk->string, chunk->size);
+
+    /* Every section is going to be matched, so compile the patterns here as
+     * well. If an OOM occurs, the pattern is compiled again when matched. */
+    for (i = 0; chunk->is_compiling && i < chunk->conf.section_count; ++i)
+        ec_conf_section_compile(&chunk->conf.sections[i], NULL);
+
+    return NULL;
+}
+
+/*
+ * Return the number of threads to parse conf with, or 1 if it should be parsed
+ * by the calling thread.
+ */
+static int ec_conf_parse_thread_count(const ec_conf* conf)
+{
+    long        cpu_count;
+    size_t      thread_count;
+
+    if (conf->size < PARALLEL_PARSE_MIN_SIZE || !ec_alloc_is_thread_safe())
+        return 1;
+
+    cpu_count = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpu_count <= 1)
+        return 1;
+
+    thread_count = conf->size / PARALLEL_PARSE_MIN_CHUNK_SIZE;
+    if (thread_count > (size_t)cpu_count)
+        thread_count = (size_t)cpu_count;
+    if (thread_count > PARALLEL_PARSE_MAX_THREADS)
+        thread_count = PARALLEL_PARSE_MAX_THREADS;
+
+    return (int)thread_count;
+}
+
+/*
+ * Split conf->content in chunks at section lines, parse the chunks in
+ * parallel and merge the sections into conf in the order of the file, which is
+ * the same as parsing the whole file at once. Return -2 if an OOM occurs.
+ */
+static int ec_conf_parse_parallel(ec_conf* conf, int thread_count,
+        _Bool is_compiling)
+{
+    conf_chunk*     chunks;
+    int             chunk_count = 0;
+    int             section_count = 0;
+    int             line_offset = 0;
+    int             err_num = 0;
+    size_t          begin;
+    int             i;
+
+    chunks = (conf_chunk*)ec_calloc(thread_count, sizeof(conf_chunk));
+    if (chunks == NULL)
+        return -2;
+
+    for (begin = 0; begin < conf->size; ++ chunk_count) {
+        size_t      end = conf->size;
+
+        if (chunk_count < thread_count - 1) {
+            size_t  target = conf->size / thread_count * (chunk_count + 1);
+
+            end = ini_find_section_line(conf->content, conf->size,
+                    target > begin ? target : begin + 1);
+        }
+
+        chunks[chunk_count].string = conf->content + begin;
+        chunks[chunk_count].size = end - begin;
+        chunks[chunk_count].is_compiling = is_compiling;
+        begin = end;
+    }
+
+    /* The first chunk is parsed by this thread. If a thread cannot be
+     * created, the chunk is parsed here too. */
+    for (i = 1; i < chunk_count; ++i)
+        chunks[i].is_thread_started = !pthread_create(&chunks[i].thread,
+                NULL, conf_chunk_parse, &chunks[i]);
+    conf_chunk_parse(&chunks[0]);
+    for (i = 1; i < chunk_count; ++i) {
+        if (chunks[i].is_thread_started)
+            pthread_join(chunks[i].thread, NULL);
+        else
+            conf_chunk_parse(&chunks[i]);
+    }
+
+    for (i = 0; i < chunk_count; ++i) {
+        if (chunks[i].err_num != 0)
+            err_num = chunks[i].err_num;
+        section_count += chunks[i].conf.section_count;
+    }
+
+    if (err_num == 0 && section_count > 0) {
+        conf->sections = (ec_conf_section*)ec_malloc(
+                sizeof(ec_conf_section) * section_count);
+        if (conf->sections == NULL)
+            err_num = -2;
+        else
+            conf->max_section_count = section_count;
+    }
+
+    if (err_num != 0) {
+        for (i = 0; i < chunk_count; ++i)
+            ec_conf_clear_sections(&chunks[i].conf);
+        ec_free(chunks);
+        return err_num;
+    }
+
+    for (i = 0; i < chunk_count; ++i) {
+        ec_conf*        chunk_conf = &chunks[i].conf;
+
+        /* root = true under a "[]" section drops what comes before it in the
+         * previous chunks too */
+        if (chunk_conf->is_root) {
+            int     j;
+
+            conf->is_root = 1;
+            for (j = 0; j < conf->section_count; ++j)
+                ec_conf_section_clear_properties(&conf->sections[j]);
+        }
+
+        if (conf->error_line == 0 && chunk_conf->error_line != 0)
+            conf->error_line = line_offset + chunk_conf->error_line;
+        line_offset += chunks[i].line_count;
+
+        if (chunk_conf->section_count > 0)
+            memcpy(conf->sections + conf->section_count,
+                    chunk_conf->sections,
+                    sizeof(ec_conf_section) * chunk_conf->section_count);
+        conf->section_count += chunk_conf->section_count;
+        ec_free(chunk_conf->sections);
+    }
+
+    ec_free(chunks);
+
+    return 0;
+}
+#endif /* PARALLEL_PARSE */
+
+/*
+ * Parse conf->content into conf. The patterns of the sections may be compiled
+ * as well if is_compiling is set. Return -2 if an OOM occurs.
+ */
+static int ec_conf_parse(ec_conf* conf, _Bool is_compiling)
+{
+#ifdef PARALLEL_PARSE
+    int         thread_count = ec_conf_parse_thread_count(conf);
+
+    if (thread_count > 1)
+        return ec_conf_parse_parallel(conf, thread_count, is_compiling);
+#else
+    (void)is_compiling;
+#endif
+
+    return ec_conf_parse_string(conf, conf->content, conf->size);
+}
+
+/*
+ * A parsed EditorConfig file kept in an ec_disk_cache is a conf_record,
+ * followed by the content of the file and by its sections. Each section is a
+ * section_record followed by its pattern and by its properties, each of them
+ * a property_record followed by its name and its value. The strings end with a
+ * null character.
+ */
+typedef struct
+{
+    uint64_t                hash;
+    uint64_t                size;
+    int32_t                 is_root;
+    int32_t                 error_line;
+    uint32_t                section_count;
+    uint32_t                reserved;
+} conf_record;
+
+typedef struct
+{
+    uint32_t                pattern_len;
+    uint32_t                property_count;
+} section_record;
+
+typedef struct
+{
+    uint32_t                name_len;
+    uint32_t                value_len;
+} property_record;
+
+/*
+ * Reads the records of an ec_disk_cache entry, checking that they lie within
+ * it, since the cache file could be damaged.
+ */
+typedef struct
+{
+    const char*             data;
+    size_t                  size;
+} record_reader;
+
+/*
+ * Copy the next size bytes of reader to dest. Return 0 if successful and -1 if
+ * there are not so many bytes left.
+ */
+static int record_read(record_reader* reader, void* dest, size_t size)
+{
+    if (size > reader->size)
+        return -1;
+    memcpy(dest, reader->data, size);
+    reader->data += size;
+    reader->size -= size;
+    return 0;
+}
+
+/*
+ * Set *str to the next string of reader, of length len. Return 0 if
+ * successful and -1 if it is not there.
+ */
+static int record_read_string(record_reader* reader, size_t len,
+        const char** str)
+{
+    if (len >= reader->size || reader->data[len] != '\0')
+        return -1;
+    *str = reader->data;
+    reader->data += len + 1;
+    reader->size -= len + 1;
+    return 0;
+}
+
+static void record_write(char** dest, const void* data, size_t size)
+{
+    memcpy(*dest, data, size);
+    *dest += size;
+}
+
+/*
+ * Add conf to disk_cache as the parsed content of the file at path, whose
+ * stamp is stamp. Return 0 if successful and -2 if an OOM occurs.
+ */
+static int ec_conf_store(const ec_conf* conf, ec_disk_cache* disk_cache,
+        const char* path, const ec_file_stamp* stamp)
+{
+    conf_record         record;
+    size_t              size = sizeof(conf_record) + conf->size;
+    char*               data;
+    char*               p;
+    int                 err_num;
+    int                 i;
+    int                 j;
+
+    for (i = 0; i < conf->section_count; ++i) {
+        const ec_conf_section*  section = &conf->sections[i];
+
+        size += sizeof(section_record) + strlen(section->pattern) + 1;
+        for (j = 0; j < section->property_count; ++j)
+            size += sizeof(property_record) +
+                section->properties[j].name_len + 1 +
+                section->properties[j].value_len + 1;
+    }
+
+    data = (char*)ec_malloc(size);
+    if (data == NULL)
+        return -2;
+
+    memset(&record, 0, sizeof(record));
+    record.hash = conf->hash;
+    record.size = conf->size;
+    record.is_root = conf->is_root;
+    record.error_line = conf->error_line;
+    record.section_count = (uint32_t)conf->section_count;
+
+    p = data;
+    record_write(&p, &record, sizeof(record));
+    record_write(&p, conf->content, conf->size);
+    for (i = 0; i < conf->section_count; ++i) {
+        const ec_conf_section*  section = &conf->sections[i];
+        section_record          sr;
+
+        sr.pattern_len = (uint32_t)strlen(section->pattern);
+        sr.property_count = (uint32_t)section->property_count;
+        record_write(&p, &sr, sizeof(sr));
+        record_write(&p, section->pattern, sr.pattern_len + 1);
+
+        for (j = 0; j < section->property_count; ++j) {
+            const ec_conf_property* property = &section->properties[j];
+            property_record         pr;
+
+            pr.name_len = (uint32_t)property->name_len;
+            pr.value_len = (uint32_t)property->value_len;
+            record_write(&p, &pr, sizeof(pr));
+            record_write(&p, property->name, pr.name_len + 1);
+            record_write(&p, property->value, pr.value_len + 1);
+        }
+    }
+
+    err_num = ec_disk_cache_add(disk_cache, path, stamp, data, size);
+    ec_free(data);
+
+    return err_num;
+}
+
+/*
+ * Set the sections of conf, which has no section yet, from those read by
+ * reader. Return 0 if successful, -1 if the sections are damaged and -2 if an
+ * OOM occurs.
+ */
+static int ec_conf_load_sections(ec_conf* conf, const conf_record* record,
+        record_reader* reader)
+{
+    uint32_t            i;
+    uint32_t            j;
+
+    conf->is_root = record->is_root != 0;
+    conf->error_line = record->error_line;
+
+    for (i = 0; i < record->section_count; ++i) {
+        ec_conf_section*    section;
+        section_record      sr;
+        const char*         pattern;
+        char*               pattern_copy;
+
+        if (record_read(reader, &sr, sizeof(sr)) != 0 ||
+                record_read_string(reader, sr.pattern_len, &pattern) != 0)
+            return -1;
+
+        pattern_copy = ec_strdup(pattern);
+        if (pattern_copy == NULL)
+            return -2;
+        section = ec_conf_push_section(conf, pattern_copy);
+        if (section == NULL) {
+            ec_free(pattern_copy);
+            return -2;
+        }
+
+        for (j = 0; j < sr.property_count; ++j) {
+            property_record     pr;
+            const char*         name;
+            const char*         value;
+
+            if (record_read(reader, &pr, sizeof(pr)) != 0 ||
+                    record_read_string(reader, pr.name_len, &name) != 0 ||
+                    record_read_string(reader, pr.value_len, &value) != 0)
+                return -1;
+            if (ec_conf_section_add_property(section, name, value) != 0)
+                return -2;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Add conf to the cache, growing the hash table when needed. Return -1 if an
+ * OOM occurs.
+ */
+static int ec_conf_cache_insert(ec_conf_cache* cache, ec_conf* conf)
+{
+    size_t          bucket;
+
+    if (cache->count >= cache->bucket_count) {
+        ec_conf**       new_buckets;
+        size_t          new_bucket_count;
+        size_t          i;
+
+        new_bucket_count = cache->bucket_count ? cache->bucket_count * 2 : 16;
+        new_buckets = (ec_conf**)ec_calloc(new_bucket_count, sizeof(ec_conf*));
+        if (new_buckets == NULL)
+            return -1;
+
+        for (i = 0; i < cache->bucket_count; ++i) {
+            ec_conf*        c = cache->buckets[i];
+
+            while (c != NULL) {
+                ec_conf*    next = c->next;
+
+                bucket = (size_t)(c->hash % new_bucket_count);
+                c->next = new_buckets[bucket];
+                new_buckets[bucket] = c;
+                c = next;
+            }
+        }
+
+        ec_free(cache->buckets);
+        cache->buckets = new_buckets;
+        cache->bucket_count = new_bucket_count;
+    }
+
+    bucket = (size_t)(conf->hash % cache->bucket_count);
+    conf->next = cache->buckets[bucket];
+    cache->buckets[bucket] = conf;
+    ++ cache->count;
+
+    return 0;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+int ec_conf_cache_load(ec_conf_cache* cache, ec_disk_cache* disk_cache,
+        const char* path, ec_conf** conf)
+{
+    const char*     content;
+    size_t          size;
+    uint64_t        hash;
+    ec_conf*        new_conf;
+    ec_file_stamp   stamp;
+    conf_record     record;
+    /* the sections kept in disk_cache, if the file is found there */
+    record_reader   reader;
+    _Bool           is_cached = 0;
+    int             err_num;
+
+    if (disk_cache != NULL) {
+        const void*     value;
+        size_t          value_size;
+
+        if (ec_file_stamp_get(path, &stamp) != 0)
+            return -1;
+
+        if (ec_disk_cache_find(disk_cache, path, &stamp, &value,
+                    &value_size) == 0) {
+            reader.data = (const char*)value;
+            reader.size = value_size;
+            is_cached = record_read(&reader, &record, sizeof(record)) == 0 &&
+                record.size <= reader.size;
+        }
+    }
+
+    if (is_cached) {
+        content = reader.data;
+        size = (size_t)record.size;
+        hash = record.hash;
+        reader.data += size;
+        reader.size -= size;
+    } else {
+        err_num = read_file(cache, path, &size);
+        if (err_num != 0)
+            return err_num;
+        content = cache->read_buffer;
+        hash = ec_hash(content, size);
+    }
+
+    *conf = NULL;
+
+    /* Reuse the file parsed earlier if there is one with the same content */
+    if (cache->bucket_count > 0) {
+        ec_conf*        c;
+
+        for (c = cache->buckets[hash % cache->bucket_count]; c != NULL;
+                c = c->next) {
+            if (c->hash == hash && c->size == size &&
+                    (size == 0 || !memcmp(c->content, content, size))) {
+                *conf = c;
+                break;
+            }
+        }
+    }
+
+    if (*conf == NULL) {
+        new_conf = (ec_conf*)ec_calloc(1, sizeof(ec_conf));
+        if (new_conf == NULL)
+            return -2;
+        new_conf->content = (char*)ec_malloc(size ? size : 1);
+        if (new_conf->content == NULL) {
+            ec_free(new_conf);
+            return -2;
+        }
+        memcpy(new_conf->content, content, size);
+        new_conf->size = size;
+        new_conf->hash = hash;
+
+        /* damaged sections are parsed again from the content */
+        err_num = -1;
+        if (is_cached)
+            err_num = ec_conf_load_sections(new_conf, &record, &reader);
+        if (err_num == -1) {
+            ec_conf_clear_sections(new_conf);
+            new_conf->is_root = 0;
+            /* with a disk cache, the patterns are compiled when they are
+             * first matched, so that the compiled regexes are cached too */
+            err_num = ec_conf_parse(new_conf, disk_cache == NULL);
+        }
+
+        if (err_num != 0 || ec_conf_cache_insert(cache, new_conf) != 0) {
+            ec_conf_free(new_conf);
+            return -2;
+        }
+
+        *conf = new_conf;
+    }
+    (*conf)->generation = cache->generation;
+
+    /* a path outside of an index is not added to it */
+    if (disk_cache != NULL && !is_cached &&
+            ec_conf_store(*conf, disk_cache, path, &stamp) == -2)
+        return -2;
+
+    return 0;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+void ec_conf_cache_clear(ec_conf_cache* cache)
+{
+    size_t          i;
+
+    for (i = 0; i < cache->bucket_count; ++i) {
+        ec_conf*        c = cache->buckets[i];
+
+        while (c != NULL) {
+            ec_conf*    next = c->next;
+
+            ec_conf_free(c);
+            c = next;
+        }
+    }
+
+    ec_free(cache->buckets);
+    ec_free(cache->read_buffer);
+    memset(cache, 0, sizeof(ec_conf_cache));
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+_Bool ec_conf_cache_needs_sweep(const ec_conf_cache* cache)
+{
+    return cache->count >= cache->sweep_count &&
+        cache->count >= CONF_CACHE_MIN_SWEEP_COUNT;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+size_t ec_conf_cache_sweep(ec_conf_cache* cache)
+{
+    size_t          removed = 0;
+    size_t          i;
+
+    for (i = 0; i < cache->bucket_count; ++i) {
+        ec_conf**   link = &cache->buckets[i];
+
+        while (*link != NULL) {
+            ec_conf*    c = *link;
+
+            if (c->generation != cache->generation) {
+                *link = c->next;
+                ec_conf_free(c);
+                ++ removed;
+            } else {
+                link = &c->next;
+            }
+        }
+    }
+    cache->count -= removed;
+
+    /* the files kept are not swept again before as many are added, so that
+     * the sweeps take a constant time per file */
+    ++ cache->generation;
+    cache->sweep_count = cache->count * 2;
+
+    return removed;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+int ec_conf_section_match(ec_conf_section* section,
+        const ec_glob_cache* cache, const char* relative_path)
+{
+    int         err_num = ec_conf_section_compile(section, cache);
+
+    if (err_num != 0)
+        return err_num;
+
+    return ec_glob_match(section->glob, relative_path);
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EC_CONF_H__
+#define EC_CONF_H__
+
+#include "global.h"
+
+#include <stdint.h>
+
+#include "ec_disk_cache.h"
+#include "ec_glob.h"
+#include "ec_property.h"
+
+/*
+ * A name and value pair found in a section of an EditorConfig file. The name
+ * is lowercased, and so is the value of the properties whose values are case
+ * insensitive.
+ */
+typedef struct ec_conf_property
+{
+    char*                   name;
+    size_t                  name_len;
+    /* ec_hash() of name */
+    uint64_t                name_hash;
+    /* EC_PROPERTY_UNKNOWN if name is not defined by the specification */
+    ec_property_id          id;
+    char*                   value;
+    size_t                  value_len;
+} ec_conf_property;
+
+/*
+ * A section of an EditorConfig file.
+ */
+typedef struct ec_conf_section
+{
+    /* The section name turned into a glob that is matched against a file path
+     * relative to the directory of the EditorConfig file. The relative path
+     * always starts with a '/'. */
+    char*                   pattern;
+    /* The compiled pattern, NULL until it is compiled, at the latest when the
+     * section is first matched. */
+    ec_glob_pattern*        glob;
+    /* Whether pattern failed to compile. Such a section never matches. */
+    _Bool                   is_invalid;
+
+    ec_conf_property*       properties;
+    int                     property_count;
+    int                     max_property_count;
+} ec_conf_section;
+
+/*
+ * A parsed EditorConfig file. Nothing in it depends on the location of the
+ * file, so all the files with the same content share one ec_conf.
+ */
+typedef struct ec_conf
+{
+    /* content of the file, used to tell files with the same hash apart */
+    char*                   content;
+    size_t                  size;
+    uint64_t                hash;
+
+    /* Whether root = true is set in the preamble of the file. */
+    _Bool                   is_root;
+    /* The line number of the first parsing error, or 0. */
+    int                     error_line;
+
+    ec_conf_section*        sections;
+    int                     section_count;
+    int                     max_section_count;
+
+    /* the generation of the ec_conf_cache when the file was last used */
+    unsigned                generation;
+    /* next ec_conf in the same bucket of an ec_conf_cache */
+    struct ec_conf*         next;
+} ec_conf;
+
+/*
+ * Parsed EditorConfig files, indexed by the hash of their content. The files
+ * that are no longer used are freed by ec_conf_cache_sweep(), so that the
+ * cache of a long running process does not keep every version of every file
+ * it has seen.
+ */
+typedef struct ec_conf_cache
+{
+    ec_conf**               buckets;
+    size_t                  bucket_count;
+    size_t                  count;
+
+    /* incremented by each sweep */
+    unsigned                generation;
+    /* the count from which the cache is due for a sweep */
+    size_t                  sweep_count;
+
+    /* files are read here first, and only copied if they are not cached */
+    char*                   read_buffer;
+    size_t                  read_buffer_size;
+} ec_conf_cache;
+
+/*
+ * Read the EditorConfig file at path and set *conf to its parsed content,
+ * which is shared with every other file of the cache with the same content.
+ * If disk_cache is not NULL, the parsed content is taken from it instead when
+ * the file is unchanged, and added to it otherwise. Return 0 if successful, -1
+ * if the file cannot be opened and -2 if an OOM occurs. Errors in the file are
+ * not reported here but in (*conf)->error_line.
+ */
+EDITORCONFIG_LOCAL
+int ec_conf_cache_load(ec_conf_cache* cache, ec_disk_cache* disk_cache,
+        const char* path, ec_conf** conf);
+
+/*
+ * Free all the parsed EditorConfig files in the cache. The cache may be used
+ * again afterwards.
+ */
+EDITORCONFIG_LOCAL
+void ec_conf_cache_clear(ec_conf_cache* cache);
+
+/*
+ * Whether the cache has grown enough since the last sweep for
+ * ec_conf_cache_sweep() to be worth it.
+ */
+EDITORCONFIG_LOCAL
+_Bool ec_conf_cache_needs_sweep(const ec_conf_cache* cache);
+
+/*
+ * Free the parsed EditorConfig files that were not loaded since the last
+ * sweep and whose generation was not set to the current generation of the
+ * cache by their other users, then start a new generation. The files freed
+ * must not be used anymore. Return the number of files freed.
+ */
+EDITORCONFIG_LOCAL
+size_t ec_conf_cache_sweep(ec_conf_cache* cache);
+
+/*
+ * Compile the pattern of section if it is not compiled yet, through cache if
+ * it is not NULL. Return 0 if successful, EC_GLOB_NOMATCH if the pattern is
+ * invalid and -2 if an OOM occurs.
+ */
+EDITORCONFIG_LOCAL
+int ec_conf_section_compile(ec_conf_section* section,
+        const ec_glob_cache* cache);
+
+/*
+ * Whether the path relative to the directory of the EditorConfig file matches
+ * the section, whose pattern is compiled through cache on the first match if
+ * cache is not NULL. Return 0 if it matches, nonzero otherwise.
+ */
+EDITORCONFIG_LOCAL
+int ec_conf_section_match(ec_conf_section* section,
+        const ec_glob_cache* cache, const char* relative_path);
+
+#endif /* !EC_CONF_H__ */
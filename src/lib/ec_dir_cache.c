@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "global.h"
+#include "misc.h"
+
+#include "ec_alloc.h"
+#include "ec_dir_cache.h"
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+ec_dir* ec_dir_cache_find(const ec_dir_cache* cache, const char* path,
+        size_t path_len)
+{
+    uint64_t        hash;
+    ec_dir*         dir;
+
+    if (cache->bucket_count == 0)
+        return NULL;
+
+    hash = ec_hash(path, path_len);
+    for (dir = cache->buckets[hash % cache->bucket_count]; dir != NULL;
+            dir = dir->next)
+        if (dir->hash == hash && dir->path_len == path_len &&
+                !memcmp(dir->path, path, path_len))
+            return dir;
+
+    return NULL;
+}
+
+/*
+ * Add dir to the cache, growing the hash table when needed.
+ */
+static int ec_dir_cache_insert(ec_dir_cache* cache, ec_dir* dir)
+{
+    size_t          bucket;
+
+    if (cache->count >= cache->bucket_count) {
+        ec_dir**        new_buckets;
+        size_t          new_bucket_count;
+        size_t          i;
+
+        new_bucket_count = cache->bucket_count ? cache->bucket_count * 2 : 16;
+        new_buckets = (ec_dir**)ec_calloc(new_bucket_count, sizeof(ec_dir*));
+        if (new_buckets == NULL)
+            return -1;
+
+        for (i = 0; i < cache->bucket_count; ++i) {
+            ec_dir*     d = cache->buckets[i];
+
+            while (d != NULL) {
+                ec_dir*     next = d->next;
+
+                bucket = (size_t)(d->hash % new_bucket_count);
+                d->next = new_buckets[bucket];
+                new_buckets[bucket] = d;
+                d = next;
+            }
+        }
+
+        ec_free(cache->buckets);
+        cache->buckets = new_buckets;
+        cache->bucket_count = new_bucket_count;
+    }
+
+    bucket = (size_t)(dir->hash % cache->bucket_count);
+    dir->next = cache->buckets[bucket];
+    cache->buckets[bucket] = dir;
+    ++ cache->count;
+
+    return 0;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+ec_dir* ec_dir_cache_add(ec_dir_cache* cache, const char* path,
+        size_t path_len, const ec_dir* parent, ec_conf* conf)
+{
+    ec_dir*         dir;
+    int             conf_count = parent ? parent->conf_count : 0;
+
+    if (conf != NULL)
+        ++ conf_count;
+
+    /* the files follow the header and the path follows the files, so they
+     * are all suitably aligned */
+    dir = (ec_dir*)ec_malloc(sizeof(ec_dir) +
+            sizeof(ec_dir_conf) * conf_count + path_len + 1);
+    if (dir == NULL)
+        return NULL;
+
+    dir->confs = (ec_dir_conf*)(dir + 1);
+    dir->conf_count = conf_count;
+    if (parent != NULL && parent->conf_count > 0)
+        memcpy(dir->confs, parent->confs,
+                sizeof(ec_dir_conf) * parent->conf_count);
+    if (conf != NULL) {
+        dir->confs[conf_count - 1].dir_len = path_len;
+        dir->confs[conf_count - 1].conf = conf;
+    }
+
+    dir->path = (char*)(dir->confs + conf_count);
+    memcpy(dir->path, path, path_len);
+    dir->path[path_len] = '\0';
+    dir->path_len = path_len;
+    dir->hash = ec_hash(path, path_len);
+
+    if (ec_dir_cache_insert(cache, dir) != 0) {
+        ec_free(dir);
+        return NULL;
+    }
+
+    return dir;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+size_t ec_dir_cache_remove_tree(ec_dir_cache* cache, const char* path,
+        size_t path_len)
+{
+    size_t          removed = 0;
+    size_t          i;
+
+    for (i = 0; i < cache->bucket_count; ++i) {
+        ec_dir**    link = &cache->buckets[i];
+
+        while (*link != NULL) {
+            ec_dir*     dir = *link;
+
+            if (dir->path_len >= path_len &&
+                    !memcmp(dir->path, path, path_len) &&
+                    (dir->path_len == path_len ||
+                     dir->path[path_len] == '/')) {
+                *link = dir->next;
+                ec_free(dir);
+                ++ removed;
+            } else {
+                link = &dir->next;
+            }
+        }
+    }
+    cache->count -= removed;
+
+    return removed;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+void ec_dir_cache_mark_confs(const ec_dir_cache* cache, unsigned generation)
+{
+    size_t          i;
+    int             j;
+
+    for (i = 0; i < cache->bucket_count; ++i) {
+        const ec_dir*   dir;
+
+        for (dir = cache->buckets[i]; dir != NULL; dir = dir->next)
+            for (j = 0; j < dir->conf_count; ++j)
+                if (dir->confs[j].conf != NULL)
+                    dir->confs[j].conf->generation = generation;
+    }
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+void ec_dir_cache_clear(ec_dir_cache* cache)
+{
+    size_t          i;
+
+    for (i = 0; i < cache->bucket_count; ++i) {
+        ec_dir*     dir = cache->buckets[i];
+
+        while (dir != NULL) {
+            ec_dir*     next = dir->next;
+
+            ec_free(dir);
+            dir = next;
+        }
+    }
+
+    ec_free(cache->buckets);
+    memset(cache, 0, sizeof(ec_dir_cache));
+}
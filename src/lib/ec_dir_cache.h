@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EC_DIR_CACHE_H__
+#define EC_DIR_CACHE_H__
+
+#include "global.h"
+
+#include <stdint.h>
+
+#include "ec_conf.h"
+
+/*
+ * An EditorConfig file that applies to the files of a directory.
+ */
+typedef struct
+{
+    /* length of the directory the EditorConfig file is in, which is a prefix
+     * of the directory of the files */
+    size_t                  dir_len;
+    ec_conf*                conf;
+} ec_dir_conf;
+
+/*
+ * A directory and the EditorConfig files that apply to its files, from the
+ * topmost one. It is allocated as a single block holding the path and the
+ * files.
+ */
+typedef struct ec_dir
+{
+    /* the path of the directory, without the trailing slash */
+    char*                   path;
+    size_t                  path_len;
+    uint64_t                hash;
+    ec_dir_conf*            confs;
+    int                     conf_count;
+    /* next ec_dir in the same bucket of an ec_dir_cache */
+    struct ec_dir*          next;
+} ec_dir;
+
+/*
+ * Directories indexed by their path, so that the EditorConfig files that apply
+ * to a directory are only looked up once. The EditorConfig files themselves
+ * belong to an ec_conf_cache, which must outlive the directories.
+ */
+typedef struct ec_dir_cache
+{
+    ec_dir**                buckets;
+    size_t                  bucket_count;
+    size_t                  count;
+} ec_dir_cache;
+
+/*
+ * Return the directory of the cache whose path is the first path_len
+ * characters of path, or NULL if there is none.
+ */
+EDITORCONFIG_LOCAL
+ec_dir* ec_dir_cache_find(const ec_dir_cache* cache, const char* path,
+        size_t path_len);
+
+/*
+ * Add the directory whose path is the first path_len characters of path, with
+ * the EditorConfig files of parent followed by conf, if it is not NULL. Return
+ * the new directory, or NULL if an OOM occurs.
+ */
+EDITORCONFIG_LOCAL
+ec_dir* ec_dir_cache_add(ec_dir_cache* cache, const char* path,
+        size_t path_len, const ec_dir* parent, ec_conf* conf);
+
+/*
+ * Remove the directory whose path is the first path_len characters of path and
+ * all the directories below it, whose EditorConfig files include its own.
+ * Return the number of directories removed.
+ */
+EDITORCONFIG_LOCAL
+size_t ec_dir_cache_remove_tree(ec_dir_cache* cache, const char* path,
+        size_t path_len);
+
+/*
+ * Set the generation of the EditorConfig files of the directories of the cache
+ * to generation, so that ec_conf_cache_sweep() keeps them.
+ */
+EDITORCONFIG_LOCAL
+void ec_dir_cache_mark_confs(const ec_dir_cache* cache, unsigned generation);
+
+/*
+ * Free all the directories of the cache. The cache may be used again
+ * afterwards.
+ */
+EDITORCONFIG_LOCAL
+void ec_dir_cache_clear(ec_dir_cache* cache);
+
+#endif /* !EC_DIR_CACHE_H__ */
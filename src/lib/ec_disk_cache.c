@@ -0,0 +1,919 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "global.h"
+
+#ifdef HAVE_SYS_MMAN_H
+# include <errno.h>
+# include <fcntl.h>
+# include <time.h>
+# include <unistd.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <sys/types.h>
+#endif
+
+#include "ec_alloc.h"
+#include "misc.h"
+
+#include "ec_disk_cache.h"
+
+#ifdef HAVE_SYS_MMAN_H
+
+#ifndef O_CLOEXEC
+# define O_CLOEXEC          0
+#endif
+
+/* The stamps changed less than this many seconds ago are not trusted, since
+ * the file systems may only keep the times to the second or less */
+#define RACY_DELAY          2
+
+/* The largest file written or mapped, and the most entries written */
+#define MAX_FILE_SIZE       (64 * 1024 * 1024)
+#define MAX_ENTRY_COUNT     65536
+
+#define FILE_MAGIC          "ECCACHE"
+#define FILE_FORMAT         2
+#define FILE_BYTE_ORDER     0x01020304
+
+#define ALIGN8(size)        (((size) + 7) & ~(size_t)7)
+
+/*
+ * The file starts with a header, followed by the offsets of the first entry of
+ * each bucket, 0 for none, and by the entries, which are all aligned on 8
+ * bytes. Each entry is followed by its key, with a null character, and by its
+ * value.
+ */
+typedef struct
+{
+    char                    magic[8];
+    uint32_t                format;
+    uint32_t                byte_order;
+    /* the version of the library that wrote the file, since the values may
+     * depend on it */
+    uint32_t                version[3];
+    uint32_t                bucket_count;
+    uint32_t                entry_count;
+    uint32_t                reserved;
+    uint64_t                file_size;
+} file_header;
+
+typedef struct
+{
+    uint64_t                key_hash;
+    ec_file_stamp           stamp;
+    uint64_t                value_size;
+    /* hash_value() of the value, checked before the value is used, since the
+     * file could be damaged */
+    uint64_t                value_hash;
+    uint32_t                key_len;
+    /* the offset of the next entry of the same bucket, or 0 */
+    uint32_t                next;
+} file_entry;
+
+struct ec_disk_cache_pending
+{
+    /* next entry in the same bucket of an ec_disk_cache */
+    ec_disk_cache_pending*  next;
+    /* whether the key is the path of a file, whose entry is written first */
+    _Bool                   is_file;
+    file_entry              entry;
+};
+
+static size_t entry_size(size_t key_len, size_t value_size)
+{
+    return sizeof(file_entry) + ALIGN8(key_len + 1) + ALIGN8(value_size);
+}
+
+static const char* entry_key(const file_entry* entry)
+{
+    return (const char*)(entry + 1);
+}
+
+static const void* entry_value(const file_entry* entry)
+{
+    return entry_key(entry) + ALIGN8(entry->key_len + 1);
+}
+
+/*
+ * Hash size bytes of value. The values can be large, and are hashed on every
+ * lookup, so this reads 8 bytes at a time. It only has to catch damaged files.
+ */
+static uint64_t hash_value(const void* value, size_t size)
+{
+    const unsigned char*    p = (const unsigned char*)value;
+    uint64_t                hash = EC_HASH_INIT ^ size;
+    uint64_t                word;
+
+    for (; size >= 8; p += 8, size -= 8) {
+        memcpy(&word, p, 8);
+        hash = (hash ^ word) * 0x100000001b3ULL;
+        hash ^= hash >> 32;
+    }
+
+    return ec_hash_update(hash, p, size);
+}
+
+static const uint32_t* map_buckets(const unsigned char* map)
+{
+    return (const uint32_t*)(map + sizeof(file_header));
+}
+
+/*
+ * Return the entry of the mapped file at offset, or NULL if there is none or
+ * it does not lie within the file.
+ */
+static const file_entry* map_entry(const unsigned char* map, size_t map_size,
+        uint32_t offset)
+{
+    const file_entry*       entry;
+
+    if (offset == 0 || offset % 8 != 0 || offset > map_size ||
+            map_size - offset < sizeof(file_entry))
+        return NULL;
+
+    entry = (const file_entry*)(map + offset);
+    if (entry->key_len >= map_size || entry->value_size >= map_size ||
+            entry_size(entry->key_len, entry->value_size) > map_size - offset)
+        return NULL;
+
+    return entry;
+}
+
+/*
+ * Whether the mapped file was written by this version of the library and is
+ * complete.
+ */
+static _Bool is_map_valid(const unsigned char* map, size_t map_size)
+{
+    const file_header*      header = (const file_header*)map;
+
+    return map_size >= sizeof(file_header) &&
+        !memcmp(header->magic, FILE_MAGIC, sizeof(header->magic)) &&
+        header->format == FILE_FORMAT &&
+        header->byte_order == FILE_BYTE_ORDER &&
+        header->version[0] == EC_VERSION_MAJOR &&
+        header->version[1] == EC_VERSION_MINOR &&
+        header->version[2] == EC_VERSION_PATCH &&
+        header->file_size == map_size &&
+        header->bucket_count > 0 &&
+        header->bucket_count <= (map_size - sizeof(file_header)) /
+            sizeof(uint32_t);
+}
+
+/*
+ * Map the cache file at path. Set *map to NULL if it is missing or invalid,
+ * or, if is_private is set, if it is not owned by the user or other users can
+ * write it.
+ */
+static void map_file(const char* path, _Bool is_private,
+        const unsigned char** map, size_t* map_size)
+{
+    struct stat             st;
+    void*                   m;
+    int                     fd;
+
+    *map = NULL;
+    *map_size = 0;
+
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return;
+
+    /* the compiled regexes of a private cache are decoded without checks */
+    if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(file_header) &&
+            st.st_size <= MAX_FILE_SIZE && (!is_private ||
+                (st.st_uid == getuid() &&
+                 (st.st_mode & (S_IWGRP | S_IWOTH)) == 0))) {
+        m = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (m != MAP_FAILED) {
+            if (is_map_valid((const unsigned char*)m, (size_t)st.st_size)) {
+                *map = (const unsigned char*)m;
+                *map_size = (size_t)st.st_size;
+            } else {
+                munmap(m, (size_t)st.st_size);
+            }
+        }
+    }
+
+    close(fd);
+}
+
+static void unmap_file(const unsigned char* map, size_t map_size)
+{
+    if (map != NULL)
+        munmap((void*)map, map_size);
+}
+
+/*
+ * Return the entry of key in the mapped file, or NULL if there is none.
+ */
+static const file_entry* map_find(const unsigned char* map, size_t map_size,
+        const char* key, size_t key_len, uint64_t hash)
+{
+    const file_header*      header = (const file_header*)map;
+    const file_entry*       entry;
+    uint32_t                step;
+
+    if (map == NULL)
+        return NULL;
+
+    /* the steps are bounded in case the chain loops */
+    entry = map_entry(map, map_size,
+            map_buckets(map)[hash % header->bucket_count]);
+    for (step = 0; entry != NULL && step < header->entry_count; ++step) {
+        if (entry->key_hash == hash && entry->key_len == key_len &&
+                !memcmp(entry_key(entry), key, key_len))
+            return entry;
+        entry = map_entry(map, map_size, entry->next);
+    }
+
+    return NULL;
+}
+
+/*
+ * Return the pending entry of key, or NULL if there is none.
+ */
+static ec_disk_cache_pending* pending_find(const ec_disk_cache* cache,
+        const char* key, size_t key_len, uint64_t hash)
+{
+    ec_disk_cache_pending*  p;
+
+    if (cache->bucket_count == 0)
+        return NULL;
+
+    for (p = cache->buckets[hash % cache->bucket_count]; p != NULL;
+            p = p->next)
+        if (p->entry.key_hash == hash && p->entry.key_len == key_len &&
+                !memcmp(entry_key(&p->entry), key, key_len))
+            return p;
+
+    return NULL;
+}
+
+/*
+ * Add p to the pending entries, growing the hash table when needed. Return 0
+ * if successful and -1 if an OOM occurs.
+ */
+static int pending_insert(ec_disk_cache* cache, ec_disk_cache_pending* p)
+{
+    size_t                  bucket;
+
+    if (cache->count >= cache->bucket_count) {
+        ec_disk_cache_pending** new_buckets;
+        size_t                  new_bucket_count;
+        size_t                  i;
+
+        new_bucket_count = cache->bucket_count ? cache->bucket_count * 2 : 16;
+        new_buckets = (ec_disk_cache_pending**)ec_calloc(new_bucket_count,
+                sizeof(ec_disk_cache_pending*));
+        if (new_buckets == NULL)
+            return -1;
+
+        for (i = 0; i < cache->bucket_count; ++i) {
+            ec_disk_cache_pending*  q = cache->buckets[i];
+
+            while (q != NULL) {
+                ec_disk_cache_pending*  next = q->next;
+
+                bucket = (size_t)(q->entry.key_hash % new_bucket_count);
+                q->next = new_buckets[bucket];
+                new_buckets[bucket] = q;
+                q = next;
+            }
+        }
+
+        ec_free(cache->buckets);
+        cache->buckets = new_buckets;
+        cache->bucket_count = new_bucket_count;
+    }
+
+    bucket = (size_t)(p->entry.key_hash % cache->bucket_count);
+    p->next = cache->buckets[bucket];
+    cache->buckets[bucket] = p;
+    ++ cache->count;
+
+    return 0;
+}
+
+/*
+ * Create the missing parent directories of path, only readable by the user.
+ * The errors are left to the creation of the file.
+ */
+static void make_parent_dirs(char* path)
+{
+    char*                   slash;
+
+    for (slash = strchr(path + 1, '/'); slash != NULL;
+            slash = strchr(slash + 1, '/')) {
+        *slash = '\0';
+        mkdir(path, 0700);
+        *slash = '/';
+    }
+}
+
+/*
+ * Write the size bytes of data to a new file that replaces the file at path,
+ * readable by everyone if is_shared is set and only by its owner otherwise.
+ * Return 0 if successful and -1 otherwise.
+ */
+static int replace_file(char* path, const void* data, size_t size,
+        _Bool is_shared)
+{
+    char*                   tmp_path;
+    const char*             p = (const char*)data;
+    int                     fd;
+    int                     err_num = -1;
+
+    tmp_path = (char*)ec_malloc(strlen(path) + sizeof(".XXXXXX"));
+    if (tmp_path == NULL)
+        return -1;
+    strcpy(tmp_path, path);
+    strcat(tmp_path, ".XXXXXX");
+
+    if (!is_shared)
+        make_parent_dirs(path);
+    fd = mkstemp(tmp_path);
+    if (fd < 0) {
+        ec_free(tmp_path);
+        return -1;
+    }
+    if (is_shared)
+        fchmod(fd, 0644);
+
+    while (size > 0) {
+        ssize_t             count = write(fd, p, size);
+
+        if (count < 0 && errno == EINTR)
+            continue;
+        if (count <= 0)
+            break;
+        p += count;
+        size -= (size_t)count;
+    }
+
+    if (close(fd) == 0 && size == 0 && rename(tmp_path, path) == 0)
+        err_num = 0;
+    else
+        unlink(tmp_path);
+
+    ec_free(tmp_path);
+
+    return err_num;
+}
+
+/*
+ * Set *key to the key of path in cache, and *key_stamp to the part of stamp
+ * that cache records. Return 0 if successful and -1 if path is outside of the
+ * directory of an index.
+ */
+static int get_key(const ec_disk_cache* cache, const char* path,
+        const ec_file_stamp* stamp, const char** key, ec_file_stamp* key_stamp)
+{
+    *key_stamp = *stamp;
+    /* the keys which are not paths are the same in an index */
+    if (!cache->is_index || path[0] != '/') {
+        *key = path;
+        return 0;
+    }
+
+    if (!ec_disk_cache_covers(cache, path))
+        return -1;
+    *key = path + cache->root_len + 1;
+
+    /* the copies of a file keep its size and modification time only */
+    key_stamp->dev = 0;
+    key_stamp->ino = 0;
+    key_stamp->ctime_sec = 0;
+    key_stamp->ctime_nsec = 0;
+
+    return 0;
+}
+
+/*
+ * Add entry to the list of the entries to write, unless it is beyond the
+ * limits of the file. Return 0 if it is added and -1 otherwise.
+ */
+static int collect_entry(const file_entry** entries, uint32_t* entry_count,
+        size_t* data_size, const file_entry* entry)
+{
+    size_t                  size = entry_size(entry->key_len,
+            entry->value_size);
+
+    if (*entry_count >= MAX_ENTRY_COUNT || size > MAX_FILE_SIZE - *data_size)
+        return -1;
+
+    entries[(*entry_count) ++] = entry;
+    *data_size += size;
+
+    return 0;
+}
+
+/*
+ * Write the pending entries of cache, and the entries of the file as it is
+ * now unless it is an index, to a new file. The pending entries come first, so
+ * that the oldest entries are dropped when the file is full. Return 0 if
+ * successful and -1 if the file cannot be written or not all the pending
+ * entries of files fit in it.
+ */
+static int write_file(ec_disk_cache* cache)
+{
+    const unsigned char*    map;
+    size_t                  map_size;
+    const file_entry**      entries;
+    uint32_t                max_entry_count;
+    uint32_t                entry_count = 0;
+    uint32_t                bucket_count;
+    size_t                  data_size;
+    size_t                  offset;
+    unsigned char*          data;
+    file_header*            header;
+    uint32_t*               buckets;
+    size_t                  i;
+    uint32_t                j;
+    int                     err_num;
+
+    /* another process may have replaced the file since it was mapped, and a
+     * new index replaces the file without keeping its entries */
+    map = NULL;
+    map_size = 0;
+    if (!cache->is_index)
+        map_file(cache->path, 1, &map, &map_size);
+
+    max_entry_count = (uint32_t)cache->count;
+    if (map != NULL)
+        max_entry_count += ((const file_header*)map)->entry_count;
+    if (max_entry_count > MAX_ENTRY_COUNT)
+        max_entry_count = MAX_ENTRY_COUNT;
+
+    /* the headers and the buckets are counted at the end */
+    entries = (const file_entry**)ec_malloc(sizeof(file_entry*) *
+            (max_entry_count ? max_entry_count : 1));
+    if (entries == NULL) {
+        unmap_file(map, map_size);
+        return -1;
+    }
+    data_size = 0;
+
+    /* the entries of the files come first, since those of an index must all
+     * be written, while the others only save some work */
+    err_num = 0;
+    for (i = 0; i < cache->bucket_count; ++i) {
+        const ec_disk_cache_pending*    p;
+
+        for (p = cache->buckets[i]; p != NULL; p = p->next)
+            if (p->is_file && collect_entry(entries, &entry_count,
+                        &data_size, &p->entry) != 0)
+                err_num = -1;
+    }
+    for (i = 0; i < cache->bucket_count; ++i) {
+        const ec_disk_cache_pending*    p;
+
+        for (p = cache->buckets[i]; p != NULL; p = p->next)
+            if (!p->is_file)
+                collect_entry(entries, &entry_count, &data_size, &p->entry);
+    }
+
+    if (map != NULL) {
+        const file_header*  map_header = (const file_header*)map;
+        uint32_t            step = 0;
+
+        for (j = 0; j < map_header->bucket_count; ++j) {
+            const file_entry*   entry = map_entry(map, map_size,
+                    map_buckets(map)[j]);
+
+            for (; entry != NULL && step < map_header->entry_count; ++step) {
+                if (pending_find(cache, entry_key(entry), entry->key_len,
+                            entry->key_hash) == NULL &&
+                        collect_entry(entries, &entry_count, &data_size,
+                            entry) != 0)
+                    break;
+                entry = map_entry(map, map_size, entry->next);
+            }
+        }
+    }
+
+    for (bucket_count = 16; bucket_count < entry_count; bucket_count *= 2)
+        ;
+    offset = sizeof(file_header) + ALIGN8(sizeof(uint32_t) * bucket_count);
+
+    data = (unsigned char*)ec_calloc(1, offset + data_size);
+    if (data == NULL) {
+        ec_free(entries);
+        unmap_file(map, map_size);
+        return -1;
+    }
+
+    header = (file_header*)data;
+    memcpy(header->magic, FILE_MAGIC, sizeof(header->magic));
+    header->format = FILE_FORMAT;
+    header->byte_order = FILE_BYTE_ORDER;
+    header->version[0] = EC_VERSION_MAJOR;
+    header->version[1] = EC_VERSION_MINOR;
+    header->version[2] = EC_VERSION_PATCH;
+    header->bucket_count = bucket_count;
+    header->entry_count = entry_count;
+    header->file_size = offset + data_size;
+
+    buckets = (uint32_t*)(data + sizeof(file_header));
+    for (j = 0; j < entry_count; ++j) {
+        file_entry*         entry = (file_entry*)(data + offset);
+        uint32_t            bucket = (uint32_t)(entries[j]->key_hash %
+                bucket_count);
+
+        memcpy(entry, entries[j], entry_size(entries[j]->key_len,
+                    entries[j]->value_size));
+        entry->next = buckets[bucket];
+        buckets[bucket] = (uint32_t)offset;
+        offset += entry_size(entry->key_len, entry->value_size);
+    }
+
+    if (replace_file(cache->path, data, offset, cache->is_index) != 0)
+        err_num = -1;
+
+    ec_free(data);
+    ec_free(entries);
+    unmap_file(map, map_size);
+
+    return err_num;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+int ec_file_stamp_get(const char* path, ec_file_stamp* stamp)
+{
+    struct stat             st;
+
+    if (stat(path, &st) != 0)
+        return -1;
+
+    memset(stamp, 0, sizeof(ec_file_stamp));
+    stamp->dev = (uint64_t)st.st_dev;
+    stamp->ino = (uint64_t)st.st_ino;
+    stamp->size = (uint64_t)st.st_size;
+    stamp->mtime_sec = (int64_t)st.st_mtime;
+    stamp->ctime_sec = (int64_t)st.st_ctime;
+#ifdef HAVE_STRUCT_STAT_ST_MTIM
+    stamp->mtime_nsec = (int64_t)st.st_mtim.tv_nsec;
+    stamp->ctime_nsec = (int64_t)st.st_ctim.tv_nsec;
+#endif
+
+    return 0;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+int ec_disk_cache_open(ec_disk_cache* cache, const char* path)
+{
+    static const char       default_name[] = "/editorconfig/cache";
+    const char*             dir = NULL;
+    const char*             subdir = "";
+
+    memset(cache, 0, sizeof(ec_disk_cache));
+
+    if (path == NULL) {
+        /* the XDG base directories must be absolute */
+        dir = getenv("XDG_CACHE_HOME");
+        if (dir == NULL || dir[0] != '/') {
+            dir = getenv("HOME");
+            subdir = "/.cache";
+        }
+        if (dir == NULL || dir[0] != '/')
+            return -1;
+
+        cache->path = (char*)ec_malloc(strlen(dir) + strlen(subdir) +
+                sizeof(default_name));
+        if (cache->path == NULL)
+            return -2;
+        strcpy(cache->path, dir);
+        strcat(cache->path, subdir);
+        strcat(cache->path, default_name);
+    } else {
+        cache->path = ec_strdup(path);
+        if (cache->path == NULL)
+            return -2;
+    }
+
+    map_file(cache->path, 1, &cache->map, &cache->map_size);
+    cache->is_open = 1;
+
+    return 0;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+int ec_disk_cache_open_index(ec_disk_cache* cache, const char* path,
+        _Bool is_new)
+{
+    const char*             slash = strrchr(path, '/');
+
+    memset(cache, 0, sizeof(ec_disk_cache));
+
+    if (path[0] != '/')
+        return -1;
+
+    cache->path = ec_strdup(path);
+    cache->root = ec_strndup(path, (size_t)(slash - path));
+    if (cache->path == NULL || cache->root == NULL) {
+        ec_free(cache->path);
+        ec_free(cache->root);
+        return -2;
+    }
+    cache->root_len = (size_t)(slash - path);
+    cache->is_index = 1;
+
+    /* a new index is written even if it is empty */
+    if (!is_new) {
+        map_file(cache->path, 0, &cache->map, &cache->map_size);
+        cache->is_read_only = 1;
+    }
+    cache->is_open = 1;
+
+    return 0;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+int ec_disk_cache_close(ec_disk_cache* cache)
+{
+    size_t                  i;
+    int                     err_num = 0;
+
+    if (!cache->is_open)
+        return 0;
+
+    if (!cache->is_read_only && (cache->count > 0 || cache->is_index))
+        err_num = write_file(cache);
+
+    for (i = 0; i < cache->bucket_count; ++i) {
+        ec_disk_cache_pending*  p = cache->buckets[i];
+
+        while (p != NULL) {
+            ec_disk_cache_pending*  next = p->next;
+
+            ec_free(p);
+            p = next;
+        }
+    }
+    ec_free(cache->buckets);
+    unmap_file(cache->map, cache->map_size);
+    ec_free(cache->path);
+    ec_free(cache->root);
+    memset(cache, 0, sizeof(ec_disk_cache));
+
+    return err_num;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+void ec_disk_cache_discard(ec_disk_cache* cache)
+{
+    cache->is_read_only = 1;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+_Bool ec_disk_cache_covers(const ec_disk_cache* cache, const char* path)
+{
+    return !cache->is_index ||
+        (strncmp(path, cache->root, cache->root_len) == 0 &&
+         path[cache->root_len] == '/');
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+int ec_disk_cache_find(const ec_disk_cache* cache, const char* key,
+        const ec_file_stamp* stamp, const void** value, size_t* value_size)
+{
+    const char*             stored_key;
+    ec_file_stamp           stored_stamp;
+    size_t                  key_len;
+    uint64_t                hash;
+    const file_entry*       entry = NULL;
+    ec_disk_cache_pending*  p;
+
+    if (get_key(cache, key, stamp, &stored_key, &stored_stamp) != 0)
+        return 1;
+    key_len = strlen(stored_key);
+    hash = ec_hash(stored_key, key_len);
+
+    p = pending_find(cache, stored_key, key_len, hash);
+    if (p != NULL)
+        entry = &p->entry;
+    else
+        entry = map_find(cache->map, cache->map_size, stored_key, key_len,
+                hash);
+
+    if (entry == NULL || memcmp(&entry->stamp, &stored_stamp,
+                sizeof(ec_file_stamp)))
+        return 1;
+    if (p == NULL && hash_value(entry_value(entry),
+                (size_t)entry->value_size) != entry->value_hash)
+        return 1;
+
+    *value = entry_value(entry);
+    *value_size = (size_t)entry->value_size;
+
+    return 0;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+int ec_disk_cache_add(ec_disk_cache* cache, const char* key,
+        const ec_file_stamp* stamp, const void* value, size_t value_size)
+{
+    const char*             stored_key;
+    ec_file_stamp           stored_stamp;
+    size_t                  key_len;
+    uint64_t                hash;
+    time_t                  now = time(NULL);
+    ec_disk_cache_pending*  p;
+    ec_disk_cache_pending*  old;
+    char*                   p_key;
+
+    if (cache->is_read_only)
+        return 0;
+    if (get_key(cache, key, stamp, &stored_key, &stored_stamp) != 0)
+        return -1;
+    key_len = strlen(stored_key);
+    hash = ec_hash(stored_key, key_len);
+
+    /* an index is written on purpose, for files that are not edited */
+    if (!cache->is_index && (stamp->mtime_sec + RACY_DELAY > (int64_t)now ||
+                stamp->ctime_sec + RACY_DELAY > (int64_t)now))
+        return 0;
+
+    /* the padding is zeroed, so that the file only depends on the entries */
+    p = (ec_disk_cache_pending*)ec_calloc(1,
+            offsetof(ec_disk_cache_pending, entry) +
+            entry_size(key_len, value_size));
+    if (p == NULL)
+        return -2;
+    p->is_file = key[0] == '/';
+    p->entry.key_hash = hash;
+    p->entry.stamp = stored_stamp;
+    p->entry.value_size = value_size;
+    p->entry.value_hash = hash_value(value, value_size);
+    p->entry.key_len = (uint32_t)key_len;
+    p_key = (char*)(&p->entry + 1);
+    memcpy(p_key, stored_key, key_len);
+    memcpy((char*)entry_value(&p->entry), value, value_size);
+
+    /* replace the entry of the same key, if any */
+    old = pending_find(cache, stored_key, key_len, hash);
+    if (old != NULL) {
+        ec_disk_cache_pending** link =
+            &cache->buckets[hash % cache->bucket_count];
+
+        while (*link != old)
+            link = &(*link)->next;
+        *link = old->next;
+        ec_free(old);
+        -- cache->count;
+    }
+
+    if (pending_insert(cache, p) != 0) {
+        ec_free(p);
+        return -2;
+    }
+
+    return 0;
+}
+
+#else /* HAVE_SYS_MMAN_H */
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+_Bool ec_disk_cache_covers(const ec_disk_cache* cache, const char* path)
+{
+    (void)cache;
+    (void)path;
+    return 0;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+int ec_file_stamp_get(const char* path, ec_file_stamp* stamp)
+{
+    (void)path;
+    memset(stamp, 0, sizeof(ec_file_stamp));
+    return -1;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+int ec_disk_cache_open(ec_disk_cache* cache, const char* path)
+{
+    (void)path;
+    memset(cache, 0, sizeof(ec_disk_cache));
+    return -1;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+int ec_disk_cache_open_index(ec_disk_cache* cache, const char* path,
+        _Bool is_new)
+{
+    (void)path;
+    (void)is_new;
+    memset(cache, 0, sizeof(ec_disk_cache));
+    return -1;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+int ec_disk_cache_close(ec_disk_cache* cache)
+{
+    memset(cache, 0, sizeof(ec_disk_cache));
+    return 0;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+void ec_disk_cache_discard(ec_disk_cache* cache)
+{
+    (void)cache;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+int ec_disk_cache_find(const ec_disk_cache* cache, const char* key,
+        const ec_file_stamp* stamp, const void** value, size_t* value_size)
+{
+    (void)cache;
+    (void)key;
+    (void)stamp;
+    (void)value;
+    (void)value_size;
+    return 1;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+int ec_disk_cache_add(ec_disk_cache* cache, const char* key,
+        const ec_file_stamp* stamp, const void* value, size_t value_size)
+{
+    (void)cache;
+    (void)key;
+    (void)stamp;
+    (void)value;
+    (void)value_size;
+    return 0;
+}
+
+#endif /* HAVE_SYS_MMAN_H */
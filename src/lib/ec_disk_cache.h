@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EC_DISK_CACHE_H__
+#define EC_DISK_CACHE_H__
+
+#include "global.h"
+
+#include <stdint.h>
+
+/*
+ * The identity and version of a file, as given by stat(). A file whose stamp
+ * is unchanged is assumed to have the same content.
+ */
+typedef struct ec_file_stamp
+{
+    uint64_t                dev;
+    uint64_t                ino;
+    uint64_t                size;
+    int64_t                 mtime_sec;
+    int64_t                 mtime_nsec;
+    int64_t                 ctime_sec;
+    int64_t                 ctime_nsec;
+} ec_file_stamp;
+
+/*
+ * An entry added to an ec_disk_cache since its file was mapped. It is
+ * allocated as a single block holding the entry as it is written in the file,
+ * followed by the key and the value.
+ */
+typedef struct ec_disk_cache_pending ec_disk_cache_pending;
+
+/*
+ * A cache kept in a file across processes, which maps a key and a file stamp
+ * to a value. The file is mapped in memory, so that looking up an entry reads
+ * only the pages it lies in. It is never modified in place: the entries added
+ * by a process are written with the entries of the file, as it is when they
+ * are written, to a new file that replaces the old one with rename(). Readers
+ * and writers can thus use the file at the same time, and only the entries of
+ * a writer that replaces the file at the same time as another one are lost.
+ */
+typedef struct ec_disk_cache
+{
+    _Bool                   is_open;
+    /* the path of the file */
+    char*                   path;
+
+    /* Whether the file is the index of a directory tree, whose keys are paths
+     * relative to root, and whose stamps only hold the size and the
+     * modification time, so that it still applies when the tree is copied */
+    _Bool                   is_index;
+    /* Whether no entry can be added, as for an index being read */
+    _Bool                   is_read_only;
+    /* the directory of the index, without the trailing slash */
+    char*                   root;
+    size_t                  root_len;
+
+    /* the file mapped in memory, or NULL if it is missing or invalid */
+    const unsigned char*    map;
+    size_t                  map_size;
+
+    /* the entries added since the file was mapped, in a hash table */
+    ec_disk_cache_pending** buckets;
+    size_t                  bucket_count;
+    size_t                  count;
+} ec_disk_cache;
+
+/*
+ * Set *stamp to the stamp of the file at path. Return 0 if successful and -1
+ * if the file cannot be stat()ed.
+ */
+EDITORCONFIG_LOCAL
+int ec_file_stamp_get(const char* path, ec_file_stamp* stamp);
+
+/*
+ * Map the cache file at path, or at the default path if path is NULL, which is
+ * editorconfig/cache in $XDG_CACHE_HOME or in ~/.cache. A missing or invalid
+ * file is treated as empty, as is a file not owned by the user or writable by
+ * other users, since the compiled regexes of the cache are trusted. Return 0
+ * if successful, -1 if there is no default path or the files cannot be mapped
+ * on this platform, and -2 if an OOM occurs.
+ */
+EDITORCONFIG_LOCAL
+int ec_disk_cache_open(ec_disk_cache* cache, const char* path);
+
+/*
+ * Open the index at path, which must be absolute, to read it, or to write a
+ * new one replacing it if is_new is set. The index applies to the files of the
+ * directory of path and its subdirectories. Return 0 if successful, -1 if path
+ * is not absolute or the files cannot be mapped on this platform, and -2 if an
+ * OOM occurs.
+ */
+EDITORCONFIG_LOCAL
+int ec_disk_cache_open_index(ec_disk_cache* cache, const char* path,
+        _Bool is_new);
+
+/*
+ * Write the entries added to the cache, if any, and unmap the file. The cache
+ * may be opened again afterwards. Return 0 if successful and -1 if the entries
+ * whose keys are full paths cannot all be written, which only matters for a
+ * new index: a cache is only an optimization.
+ */
+EDITORCONFIG_LOCAL
+int ec_disk_cache_close(ec_disk_cache* cache);
+
+/*
+ * Drop the entries added to the cache, so that ec_disk_cache_close() writes
+ * nothing.
+ */
+EDITORCONFIG_LOCAL
+void ec_disk_cache_discard(ec_disk_cache* cache);
+
+/*
+ * Whether path can be a key of cache, which is always the case unless cache is
+ * an index, whose keys are the paths in its directory and its subdirectories.
+ */
+EDITORCONFIG_LOCAL
+_Bool ec_disk_cache_covers(const ec_disk_cache* cache, const char* path);
+
+/*
+ * Look up the entry of key, whose stamp must be equal to stamp. A key of an
+ * index which is a full path is looked up relative to the directory of the
+ * index.
+ * Return 0 and set *value and *value_size if it is found, and return 1
+ * otherwise. The value is valid until the cache is closed, and is aligned on 8
+ * bytes.
+ */
+EDITORCONFIG_LOCAL
+int ec_disk_cache_find(const ec_disk_cache* cache, const char* key,
+        const ec_file_stamp* stamp, const void** value, size_t* value_size);
+
+/*
+ * Add the entry of key, replacing any entry of the same key when the file is
+ * written. The entry is not added if the cache is read only, or, unless it is
+ * an index, if the stamp was changed in the last few seconds, since the file
+ * could then change again without its stamp changing. Return 0 if successful,
+ * -1 if key is a full path outside of the directory of an index and -2 if an
+ * OOM occurs.
+ */
+EDITORCONFIG_LOCAL
+int ec_disk_cache_add(ec_disk_cache* cache, const char* key,
+        const ec_file_stamp* stamp, const void* value, size_t value_size);
+
+#endif /* !EC_DISK_CACHE_H__ */
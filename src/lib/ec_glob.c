@@ -30,24 +30,202 @@
 #include <assert.h>
 #include <ctype.h>
 #include <string.h>
-#include <pcre2.h>
-
-#define utarray_oom() { return -2; }
-#include "utarray.h"
+#ifndef EDITORCONFIG_FIXED_MEMORY
+# include <pcre2.h>
+#endif
+
+#include "ec_alloc.h"
+#ifdef EDITORCONFIG_FIXED_MEMORY
+# include "ec_regex.h"
+#endif
 #include "misc.h"
 #include "util.h"
 
 #include "ec_glob.h"
 
-/* Special characters */
-const char ec_special_chars[] = "?[]\\*-{},";
-
 typedef struct int_pair
 {
     int     num1;
     int     num2;
 } int_pair;
-static const UT_icd ut_int_pair_icd = {sizeof(int_pair),NULL,NULL,NULL};
+
+struct ec_glob_pattern
+{
+#ifdef EDITORCONFIG_FIXED_MEMORY
+    ec_regex *                re;
+    size_t *                  ovector;
+#else
+    pcre2_code *              re;
+    pcre2_match_data *        match_data;
+#endif
+    int_pair *                nums;     /* number ranges */
+    int                       num_count;
+};
+
+#ifdef EDITORCONFIG_FIXED_MEMORY
+/*
+ * PCRE2 is not used, and ec_regex allocates with ec_malloc().
+ */
+EDITORCONFIG_LOCAL
+int ec_glob_set_allocator(_Bool is_custom)
+{
+    (void)is_custom;
+    return 0;
+}
+#else
+
+/* Patterns are compiled with this context when a custom allocator is set, so
+ * that PCRE2 allocates the compiled patterns and their match data with it */
+static pcre2_general_context *  general_context;
+static pcre2_compile_context *  compile_context;
+
+static void * pcre_malloc(PCRE2_SIZE size, void * data)
+{
+    (void)data;
+    return ec_malloc(size);
+}
+
+static void pcre_free(void * ptr, void * data)
+{
+    (void)data;
+    ec_free(ptr);
+}
+
+/*
+ * Make PCRE2 allocate with ec_malloc() if is_custom is true, or with its
+ * default allocator otherwise. Return 0 if successful, and return -2 if an OOM
+ * occurs, in which case PCRE2 uses its default allocator.
+ */
+EDITORCONFIG_LOCAL
+int ec_glob_set_allocator(_Bool is_custom)
+{
+    pcre2_compile_context_free(compile_context);
+    pcre2_general_context_free(general_context);
+    compile_context = NULL;
+    general_context = NULL;
+
+    if (!is_custom)
+        return 0;
+
+    general_context = pcre2_general_context_create(pcre_malloc, pcre_free,
+            NULL);
+    if (general_context != NULL)
+        compile_context = pcre2_compile_context_create(general_context);
+    if (compile_context == NULL)
+    {
+        pcre2_general_context_free(general_context);
+        general_context = NULL;
+        return -2;
+    }
+
+    return 0;
+}
+
+/* The longest PCRE2 version string kept in the keys of the compiled regexes */
+#define VERSION_MAX  64
+
+/* Each compiled regex is encoded with a copy of the character tables of PCRE2,
+ * so that the shorter regexes are compiled faster than they are decoded. They
+ * are not cached. */
+#define CACHED_REGEX_MIN_LENGTH  64
+
+/*
+ * Write to key the key of regex in the caches, which is made of the PCRE2
+ * version and regex, since a compiled regex can only be decoded by the same
+ * version of PCRE2. key must have room for VERSION_MAX more characters than
+ * regex. Return 0 if successful and -1 if the version is too long.
+ */
+static int get_regex_key(const char * regex, char * key)
+{
+    size_t                    len;
+
+    strcpy(key, "pcre2 ");
+    len = strlen(key);
+    if (pcre2_config(PCRE2_CONFIG_VERSION, NULL) > VERSION_MAX - (int)len - 1)
+        return -1;
+    pcre2_config(PCRE2_CONFIG_VERSION, key + len);
+    strcat(key, "\n");
+    strcat(key, regex);
+
+    return 0;
+}
+
+/*
+ * Decode the compiled regex of key from the cache. Return it, or NULL if it is
+ * not found or cannot be decoded.
+ */
+static pcre2_code * load_regex(const ec_glob_cache * cache, const char * key)
+{
+    ec_file_stamp             stamp;
+    const void *              value;
+    size_t                    value_size;
+    pcre2_code *              re;
+
+    memset(&stamp, 0, sizeof(stamp));
+    if (cache->cache == NULL ||
+            ec_disk_cache_find(cache->cache, key, &stamp, &value,
+                &value_size) != 0)
+        return NULL;
+
+    /* the value was checked against its hash when it was found */
+    if (pcre2_serialize_decode(&re, 1, (const uint8_t *)value,
+                general_context) != 1)
+        return NULL;
+
+    return re;
+}
+
+/*
+ * Add the compiled regex re of key to the cache, if any. Return 0 if
+ * successful or if re cannot be encoded, and -2 if an OOM occurs.
+ */
+static int store_regex(const ec_glob_cache * cache, const char * key,
+        const pcre2_code * re)
+{
+    ec_file_stamp             stamp;
+    uint8_t *                 bytes;
+    PCRE2_SIZE                size;
+    int                       ret;
+
+    if (cache->cache == NULL)
+        return 0;
+
+    ret = pcre2_serialize_encode(&re, 1, &bytes, &size, general_context);
+    if (ret == PCRE2_ERROR_NOMEMORY)
+        return -2;
+    if (ret != 1)
+        return 0;
+
+    memset(&stamp, 0, sizeof(stamp));
+    ret = ec_disk_cache_add(cache->cache, key, &stamp, bytes, size);
+    pcre2_serialize_free(bytes);
+
+    return ret == -2 ? -2 : 0;
+}
+#endif /* EDITORCONFIG_FIXED_MEMORY */
+
+/* add a number range to the end of *nums, growing it if needed */
+static int push_int_pair(int_pair ** nums, int * count, int * max_count,
+        int_pair pair)
+{
+    if (*count >= *max_count)
+    {
+        int             new_max_count = *max_count ? *max_count * 2 : 4;
+        int_pair *      new_nums;
+
+        new_nums = (int_pair *) ec_realloc(*nums,
+                sizeof(int_pair) * new_max_count);
+        if (new_nums == NULL)
+            return -2;
+
+        *nums = new_nums;
+        *max_count = new_max_count;
+    }
+
+    (*nums)[(*count) ++] = pair;
+
+    return 0;
+}
 
 /* concatenate the string then move the pointer to the end */
 #define STRING_CAT(p, string, end)  do {    \
@@ -70,31 +248,66 @@ static const UT_icd ut_int_pair_icd = {sizeof(int_pair),NULL,NULL,NULL};
     *(string ++) = new_chr; \
 } while(0)
 
+/*
+ * Whether the characters from start to end, inclusive, are {num1..num2}, where
+ * the numbers may have a sign.
+ */
+static _Bool is_num_range(const char * start, const char * end)
+{
+    const char *    p = start;
+    int             i;
+
+    if (*(p ++) != '{')
+        return 0;
+
+    for (i = 0; i < 2; ++ i)
+    {
+        if (*p == '+' || *p == '-')
+            ++ p;
+        if (!isdigit((unsigned char)*p))
+            return 0;
+        while (isdigit((unsigned char)*p))
+            ++ p;
+        if (i == 0)
+        {
+            if (strncmp(p, "..", 2))
+                return 0;
+            p += 2;
+        }
+    }
+
+    return p == end && *p == '}';
+}
+
 #define PATTERN_MAX  4097
 /*
- * Whether the string matches the given glob pattern. Return 0 if successful, return -1 if a PCRE
- * error or other regex error occurs, and return -2 if an OOM outside PCRE occurs.
+ * Compile the given glob pattern. If cache is not NULL, the compiled regex is
+ * taken from its caches instead of being compiled by PCRE2 when it was added
+ * before, and is added otherwise. Return 0 if successful, return -1 if a PCRE
+ * error or other regex error occurs, and return -2 if an OOM occurs.
  */
 EDITORCONFIG_LOCAL
-int ec_glob(const char *pattern, const char *string)
+int ec_glob_compile(const char *pattern, const ec_glob_cache *cache,
+        ec_glob_pattern **compiled)
 {
-    size_t                    i;
-    int_pair *                p;
     char *                    c;
     char                      pcre_str[2 * PATTERN_MAX] = "^";
     char *                    p_pcre;
     char *                    pcre_str_end;
     int                       brace_level = 0;
     _Bool                     is_in_bracket = 0;
+#ifndef EDITORCONFIG_FIXED_MEMORY
     int                       error_code;
     size_t                    erroffset;
-    pcre2_code *              re;
-    int                       rc;
-    size_t *                  pcre_result;
-    pcre2_match_data *        pcre_match_data = NULL;
+    char                      regex_key[2 * PATTERN_MAX + VERSION_MAX];
+    _Bool                     is_cached = 0;
+#endif
     char                      l_pattern[2 * PATTERN_MAX];
     _Bool                     are_braces_paired = 1;
-    UT_array *                nums;     /* number ranges */
+    int_pair *                nums = NULL;  /* number ranges */
+    int                       num_count = 0;
+    int                       max_num_count = 0;
+    ec_glob_pattern *         glob;
     int                       ret = 0;
     size_t                    pattern_len = strlen(pattern);
 
@@ -133,14 +346,6 @@ int ec_glob(const char *pattern, const char *string)
             are_braces_paired = 0;
     }
 
-    /* used to search for {num1..num2} case */
-    re = pcre2_compile_8((PCRE2_SPTR8)"^\\{[\\+\\-]?\\d+\\.\\.[\\+\\-]?\\d+\\}$", PCRE2_ZERO_TERMINATED, 0,
-            &error_code, &erroffset, NULL);
-    if (!re)        /* failed to compile */
-        return -1;
-
-    utarray_new(nums, &ut_int_pair_icd);
-
     for (c = l_pattern; *c; ++ c)
     {
         switch (*c)
@@ -205,7 +410,8 @@ int ec_glob(const char *pattern, const char *string)
                     STRING_CAT(p_pcre, "\\", pcre_str_end);
                     /* Boundary check for strncat below. */
                     if (pcre_str_end - p_pcre <= right_bracket - c) {
-                        return -1;
+                        ret = -1;
+                        goto cleanup;
                     }
                     strncat(p_pcre, c, right_bracket - c);
                     if (*right_bracket)  /* right_bracket is a bracket */
@@ -280,14 +486,8 @@ int ec_glob(const char *pattern, const char *string)
                     const char *        double_dots;
                     int_pair            pair;
 
-                    pcre2_match_data *  match_data = pcre2_match_data_create_from_pattern(re, NULL);
-
                     /* Check the case of {num1..num2} */
-                    rc = pcre2_match(re, (PCRE2_SPTR8)c, cc - c + 1, 0, 0, match_data, NULL);
-
-                    pcre2_match_data_free(match_data);
-
-                    if (rc < 0)    /* not {num1..num2} case */
+                    if (!is_num_range(c, cc))    /* not {num1..num2} case */
                     {
                         STRING_CAT(p_pcre, "\\{", pcre_str_end);
 
@@ -302,7 +502,12 @@ int ec_glob(const char *pattern, const char *string)
                     pair.num1 = ec_atoi(c + 1);
                     pair.num2 = ec_atoi(double_dots + 2);
 
-                    utarray_push_back(nums, &pair);
+                    if (push_int_pair(&nums, &num_count, &max_num_count,
+                                pair) != 0)
+                    {
+                        ret = -2;
+                        goto cleanup;
+                    }
 
                     STRING_CAT(p_pcre, "([\\+\\-]?\\d+)", pcre_str_end);
                     c = cc;
@@ -346,7 +551,7 @@ int ec_glob(const char *pattern, const char *string)
             break;
 
         default:
-            if (!isalnum(*c))
+            if (!isalnum((unsigned char)*c))
                 STRING_CAT(p_pcre, "\\", pcre_str_end);
 
             ADD_CHAR(p_pcre, *c, pcre_str_end);
@@ -355,63 +560,148 @@ int ec_glob(const char *pattern, const char *string)
 
     ADD_CHAR(p_pcre, '$', pcre_str_end);
 
-    pcre2_code_free(re); /* ^\\d+\\.\\.\\d+$ */
+    glob = (ec_glob_pattern *) ec_malloc(sizeof(ec_glob_pattern));
+    if (glob == NULL)
+    {
+        ret = -2;
+        goto cleanup;
+    }
 
-    re = pcre2_compile((PCRE2_SPTR8)pcre_str, PCRE2_ZERO_TERMINATED, 0, &error_code, &erroffset, NULL);
+#ifdef EDITORCONFIG_FIXED_MEMORY
+    (void)cache;
+    ret = ec_regex_compile(pcre_str, &glob->re);
+    if (ret != 0)
+    {
+        ec_free(glob);
+        goto cleanup;
+    }
 
-    if (!re)        /* failed to compile */
+    glob->ovector = (size_t *) ec_malloc(sizeof(size_t) * 2 *
+            (ec_regex_capture_count(glob->re) + 1));
+    if (glob->ovector == NULL)
     {
-        utarray_free(nums);
-        return -1;
+        ec_regex_free(glob->re);
+        ec_free(glob);
+        ret = -2;
+        goto cleanup;
+    }
+#else
+    if (cache != NULL && (strlen(pcre_str) < CACHED_REGEX_MIN_LENGTH ||
+                get_regex_key(pcre_str, regex_key) != 0))
+        cache = NULL;
+
+    glob->re = cache ? load_regex(cache, regex_key) : NULL;
+    if (glob->re)
+        is_cached = 1;
+    else
+        glob->re = pcre2_compile((PCRE2_SPTR8)pcre_str, PCRE2_ZERO_TERMINATED, 0, &error_code, &erroffset, compile_context);
+
+    if (!glob->re)        /* failed to compile */
+    {
+        ec_free(glob);
+        ret = -1;
+        goto cleanup;
+    }
+
+    glob->match_data = pcre2_match_data_create_from_pattern(glob->re, NULL);
+    if (glob->match_data == NULL ||
+            (cache && !is_cached && store_regex(cache, regex_key, glob->re)))
+    {
+        pcre2_match_data_free(glob->match_data);
+        pcre2_code_free(glob->re);
+        ec_free(glob);
+        ret = -2;
+        goto cleanup;
     }
+#endif
+
+    glob->nums = nums;
+    glob->num_count = num_count;
+    nums = NULL;
+    *compiled = glob;
+
+ cleanup:
+
+    ec_free(nums);
+
+    return ret;
+}
+
+/*
+ * Whether the string matches the compiled glob pattern. Return 0 if
+ * successful, EC_GLOB_NOMATCH if it does not match, a negative PCRE error code
+ * if a PCRE error occurs, and return -2 if an OOM outside PCRE occurs.
+ */
+EDITORCONFIG_LOCAL
+int ec_glob_match(ec_glob_pattern *glob, const char *string)
+{
+    int                       i;
+    int                       rc;
+    size_t *                  pcre_result;
+
+#ifdef EDITORCONFIG_FIXED_MEMORY
+    rc = ec_regex_match(glob->re, string, strlen(string), glob->ovector);
 
-    pcre_match_data = pcre2_match_data_create_from_pattern(re, NULL);
-    rc = pcre2_match(re, (PCRE2_SPTR8)string, strlen(string), 0, 0, pcre_match_data, NULL);
+    if (rc != 0)    /* failed to match */
+        return rc == 1 ? EC_GLOB_NOMATCH : rc;
+
+    pcre_result = glob->ovector;
+#else
+    rc = pcre2_match(glob->re, (PCRE2_SPTR8)string, strlen(string), 0, 0, glob->match_data, NULL);
 
     if (rc < 0)     /* failed to match */
     {
         if (rc == PCRE2_ERROR_NOMATCH)
-            ret = EC_GLOB_NOMATCH;
+            return EC_GLOB_NOMATCH;
         else
-            ret = rc;
-
-        goto cleanup;
+            return rc;
     }
 
+    pcre_result = pcre2_get_ovector_pointer(glob->match_data);
+#endif
+
     /* Whether the numbers are in the desired range? */
-    pcre_result = pcre2_get_ovector_pointer(pcre_match_data);
-    for(p = (int_pair *) utarray_front(nums), i = 1; p;
-            ++ i, p = (int_pair *) utarray_next(nums, p))
+    for (i = 0; i < glob->num_count; ++ i)
     {
-        const char * substring_start = string + pcre_result[2 * i];
-        size_t  substring_length = pcre_result[2 * i + 1] - pcre_result[2 * i];
+        const int_pair * p = &glob->nums[i];
+        const char * substring_start = string + pcre_result[2 * i + 2];
+        size_t  substring_length = pcre_result[2 * i + 3] - pcre_result[2 * i + 2];
         char *       num_string;
         int          num;
 
         /* we don't consider 0digits such as 010 as matched */
         if (*substring_start == '0')
-            break;
+            return EC_GLOB_NOMATCH;
 
-        num_string = strndup(substring_start, substring_length);
-        if (num_string == NULL) {
-          ret = -2;
-          goto cleanup;
-        }
+        num_string = ec_strndup(substring_start, substring_length);
+        if (num_string == NULL)
+            return -2;
         num = ec_atoi(num_string);
-        free(num_string);
+        ec_free(num_string);
 
         if (num < p->num1 || num > p->num2) /* not matched */
-            break;
+            return EC_GLOB_NOMATCH;
     }
 
-    if (p != NULL)      /* numbers not matched */
-        ret = EC_GLOB_NOMATCH;
-
- cleanup:
-
-    pcre2_code_free(re);
-    pcre2_match_data_free(pcre_match_data);
-    utarray_free(nums);
+    return 0;
+}
 
-    return ret;
+/*
+ * Free a compiled glob pattern.
+ */
+EDITORCONFIG_LOCAL
+void ec_glob_free(ec_glob_pattern *glob)
+{
+    if (glob == NULL)
+        return;
+
+#ifdef EDITORCONFIG_FIXED_MEMORY
+    ec_regex_free(glob->re);
+    ec_free(glob->ovector);
+#else
+    pcre2_match_data_free(glob->match_data);
+    pcre2_code_free(glob->re);
+#endif
+    ec_free(glob->nums);
+    ec_free(glob);
 }
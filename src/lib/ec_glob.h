@@ -29,16 +29,34 @@
 
 #include "global.h"
 
+#include "ec_disk_cache.h"
+
 #define EC_GLOB_NOMATCH  1   /* Match failed. */
 
 #ifdef __cplusplus
 extern "C" {
 #endif
+/* A glob pattern compiled by ec_glob_compile(). */
+typedef struct ec_glob_pattern ec_glob_pattern;
+
+/* The open cache the compiled regexes are taken from and added to, or NULL.
+ * It must be a private cache of the user: the indexes are shared files, which
+ * are not trusted to hold compiled regexes. */
+typedef struct ec_glob_cache
+{
+    ec_disk_cache *           cache;
+} ec_glob_cache;
+
 EDITORCONFIG_LOCAL
-int ec_glob(const char * pattern, const char * string);
+int ec_glob_compile(const char * pattern, const ec_glob_cache * cache,
+        ec_glob_pattern ** compiled);
+EDITORCONFIG_LOCAL
+int ec_glob_match(ec_glob_pattern * glob, const char * string);
+EDITORCONFIG_LOCAL
+void ec_glob_free(ec_glob_pattern * glob);
 
-/* Special characters. */
-extern const char ec_special_chars[];
+EDITORCONFIG_LOCAL
+int ec_glob_set_allocator(_Bool is_custom);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "global.h"
+#include "misc.h"
+
+#include <limits.h>
+
+#include "ec_property.h"
+
+typedef struct
+{
+    const char*         name;
+    size_t              len;
+    ec_property_id      id;
+} property_entry;
+
+/*
+ * Perfect hash of the property names: every name in property_table is at the
+ * index given by PROPERTY_HASH(). The coefficients were found by searching
+ * small values until no two names collided, and must be searched again when a
+ * property is added.
+ */
+#define PROPERTY_TABLE_SIZE     10
+#define PROPERTY_HASH(name, len) \
+    ((3 * (unsigned char)(name)[0] + 7 * (unsigned char)(name)[(len) - 1] + \
+      (len)) % PROPERTY_TABLE_SIZE)
+
+#define PROPERTY_ENTRY(name, id)    { name, sizeof(name) - 1, id }
+
+static const property_entry property_table[PROPERTY_TABLE_SIZE] = {
+    PROPERTY_ENTRY("max_line_length", EC_PROPERTY_MAX_LINE_LENGTH),
+    PROPERTY_ENTRY("end_of_line", EC_PROPERTY_END_OF_LINE),
+    PROPERTY_ENTRY("insert_final_newline", EC_PROPERTY_INSERT_FINAL_NEWLINE),
+    PROPERTY_ENTRY("indent_size", EC_PROPERTY_INDENT_SIZE),
+    PROPERTY_ENTRY("indent_style", EC_PROPERTY_INDENT_STYLE),
+    PROPERTY_ENTRY("tab_width", EC_PROPERTY_TAB_WIDTH),
+    PROPERTY_ENTRY("charset", EC_PROPERTY_CHARSET),
+    { NULL, 0, EC_PROPERTY_UNKNOWN },
+    PROPERTY_ENTRY("root", EC_PROPERTY_ROOT),
+    PROPERTY_ENTRY("trim_trailing_whitespace",
+            EC_PROPERTY_TRIM_TRAILING_WHITESPACE)
+};
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+ec_property_id ec_property_lookup(const char* name, size_t len)
+{
+    const property_entry*   entry;
+
+    if (len == 0)
+        return EC_PROPERTY_UNKNOWN;
+
+    entry = &property_table[PROPERTY_HASH(name, len)];
+    if (entry->len != len || memcmp(entry->name, name, len))
+        return EC_PROPERTY_UNKNOWN;
+
+    return entry->id;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+_Bool ec_property_is_value_case_insensitive(ec_property_id id)
+{
+    switch (id) {
+    case EC_PROPERTY_END_OF_LINE:
+    case EC_PROPERTY_INDENT_STYLE:
+    case EC_PROPERTY_INDENT_SIZE:
+    case EC_PROPERTY_INSERT_FINAL_NEWLINE:
+    case EC_PROPERTY_TRIM_TRAILING_WHITESPACE:
+    case EC_PROPERTY_CHARSET:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+/*
+ * Return value if it is a positive decimal integer that fits in an int,
+ * EDITORCONFIG_VALUE_UNSET otherwise.
+ */
+static int parse_positive_int(const char* value)
+{
+    int                 result = 0;
+
+    if (*value == '\0')
+        return EDITORCONFIG_VALUE_UNSET;
+
+    for (; *value != '\0'; ++value) {
+        if (*value < '0' || *value > '9' ||
+                result > (INT_MAX - (*value - '0')) / 10)
+            return EDITORCONFIG_VALUE_UNSET;
+        result = result * 10 + (*value - '0');
+    }
+
+    return result > 0 ? result : EDITORCONFIG_VALUE_UNSET;
+}
+
+/*
+ * Return the tristate value of a boolean property.
+ */
+static editorconfig_bool parse_bool(const char* value)
+{
+    if (!strcmp(value, "true"))
+        return EDITORCONFIG_BOOL_TRUE;
+    if (!strcmp(value, "false"))
+        return EDITORCONFIG_BOOL_FALSE;
+
+    return EDITORCONFIG_BOOL_UNSET;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+void ec_property_parse_value(editorconfig_properties* properties,
+        ec_property_id id, const char* value)
+{
+    /* the values of the case insensitive properties are already lowercased */
+    switch (id) {
+    case EC_PROPERTY_INDENT_STYLE:
+        if (!strcmp(value, "tab"))
+            properties->indent_style = EDITORCONFIG_INDENT_STYLE_TAB;
+        else if (!strcmp(value, "space"))
+            properties->indent_style = EDITORCONFIG_INDENT_STYLE_SPACE;
+        break;
+    case EC_PROPERTY_INDENT_SIZE:
+        if (!strcmp(value, "tab"))
+            properties->indent_size = EDITORCONFIG_VALUE_TAB;
+        else
+            properties->indent_size = parse_positive_int(value);
+        break;
+    case EC_PROPERTY_TAB_WIDTH:
+        properties->tab_width = parse_positive_int(value);
+        break;
+    case EC_PROPERTY_END_OF_LINE:
+        if (!strcmp(value, "lf"))
+            properties->end_of_line = EDITORCONFIG_END_OF_LINE_LF;
+        else if (!strcmp(value, "crlf"))
+            properties->end_of_line = EDITORCONFIG_END_OF_LINE_CRLF;
+        else if (!strcmp(value, "cr"))
+            properties->end_of_line = EDITORCONFIG_END_OF_LINE_CR;
+        break;
+    case EC_PROPERTY_CHARSET:
+        if (!strcmp(value, "latin1"))
+            properties->charset = EDITORCONFIG_CHARSET_LATIN1;
+        else if (!strcmp(value, "utf-8"))
+            properties->charset = EDITORCONFIG_CHARSET_UTF_8;
+        else if (!strcmp(value, "utf-8-bom"))
+            properties->charset = EDITORCONFIG_CHARSET_UTF_8_BOM;
+        else if (!strcmp(value, "utf-16be"))
+            properties->charset = EDITORCONFIG_CHARSET_UTF_16BE;
+        else if (!strcmp(value, "utf-16le"))
+            properties->charset = EDITORCONFIG_CHARSET_UTF_16LE;
+        break;
+    case EC_PROPERTY_TRIM_TRAILING_WHITESPACE:
+        properties->trim_trailing_whitespace = parse_bool(value);
+        break;
+    case EC_PROPERTY_INSERT_FINAL_NEWLINE:
+        properties->insert_final_newline = parse_bool(value);
+        break;
+    case EC_PROPERTY_MAX_LINE_LENGTH:
+        /* the value of max_line_length is not lowercased */
+        if (!strcasecmp(value, "off"))
+            properties->max_line_length = EDITORCONFIG_VALUE_OFF;
+        else
+            properties->max_line_length = parse_positive_int(value);
+        break;
+    default:
+        break;
+    }
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EC_PROPERTY_H__
+#define EC_PROPERTY_H__
+
+#include "global.h"
+
+#include <stddef.h>
+
+#include <editorconfig/editorconfig_handle.h>
+
+/*
+ * The properties defined by the EditorConfig specification.
+ */
+typedef enum ec_property_id
+{
+    EC_PROPERTY_UNKNOWN = 0,
+    EC_PROPERTY_INDENT_STYLE,
+    EC_PROPERTY_INDENT_SIZE,
+    EC_PROPERTY_TAB_WIDTH,
+    EC_PROPERTY_END_OF_LINE,
+    EC_PROPERTY_CHARSET,
+    EC_PROPERTY_TRIM_TRAILING_WHITESPACE,
+    EC_PROPERTY_INSERT_FINAL_NEWLINE,
+    EC_PROPERTY_MAX_LINE_LENGTH,
+    EC_PROPERTY_ROOT
+} ec_property_id;
+
+/*
+ * Return the id of the lowercased property name of length len, or
+ * EC_PROPERTY_UNKNOWN.
+ */
+EDITORCONFIG_LOCAL
+ec_property_id ec_property_lookup(const char* name, size_t len);
+
+/*
+ * Whether the values of the property are case insensitive, in which case
+ * they are lowercased when parsed.
+ */
+EDITORCONFIG_LOCAL
+_Bool ec_property_is_value_case_insensitive(ec_property_id id);
+
+/*
+ * Set the field of properties for id to the parsed value, as resolved for a
+ * file. Unknown properties and invalid values are ignored.
+ */
+EDITORCONFIG_LOCAL
+void ec_property_parse_value(editorconfig_properties* properties,
+        ec_property_id id, const char* value);
+
+#endif /* !EC_PROPERTY_H__ */
@@ -0,0 +1,1184 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "global.h"
+
+#include <ctype.h>
+
+#include "ec_alloc.h"
+#include "ec_regex.h"
+
+/* the largest number of repetitions of a quantifier, as in PCRE2 */
+#define REPEAT_MAX          65535
+/* the largest number of instructions of a program */
+#define PROGRAM_SIZE_MAX    (1 << 20)
+
+/*
+ * The instructions of a compiled regex, run by a backtracking machine.
+ */
+enum
+{
+    OP_CHAR,        /* match the character c */
+    OP_ANY,         /* match any character but a newline */
+    OP_CLASS,       /* match a character of the class x */
+    OP_BOL,         /* match the beginning of the subject */
+    OP_EOL,         /* match the end of the subject, or a final newline */
+    OP_WORD_BOUNDARY, /* match a word boundary, or not one if c is set */
+    OP_SPAN,        /* match x to y, or any number if y < 0, of the next
+                       instruction, as many as possible without
+                       backtracking, and go on after it */
+    OP_SPLIT,       /* go on at x, then at y when backtracking */
+    OP_JMP,         /* go on at x */
+    OP_SAVE,        /* set ovector[x] to the current offset */
+    OP_MATCH        /* the regex matched */
+};
+
+typedef struct
+{
+    unsigned char           op;
+    unsigned char           c;
+    int                     x;
+    int                     y;
+} instruction;
+
+typedef struct
+{
+    unsigned char           bits[32];
+} char_class;
+
+struct ec_regex
+{
+    instruction*            program;
+    int                     program_size;
+    char_class*             classes;
+    int                     class_count;
+    int                     capture_count;
+};
+
+/*
+ * The syntax tree built by the parser, from which the program is generated.
+ */
+enum
+{
+    NODE_CHAR,      /* value is the character */
+    NODE_ANY,
+    NODE_CLASS,     /* value is the class index */
+    NODE_BOL,
+    NODE_EOL,
+    NODE_WORD_BOUNDARY, /* value is set if it is \B */
+    NODE_CONCAT,    /* the children in sequence */
+    NODE_ALT,       /* one of the children, the first ones first */
+    NODE_GROUP,     /* value is the capture index, or -1 */
+    NODE_REPEAT     /* value to max times the child */
+};
+
+typedef struct
+{
+    int                     type;
+    int                     value;
+    /* NODE_REPEAT: the most repetitions, or -1 if there is no limit */
+    int                     max;
+    _Bool                   is_greedy;
+    /* NODE_REPEAT: whether the repetitions are never backtracked into */
+    _Bool                   is_possessive;
+    /* first child, or -1 */
+    int                     child;
+    /* next sibling, or -1 */
+    int                     next;
+} node;
+
+typedef struct
+{
+    const char*             p;
+    node*                   nodes;
+    int                     node_count;
+    int                     max_node_count;
+    char_class*             classes;
+    int                     class_count;
+    int                     max_class_count;
+    int                     capture_count;
+    /* -1 if the pattern is invalid, -2 if an OOM occurred */
+    int                     err_num;
+} parser;
+
+#define CLASS_SET(cls, c)   ((cls)->bits[(unsigned char)(c) >> 3] |= \
+        (unsigned char)(1 << ((unsigned char)(c) & 7)))
+#define CLASS_HAS(cls, c)   ((cls)->bits[(unsigned char)(c) >> 3] & \
+        (1 << ((unsigned char)(c) & 7)))
+
+static int parse_alternatives(parser* ps);
+
+/*
+ * Add a node of the given type and return its index, or -1 if an OOM occurs.
+ */
+static int new_node(parser* ps, int type, int value)
+{
+    node*       n;
+
+    if (ps->node_count == ps->max_node_count) {
+        int     new_max = ps->max_node_count ? ps->max_node_count * 2 : 32;
+        node*   new_nodes = (node*)ec_realloc(ps->nodes,
+                sizeof(node) * new_max);
+
+        if (new_nodes == NULL) {
+            ps->err_num = -2;
+            return -1;
+        }
+        ps->nodes = new_nodes;
+        ps->max_node_count = new_max;
+    }
+
+    n = &ps->nodes[ps->node_count];
+    n->type = type;
+    n->value = value;
+    n->max = 0;
+    n->is_greedy = 1;
+    n->is_possessive = 0;
+    n->child = -1;
+    n->next = -1;
+
+    return ps->node_count ++;
+}
+
+/*
+ * Add an empty character class and return its index, or -1 if an OOM occurs.
+ */
+static int new_class(parser* ps)
+{
+    if (ps->class_count == ps->max_class_count) {
+        int         new_max = ps->max_class_count ?
+            ps->max_class_count * 2 : 8;
+        char_class* new_classes = (char_class*)ec_realloc(ps->classes,
+                sizeof(char_class) * new_max);
+
+        if (new_classes == NULL) {
+            ps->err_num = -2;
+            return -1;
+        }
+        ps->classes = new_classes;
+        ps->max_class_count = new_max;
+    }
+
+    memset(&ps->classes[ps->class_count], 0, sizeof(char_class));
+
+    return ps->class_count ++;
+}
+
+/*
+ * Whether \e is an escape matching a set of characters, such as \d.
+ */
+static _Bool is_escape_set(char e)
+{
+    return e != '\0' && strchr("dDsSwWhHvV", e) != NULL;
+}
+
+/*
+ * If e is the letter of an escape matching a set of characters, such as \d,
+ * add the set to cls and return 1. Return 0 otherwise. Only ASCII letters and
+ * digits are word characters, as with the default tables of PCRE2.
+ */
+static _Bool add_escape_set(char_class* cls, char e)
+{
+    char_class      set;
+    int             c;
+
+    memset(&set, 0, sizeof(set));
+    switch (e) {
+    case 'd': case 'D':
+        for (c = '0'; c <= '9'; ++c)
+            CLASS_SET(&set, c);
+        break;
+    case 's': case 'S':
+        CLASS_SET(&set, ' ');
+        for (c = '\t'; c <= '\r'; ++c)
+            CLASS_SET(&set, c);
+        break;
+    case 'w': case 'W':
+        for (c = 0; c < 128; ++c)
+            if (isalnum(c) || c == '_')
+                CLASS_SET(&set, c);
+        break;
+    case 'h': case 'H':
+        CLASS_SET(&set, ' ');
+        CLASS_SET(&set, '\t');
+        CLASS_SET(&set, 0xa0);
+        break;
+    case 'v': case 'V':
+        for (c = '\n'; c <= '\r'; ++c)
+            CLASS_SET(&set, c);
+        CLASS_SET(&set, 0x85);
+        break;
+    default:
+        return 0;
+    }
+
+    for (c = 0; c < 32; ++c)
+        cls->bits[c] |= (e >= 'A' && e <= 'Z') ?
+            (unsigned char)~set.bits[c] : set.bits[c];
+
+    return 1;
+}
+
+static int hex_digit(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+/*
+ * Return the character of the escape after the backslash at *p and move *p
+ * past it. Return -1 if it is a letter or a digit without a meaning known
+ * here. \b is a backspace in a character class.
+ */
+static int parse_escape_char(const char** p, _Bool is_in_class)
+{
+    char        e = *((*p) ++);
+    int         value = 0;
+    int         digit;
+
+    switch (e) {
+    case 'a': return '\a';
+    case 'b': return is_in_class ? '\b' : -1;
+    case 'e': return 0x1b;
+    case 'f': return '\f';
+    case 'n': return '\n';
+    case 'r': return '\r';
+    case 't': return '\t';
+    case 'c':
+        /* \cx is the control character of x */
+        if (**p < 32 || **p > 126)
+            return -1;
+        return toupper((unsigned char)*((*p) ++)) ^ 0x40;
+    case 'x':
+        /* \xhh or \x{h...} */
+        if (**p == '{') {
+            const char*     q = *p + 1;
+
+            for (; (digit = hex_digit(*q)) >= 0; ++q) {
+                value = value * 16 + digit;
+                if (value > 0xff)
+                    return -1;
+            }
+            if (q == *p + 1 || *q != '}')
+                return -1;
+            *p = q + 1;
+            return value;
+        }
+        for (; value < 16 && (digit = hex_digit(**p)) >= 0; ++(*p))
+            value = value * 16 + digit;
+        return value;
+    default:
+        return isalnum((unsigned char)e) ? -1 : (unsigned char)e;
+    }
+}
+
+/*
+ * If p starts a POSIX class such as [:alpha:], add it to cls and return its
+ * length. Return 0 if p does not start one, and -1 if its name is unknown.
+ */
+static int add_posix_class(char_class* cls, const char* p)
+{
+    static const char* const    names[] = {
+        "alpha", "digit", "alnum", "space", "upper", "lower", "punct",
+        "xdigit", "cntrl", "print", "graph", "blank", "word", "ascii", NULL
+    };
+    const char*     end;
+    size_t          len;
+    int             i;
+    int             c;
+
+    if (p[0] != '[' || p[1] != ':')
+        return 0;
+    /* find the ":]", as PCRE2 does, skipping \] and \\ and giving up at
+     * a ']' or a "[:" */
+    for (end = p + 2; end[0] != ':' || end[1] != ']'; ++end) {
+        if (end[0] == '\\' && (end[1] == ']' || end[1] == '\\'))
+            ++end;
+        else if (end[0] == '\0' || end[0] == ']' ||
+                (end[0] == '[' && end[1] == ':'))
+            return 0;
+    }
+    len = (size_t)(end - (p + 2));
+
+    for (i = 0; names[i] != NULL; ++i)
+        if (strlen(names[i]) == len && !strncmp(names[i], p + 2, len))
+            break;
+    if (names[i] == NULL)
+        return -1;
+
+    for (c = 0; c < 128; ++c) {
+        int     is_in;
+
+        switch (i) {
+        case 0: is_in = isalpha(c); break;
+        case 1: is_in = isdigit(c); break;
+        case 2: is_in = isalnum(c); break;
+        case 3: is_in = isspace(c); break;
+        case 4: is_in = isupper(c); break;
+        case 5: is_in = islower(c); break;
+        case 6: is_in = ispunct(c); break;
+        case 7: is_in = isxdigit(c); break;
+        case 8: is_in = iscntrl(c); break;
+        case 9: is_in = isprint(c); break;
+        case 10: is_in = isgraph(c); break;
+        case 11: is_in = c == ' ' || c == '\t'; break;
+        case 12: is_in = isalnum(c) || c == '_'; break;
+        default: is_in = 1; break;
+        }
+        if (is_in)
+            CLASS_SET(cls, c);
+    }
+
+    return (int)(end + 2 - p);
+}
+
+/*
+ * Parse a character class, after its '['.
+ */
+static int parse_class(parser* ps)
+{
+    int             index = new_class(ps);
+    char_class*     cls;
+    _Bool           is_negated = 0;
+    _Bool           is_first = 1;
+    int             i;
+
+    if (index < 0)
+        return -1;
+    cls = &ps->classes[index];
+
+    if (*ps->p == '^') {
+        is_negated = 1;
+        ++ ps->p;
+    }
+
+    for (;; is_first = 0) {
+        int         lo;
+        int         hi;
+        int         posix_len;
+
+        if (*ps->p == '\0')
+            goto invalid;
+        if (*ps->p == ']' && !is_first) {
+            ++ ps->p;
+            break;
+        }
+
+        posix_len = add_posix_class(cls, ps->p);
+        if (posix_len < 0)
+            goto invalid;
+        if (posix_len > 0) {
+            ps->p += posix_len;
+            continue;
+        }
+
+        if (*ps->p == '\\') {
+            if (ps->p[1] == '\0')
+                goto invalid;
+            ++ ps->p;
+            if (add_escape_set(cls, *ps->p)) {
+                ++ ps->p;
+                continue;
+            }
+            lo = parse_escape_char(&ps->p, 1);
+            if (lo < 0)
+                goto invalid;
+        } else
+            lo = (unsigned char)*(ps->p ++);
+
+        if (ps->p[0] != '-' || ps->p[1] == ']' || ps->p[1] == '\0') {
+            CLASS_SET(cls, lo);
+            continue;
+        }
+
+        /* a range */
+        if (ps->p[1] == '\\') {
+            if (ps->p[2] == '\0' || is_escape_set(ps->p[2]))
+                goto invalid;
+            ps->p += 2;
+            hi = parse_escape_char(&ps->p, 1);
+            if (hi < 0)
+                goto invalid;
+        } else if (ps->p[1] == '[' && ps->p[2] == ':')
+            goto invalid;
+        else {
+            hi = (unsigned char)ps->p[1];
+            ps->p += 2;
+        }
+        if (lo > hi)
+            goto invalid;
+        for (; lo <= hi; ++lo)
+            CLASS_SET(cls, lo);
+    }
+
+    if (is_negated)
+        for (i = 0; i < 32; ++i)
+            cls->bits[i] = (unsigned char)~cls->bits[i];
+
+    return new_node(ps, NODE_CLASS, index);
+
+invalid:
+    ps->err_num = -1;
+    return -1;
+}
+
+/*
+ * Parse a decimal number of at most REPEAT_MAX. Return -1 if there is none.
+ */
+static int parse_count(const char** p)
+{
+    int         count = 0;
+
+    if (!isdigit((unsigned char)**p))
+        return -1;
+    for (; isdigit((unsigned char)**p); ++ *p) {
+        count = count * 10 + (**p - '0');
+        if (count > REPEAT_MAX)
+            return REPEAT_MAX + 1;
+    }
+
+    return count;
+}
+
+/*
+ * Parse a quantifier at ps->p, if any, into *min and *max. Return 1 if there
+ * is one, 0 if there is none and -1 if it is invalid. A '{' that does not
+ * start a valid quantifier is a literal, as in PCRE2.
+ */
+static int parse_quantifier(parser* ps, int* min, int* max)
+{
+    const char*     p = ps->p;
+
+    switch (*p) {
+    case '*':
+        *min = 0;
+        *max = -1;
+        ++ p;
+        break;
+    case '+':
+        *min = 1;
+        *max = -1;
+        ++ p;
+        break;
+    case '?':
+        *min = 0;
+        *max = 1;
+        ++ p;
+        break;
+    case '{':
+        ++ p;
+        *min = parse_count(&p);
+        if (*min < 0)
+            return 0;
+        if (*p == '}')
+            *max = *min;
+        else if (*p == ',' && p[1] == '}') {
+            *max = -1;
+            ++ p;
+        } else if (*p == ',') {
+            ++ p;
+            *max = parse_count(&p);
+            if (*max < 0 || *p != '}')
+                return 0;
+        } else
+            return 0;
+        ++ p;
+        if (*min > REPEAT_MAX || *max > REPEAT_MAX ||
+                (*max >= 0 && *min > *max))
+            return -1;
+        break;
+    default:
+        return 0;
+    }
+
+    ps->p = p;
+
+    return 1;
+}
+
+/*
+ * Parse an item and its quantifier.
+ */
+static int parse_item(parser* ps)
+{
+    int             item;
+    int             min;
+    int             max;
+    int             rc;
+    char            c = *(ps->p ++);
+
+    switch (c) {
+    case '(':
+        if (*ps->p == '?') {
+            if (ps->p[1] != ':')
+                goto invalid;
+            ps->p += 2;
+            item = new_node(ps, NODE_GROUP, -1);
+        } else
+            item = new_node(ps, NODE_GROUP, ++ ps->capture_count);
+        if (item < 0)
+            return -1;
+        rc = parse_alternatives(ps);
+        if (rc < 0)
+            return -1;
+        ps->nodes[item].child = rc;
+        if (*ps->p != ')')
+            goto invalid;
+        ++ ps->p;
+        break;
+    case '[':
+        item = parse_class(ps);
+        break;
+    case '.':
+        item = new_node(ps, NODE_ANY, 0);
+        break;
+    case '^':
+        item = new_node(ps, NODE_BOL, 0);
+        break;
+    case '$':
+        item = new_node(ps, NODE_EOL, 0);
+        break;
+    case '\\':
+        c = *ps->p;
+        if (c == '\0')
+            goto invalid;
+        if (is_escape_set(c)) {
+            int     index = new_class(ps);
+
+            ++ ps->p;
+            if (index < 0)
+                return -1;
+            add_escape_set(&ps->classes[index], c);
+            item = new_node(ps, NODE_CLASS, index);
+            break;
+        }
+        if (c == 'b' || c == 'B') {
+            ++ ps->p;
+            item = new_node(ps, NODE_WORD_BOUNDARY, c == 'B');
+            break;
+        }
+        rc = parse_escape_char(&ps->p, 0);
+        if (rc < 0)
+            goto invalid;
+        item = new_node(ps, NODE_CHAR, rc);
+        break;
+    case '*':
+    case '+':
+    case '?':
+        goto invalid;       /* nothing to repeat */
+    case '{':
+        -- ps->p;
+        rc = parse_quantifier(ps, &min, &max);
+        if (rc != 0)
+            goto invalid;
+        ++ ps->p;
+        item = new_node(ps, NODE_CHAR, '{');
+        break;
+    default:
+        item = new_node(ps, NODE_CHAR, (unsigned char)c);
+        break;
+    }
+    if (item < 0)
+        return -1;
+
+    rc = parse_quantifier(ps, &min, &max);
+    if (rc < 0)
+        goto invalid;
+    if (rc > 0) {
+        int     repeat;
+
+        if (ps->nodes[item].type == NODE_BOL ||
+                ps->nodes[item].type == NODE_EOL ||
+                ps->nodes[item].type == NODE_WORD_BOUNDARY)
+            goto invalid;
+        repeat = new_node(ps, NODE_REPEAT, min);
+        if (repeat < 0)
+            return -1;
+        ps->nodes[repeat].max = max;
+        ps->nodes[repeat].child = item;
+        if (*ps->p == '?') {
+            ps->nodes[repeat].is_greedy = 0;
+            ++ ps->p;
+        } else if (*ps->p == '+') {
+            /* possessive, only supported for a single character */
+            if (ps->nodes[item].type != NODE_CHAR &&
+                    ps->nodes[item].type != NODE_ANY &&
+                    ps->nodes[item].type != NODE_CLASS)
+                goto invalid;
+            ps->nodes[repeat].is_possessive = 1;
+            ++ ps->p;
+        }
+        item = repeat;
+
+        /* a quantifier cannot be quantified */
+        if (parse_quantifier(ps, &min, &max) != 0)
+            goto invalid;
+    }
+
+    return item;
+
+invalid:
+    ps->err_num = -1;
+    return -1;
+}
+
+/*
+ * Parse a sequence of items, up to a '|', a ')' or the end of the pattern.
+ */
+static int parse_sequence(parser* ps)
+{
+    int         sequence = new_node(ps, NODE_CONCAT, 0);
+    int         last = -1;
+
+    if (sequence < 0)
+        return -1;
+
+    while (*ps->p != '\0' && *ps->p != '|' && *ps->p != ')') {
+        int     item = parse_item(ps);
+
+        if (item < 0)
+            return -1;
+        if (last < 0)
+            ps->nodes[sequence].child = item;
+        else
+            ps->nodes[last].next = item;
+        last = item;
+    }
+
+    return sequence;
+}
+
+/*
+ * Parse sequences separated by '|'.
+ */
+static int parse_alternatives(parser* ps)
+{
+    int         alternatives = new_node(ps, NODE_ALT, 0);
+    int         last;
+
+    if (alternatives < 0)
+        return -1;
+
+    last = parse_sequence(ps);
+    if (last < 0)
+        return -1;
+    ps->nodes[alternatives].child = last;
+
+    while (*ps->p == '|') {
+        int     sequence;
+
+        ++ ps->p;
+        sequence = parse_sequence(ps);
+        if (sequence < 0)
+            return -1;
+        ps->nodes[last].next = sequence;
+        last = sequence;
+    }
+
+    return alternatives;
+}
+
+/*
+ * Return the number of instructions generated for the node, or -1 if it is
+ * more than PROGRAM_SIZE_MAX.
+ */
+static long node_size(const node* nodes, int index)
+{
+    const node*     n = &nodes[index];
+    long            size = 0;
+    long            child_size;
+    int             child;
+
+    switch (n->type) {
+    case NODE_CONCAT:
+    case NODE_ALT:
+        for (child = n->child; child >= 0; child = nodes[child].next) {
+            child_size = node_size(nodes, child);
+            if (child_size < 0)
+                return -1;
+            size += child_size;
+            /* a split before and a jump after all the alternatives but the
+             * last one */
+            if (n->type == NODE_ALT && nodes[child].next >= 0)
+                size += 2;
+        }
+        break;
+    case NODE_GROUP:
+        size = node_size(nodes, n->child);
+        if (size >= 0 && n->value >= 0)
+            size += 2;
+        break;
+    case NODE_REPEAT:
+        if (n->is_possessive) {
+            size = 2;
+            break;
+        }
+        child_size = node_size(nodes, n->child);
+        if (child_size < 0)
+            return -1;
+        size = child_size * n->value;
+        if (n->max < 0)
+            size += child_size + 2;
+        else
+            size += (child_size + 1) * (n->max - n->value);
+        break;
+    default:
+        size = 1;
+        break;
+    }
+
+    return size > PROGRAM_SIZE_MAX ? -1 : size;
+}
+
+/*
+ * Make split try the repeated instructions at body first if is_greedy is true,
+ * and the ones that follow at out first otherwise.
+ */
+static void set_split(instruction* split, int body, int out, _Bool is_greedy)
+{
+    split->op = OP_SPLIT;
+    split->c = 0;
+    split->x = is_greedy ? body : out;
+    split->y = is_greedy ? out : body;
+}
+
+static instruction* emit(instruction* pc, int op, int c, int x, int y)
+{
+    pc->op = (unsigned char)op;
+    pc->c = (unsigned char)c;
+    pc->x = x;
+    pc->y = y;
+
+    return pc + 1;
+}
+
+/*
+ * Generate the instructions of the node at pc and return the end of them.
+ */
+static instruction* generate(const node* nodes, int index,
+        instruction* program, instruction* pc)
+{
+    const node*     n = &nodes[index];
+    int             child;
+    int             i;
+
+    switch (n->type) {
+    case NODE_CHAR:
+        return emit(pc, OP_CHAR, n->value, 0, 0);
+    case NODE_ANY:
+        return emit(pc, OP_ANY, 0, 0, 0);
+    case NODE_CLASS:
+        return emit(pc, OP_CLASS, 0, n->value, 0);
+    case NODE_BOL:
+        return emit(pc, OP_BOL, 0, 0, 0);
+    case NODE_EOL:
+        return emit(pc, OP_EOL, 0, 0, 0);
+    case NODE_WORD_BOUNDARY:
+        return emit(pc, OP_WORD_BOUNDARY, n->value, 0, 0);
+    case NODE_CONCAT:
+        for (child = n->child; child >= 0; child = nodes[child].next)
+            pc = generate(nodes, child, program, pc);
+        return pc;
+    case NODE_ALT:
+        {
+            /* the jumps to the end of the alternatives, fixed at the end */
+            instruction*    jump = NULL;
+
+            for (child = n->child; child >= 0; child = nodes[child].next) {
+                instruction*    split = pc;
+
+                if (nodes[child].next < 0) {
+                    pc = generate(nodes, child, program, pc);
+                    break;
+                }
+                pc = generate(nodes, child, program, pc + 1);
+                set_split(split, (int)(split + 1 - program),
+                        (int)(pc + 1 - program), 1);
+                /* chain the jumps through their y field */
+                emit(pc, OP_JMP, 0, 0, jump ? (int)(jump - program) : -1);
+                jump = pc ++;
+            }
+            while (jump != NULL) {
+                instruction*    previous = jump->y >= 0 ?
+                    program + jump->y : NULL;
+
+                jump->x = (int)(pc - program);
+                jump->y = 0;
+                jump = previous;
+            }
+            return pc;
+        }
+    case NODE_GROUP:
+        if (n->value >= 0)
+            pc = emit(pc, OP_SAVE, 0, 2 * n->value, 0);
+        pc = generate(nodes, n->child, program, pc);
+        if (n->value >= 0)
+            pc = emit(pc, OP_SAVE, 0, 2 * n->value + 1, 0);
+        return pc;
+    case NODE_REPEAT:
+        if (n->is_possessive) {
+            pc = emit(pc, OP_SPAN, 0, n->value, n->max);
+            return generate(nodes, n->child, program, pc);
+        }
+        for (i = 0; i < n->value; ++i)
+            pc = generate(nodes, n->child, program, pc);
+        if (n->max < 0) {
+            instruction*    split = pc;
+
+            pc = generate(nodes, n->child, program, pc + 1);
+            pc = emit(pc, OP_JMP, 0, (int)(split - program), 0);
+            set_split(split, (int)(split + 1 - program), (int)(pc - program),
+                    n->is_greedy);
+        } else {
+            /* the optional repetitions, which all skip to the end */
+            instruction*    first = pc;
+            long            step = node_size(nodes, n->child) + 1;
+
+            for (i = n->value; i < n->max; ++i)
+                pc = generate(nodes, n->child, program, pc + 1);
+            for (i = 0; i < n->max - n->value; ++i) {
+                instruction*    split = first + step * i;
+
+                set_split(split, (int)(split + 1 - program),
+                        (int)(pc - program), n->is_greedy);
+            }
+        }
+        return pc;
+    }
+
+    return pc;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+int ec_regex_compile(const char* pattern, ec_regex** regex)
+{
+    parser          ps;
+    int             root;
+    long            size;
+    ec_regex*       re = NULL;
+    instruction*    end;
+
+    memset(&ps, 0, sizeof(ps));
+    ps.p = pattern;
+
+    root = parse_alternatives(&ps);
+    if (root >= 0 && *ps.p != '\0')      /* an unmatched ')' */
+        ps.err_num = -1;
+    if (ps.err_num != 0)
+        goto cleanup;
+
+    size = node_size(ps.nodes, root);
+    if (size < 0) {
+        ps.err_num = -1;
+        goto cleanup;
+    }
+
+    re = (ec_regex*)ec_calloc(1, sizeof(ec_regex));
+    if (re == NULL) {
+        ps.err_num = -2;
+        goto cleanup;
+    }
+    re->program = (instruction*)ec_malloc(sizeof(instruction) * (size + 1));
+    if (re->program == NULL) {
+        ps.err_num = -2;
+        goto cleanup;
+    }
+
+    end = generate(ps.nodes, root, re->program, re->program);
+    emit(end, OP_MATCH, 0, 0, 0);
+    re->program_size = (int)size + 1;
+    re->classes = ps.classes;
+    re->class_count = ps.class_count;
+    re->capture_count = ps.capture_count;
+    ps.classes = NULL;
+
+    *regex = re;
+    re = NULL;
+
+cleanup:
+    ec_free(ps.nodes);
+    ec_free(ps.classes);
+    ec_regex_free(re);
+
+    return ps.err_num;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+int ec_regex_capture_count(const ec_regex* regex)
+{
+    return regex->capture_count;
+}
+
+/*
+ * A state of the machine to backtrack to. A negative pc means that
+ * ovector[-pc - 1] must be restored to sp instead.
+ */
+typedef struct
+{
+    int                     pc;
+    size_t                  sp;
+} backtrack_state;
+
+/* the states kept in the stack frame of ec_regex_match() before allocating */
+#define STACK_BUFFER_SIZE   64
+/* the bytes of visited states kept in the stack frame before allocating */
+#define VISITED_BUFFER_SIZE 512
+
+/* whether the character at offset i is a word character, where the offsets
+ * out of the subject are not */
+#define IS_WORD(subject, length, i) \
+    ((i) < (length) && \
+     (isalnum((unsigned char)(subject)[i]) || (subject)[i] == '_'))
+
+typedef struct
+{
+    backtrack_state*        states;
+    size_t                  count;
+    size_t                  max_count;
+    backtrack_state*        buffer;
+} backtrack_stack;
+
+/*
+ * Whether c matches the OP_CHAR, OP_ANY or OP_CLASS instruction in.
+ */
+static _Bool match_char(const ec_regex* regex, const instruction* in, char c)
+{
+    switch (in->op) {
+    case OP_CHAR:
+        return (unsigned char)c == in->c;
+    case OP_ANY:
+        return c != '\n';
+    default:
+        return CLASS_HAS(&regex->classes[in->x], c) != 0;
+    }
+}
+
+static int push_state(backtrack_stack* stack, int pc, size_t sp)
+{
+    if (stack->count == stack->max_count) {
+        size_t              new_max = stack->max_count * 2;
+        backtrack_state*    new_states;
+
+        if (stack->states == stack->buffer) {
+            new_states = (backtrack_state*)ec_malloc(
+                    sizeof(backtrack_state) * new_max);
+            if (new_states != NULL)
+                memcpy(new_states, stack->states,
+                        sizeof(backtrack_state) * stack->count);
+        } else
+            new_states = (backtrack_state*)ec_realloc(stack->states,
+                    sizeof(backtrack_state) * new_max);
+        if (new_states == NULL)
+            return -2;
+        stack->states = new_states;
+        stack->max_count = new_max;
+    }
+
+    stack->states[stack->count].pc = pc;
+    stack->states[stack->count].sp = sp;
+    ++ stack->count;
+
+    return 0;
+}
+
+/*
+ * See header file
+ *
+ * The machine runs the program depth first, taking the first branch of each
+ * split and pushing the second one, so the first match found is the one
+ * PCRE2 finds. Whether a state, a pair of an instruction and an offset, leads
+ * to a match does not depend on how it is reached, so every state is run at
+ * most once, which bounds the time by the size of the program times the
+ * length of the subject.
+ */
+EDITORCONFIG_LOCAL
+int ec_regex_match(const ec_regex* regex, const char* subject, size_t length,
+        size_t* ovector)
+{
+    backtrack_state     stack_buffer[STACK_BUFFER_SIZE];
+    unsigned char       visited_buffer[VISITED_BUFFER_SIZE];
+    backtrack_stack     stack;
+    unsigned char*      visited = visited_buffer;
+    size_t              visited_size;
+    size_t              start;
+    int                 i;
+    int                 ret = 1;
+
+    if (length >= (size_t)-1 / 8 / (size_t)regex->program_size - 1)
+        return -2;
+    visited_size = ((size_t)regex->program_size * (length + 1) + 7) / 8;
+    if (visited_size > sizeof(visited_buffer)) {
+        visited = (unsigned char*)ec_malloc(visited_size);
+        if (visited == NULL)
+            return -2;
+    }
+    memset(visited, 0, visited_size);
+
+    stack.states = stack.buffer = stack_buffer;
+    stack.count = 0;
+    stack.max_count = STACK_BUFFER_SIZE;
+
+    for (start = 0; start <= length && ret == 1; ++start) {
+        for (i = 2; i < 2 * (regex->capture_count + 1); ++i)
+            ovector[i] = EC_REGEX_UNSET;
+
+        if (push_state(&stack, 0, start) != 0) {
+            ret = -2;
+            break;
+        }
+
+        while (stack.count > 0 && ret == 1) {
+            backtrack_state     state = stack.states[-- stack.count];
+            int                 pc = state.pc;
+            size_t              sp = state.sp;
+
+            if (pc < 0) {
+                ovector[-pc - 1] = sp;
+                continue;
+            }
+
+            for (;;) {
+                const instruction*  in = &regex->program[pc];
+                size_t              bit = (size_t)pc * (length + 1) + sp;
+
+                if (visited[bit >> 3] & (1 << (bit & 7)))
+                    break;
+                visited[bit >> 3] |= (unsigned char)(1 << (bit & 7));
+
+                switch (in->op) {
+                case OP_CHAR:
+                    if (sp == length || (unsigned char)subject[sp] != in->c)
+                        goto next_state;
+                    ++ pc;
+                    ++ sp;
+                    continue;
+                case OP_ANY:
+                    if (sp == length || subject[sp] == '\n')
+                        goto next_state;
+                    ++ pc;
+                    ++ sp;
+                    continue;
+                case OP_CLASS:
+                    if (sp == length ||
+                            !CLASS_HAS(&regex->classes[in->x], subject[sp]))
+                        goto next_state;
+                    ++ pc;
+                    ++ sp;
+                    continue;
+                case OP_BOL:
+                    if (sp != 0)
+                        goto next_state;
+                    ++ pc;
+                    continue;
+                case OP_EOL:
+                    if (sp != length &&
+                            (sp + 1 != length || subject[sp] != '\n'))
+                        goto next_state;
+                    ++ pc;
+                    continue;
+                case OP_WORD_BOUNDARY:
+                    if ((IS_WORD(subject, length, sp - 1) ==
+                            IS_WORD(subject, length, sp)) != in->c)
+                        goto next_state;
+                    ++ pc;
+                    continue;
+                case OP_SPAN:
+                    {
+                        size_t      count = 0;
+
+                        while ((in->y < 0 || count < (size_t)in->y) &&
+                                sp + count < length &&
+                                match_char(regex, in + 1, subject[sp + count]))
+                            ++ count;
+                        if (count < (size_t)in->x)
+                            goto next_state;
+                        pc += 2;
+                        sp += count;
+                    }
+                    continue;
+                case OP_SPLIT:
+                    if (push_state(&stack, in->y, sp) != 0) {
+                        ret = -2;
+                        goto next_state;
+                    }
+                    pc = in->x;
+                    continue;
+                case OP_JMP:
+                    pc = in->x;
+                    continue;
+                case OP_SAVE:
+                    if (push_state(&stack, -in->x - 1, ovector[in->x]) != 0) {
+                        ret = -2;
+                        goto next_state;
+                    }
+                    ovector[in->x] = sp;
+                    ++ pc;
+                    continue;
+                case OP_MATCH:
+                    ovector[0] = start;
+                    ovector[1] = sp;
+                    ret = 0;
+                    goto next_state;
+                }
+            }
+next_state:
+            ;
+        }
+        stack.count = 0;
+    }
+
+    if (stack.states != stack.buffer)
+        ec_free(stack.states);
+    if (visited != visited_buffer)
+        ec_free(visited);
+
+    return ret;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+void ec_regex_free(ec_regex* regex)
+{
+    if (regex == NULL)
+        return;
+
+    ec_free(regex->program);
+    ec_free(regex->classes);
+    ec_free(regex);
+}
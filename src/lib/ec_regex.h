@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EC_REGEX_H__
+#define EC_REGEX_H__
+
+#include "global.h"
+
+#include <stddef.h>
+
+/*
+ * A small backtracking regular expression matcher, used instead of PCRE2 in
+ * the fixed memory build. It supports the subset of the PCRE2 syntax that
+ * ec_glob_compile() translates globs to, with the same semantics: literals,
+ * escapes, ".", character classes, "^", "$", "\b", "\B", groups,
+ * alternatives and greedy or lazy quantifiers, which may be possessive when
+ * they repeat a single character. Other constructs, such as lookarounds and
+ * back references, are rejected when compiled.
+ *
+ * All its memory comes from ec_malloc().
+ */
+typedef struct ec_regex ec_regex;
+
+/* value of the offsets of a capturing group that did not participate */
+#define EC_REGEX_UNSET      (~(size_t)0)
+
+/*
+ * Compile the null-terminated pattern. Return 0 if successful, -1 if the
+ * pattern is invalid or not supported, and -2 if an OOM occurs.
+ */
+EDITORCONFIG_LOCAL
+int ec_regex_compile(const char* pattern, ec_regex** regex);
+
+/*
+ * Return the number of capturing groups of regex.
+ */
+EDITORCONFIG_LOCAL
+int ec_regex_capture_count(const ec_regex* regex);
+
+/*
+ * Search subject for the first match of regex, like pcre2_match() does. On a
+ * match, ovector, which has 2 * (ec_regex_capture_count() + 1) elements, is
+ * filled with the offsets of the match and of each capturing group. Return 0
+ * on a match, 1 if there is none and -2 if an OOM occurs.
+ */
+EDITORCONFIG_LOCAL
+int ec_regex_match(const ec_regex* regex, const char* subject, size_t length,
+        size_t* ovector);
+
+/*
+ * Free a compiled regex.
+ */
+EDITORCONFIG_LOCAL
+void ec_regex_free(ec_regex* regex);
+
+#endif /* !EC_REGEX_H__ */
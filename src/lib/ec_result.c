@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "global.h"
+#include "misc.h"
+
+#include "ec_alloc.h"
+#include "ec_result.h"
+
+/*
+ * Return the hash of properties, computed over the names and values with
+ * their null characters, in order.
+ */
+static uint64_t hash_properties(const ec_conf_property* const* properties,
+        int count)
+{
+    uint64_t        hash = EC_HASH_INIT;
+    int             i;
+
+    for (i = 0; i < count; ++i) {
+        hash = ec_hash_update(hash, properties[i]->name,
+                properties[i]->name_len + 1);
+        hash = ec_hash_update(hash, properties[i]->value,
+                properties[i]->value_len + 1);
+    }
+
+    return hash;
+}
+
+/*
+ * Whether result holds exactly properties.
+ */
+static _Bool result_equals(const ec_result* result,
+        const ec_conf_property* const* properties, int count)
+{
+    int             i;
+
+    if (result->count != count)
+        return 0;
+
+    for (i = 0; i < count; ++i) {
+        const ec_conf_property*     p = properties[i];
+
+        if (memcmp(result->strings + result->offsets[2 * i], p->name,
+                    p->name_len + 1) ||
+                memcmp(result->strings + result->offsets[2 * i + 1],
+                    p->value, p->value_len + 1))
+            return 0;
+    }
+
+    return 1;
+}
+
+/*
+ * Allocate a result holding a copy of properties, with a single reference.
+ */
+static ec_result* result_new(const ec_conf_property* const* properties,
+        int count, uint64_t hash)
+{
+    ec_result*      result;
+    size_t          strings_size = 0;
+    size_t          offset = 0;
+    int             i;
+
+    for (i = 0; i < count; ++i)
+        strings_size += properties[i]->name_len +
+            properties[i]->value_len + 2;
+
+    /* the offsets follow the header and the strings follow the offsets, so
+     * they are all suitably aligned */
+    result = (ec_result*)ec_malloc(sizeof(ec_result) +
+            sizeof(size_t) * 2 * count + strings_size);
+    if (result == NULL)
+        return NULL;
+
+    result->refcount = 1;
+    result->hash = hash;
+    result->count = count;
+    result->offsets = (size_t*)(result + 1);
+    result->strings = (char*)(result->offsets + 2 * count);
+    result->next = NULL;
+    memset(&result->properties, 0, sizeof(editorconfig_properties));
+
+    for (i = 0; i < count; ++i) {
+        const ec_conf_property*     p = properties[i];
+
+        result->offsets[2 * i] = offset;
+        memcpy(result->strings + offset, p->name, p->name_len + 1);
+        offset += p->name_len + 1;
+
+        result->offsets[2 * i + 1] = offset;
+        memcpy(result->strings + offset, p->value, p->value_len + 1);
+        offset += p->value_len + 1;
+
+        ec_property_parse_value(&result->properties, p->id, p->value);
+    }
+
+    return result;
+}
+
+/*
+ * Add result to the table, growing the hash table when needed.
+ */
+static int ec_result_table_insert(ec_result_table* table, ec_result* result)
+{
+    size_t          bucket;
+
+    if (table->count >= table->bucket_count) {
+        ec_result**     new_buckets;
+        size_t          new_bucket_count;
+        size_t          i;
+
+        new_bucket_count = table->bucket_count ? table->bucket_count * 2 : 16;
+        new_buckets = (ec_result**)ec_calloc(new_bucket_count,
+                sizeof(ec_result*));
+        if (new_buckets == NULL)
+            return -1;
+
+        for (i = 0; i < table->bucket_count; ++i) {
+            ec_result*      r = table->buckets[i];
+
+            while (r != NULL) {
+                ec_result*  next = r->next;
+
+                bucket = (size_t)(r->hash % new_bucket_count);
+                r->next = new_buckets[bucket];
+                new_buckets[bucket] = r;
+                r = next;
+            }
+        }
+
+        ec_free(table->buckets);
+        table->buckets = new_buckets;
+        table->bucket_count = new_bucket_count;
+    }
+
+    bucket = (size_t)(result->hash % table->bucket_count);
+    result->next = table->buckets[bucket];
+    table->buckets[bucket] = result;
+    ++ table->count;
+
+    return 0;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+int ec_result_table_intern(ec_result_table* table,
+        const ec_conf_property* const* properties, int count,
+        ec_result** result)
+{
+    uint64_t        hash = hash_properties(properties, count);
+    ec_result*      new_result;
+
+    if (table->bucket_count > 0) {
+        ec_result*      r;
+
+        for (r = table->buckets[hash % table->bucket_count]; r != NULL;
+                r = r->next) {
+            if (r->hash == hash && result_equals(r, properties, count)) {
+                *result = r;
+                return 0;
+            }
+        }
+    }
+
+    new_result = result_new(properties, count, hash);
+    if (new_result == NULL)
+        return -2;
+
+    if (ec_result_table_insert(table, new_result) != 0) {
+        ec_free(new_result);
+        return -2;
+    }
+
+    *result = new_result;
+
+    return 0;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+void ec_result_table_clear(ec_result_table* table)
+{
+    size_t          i;
+
+    for (i = 0; i < table->bucket_count; ++i) {
+        ec_result*      r = table->buckets[i];
+
+        while (r != NULL) {
+            ec_result*  next = r->next;
+
+            r->next = NULL;
+            ec_result_unref(r);
+            r = next;
+        }
+    }
+
+    ec_free(table->buckets);
+    memset(table, 0, sizeof(ec_result_table));
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+void ec_result_unref(ec_result* result)
+{
+    if (-- result->refcount == 0)
+        ec_free(result);
+}
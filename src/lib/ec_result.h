@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EC_RESULT_H__
+#define EC_RESULT_H__
+
+#include "global.h"
+
+#include <stdint.h>
+
+#include "ec_conf.h"
+
+/*
+ * The resolved properties of a file. A result is immutable and refcounted,
+ * and is allocated as a single block holding the offsets and the strings.
+ */
+typedef struct ec_result
+{
+    int                     refcount;
+    /* hash of the names and values, in order */
+    uint64_t                hash;
+    int                     count;
+    /* offsets in strings of the name and the value of each property, two per
+     * property */
+    size_t*                 offsets;
+    /* the names and values, each followed by a null character */
+    char*                   strings;
+    /* the parsed values of the properties defined by the specification */
+    editorconfig_properties properties;
+    /* next ec_result in the same bucket of an ec_result_table */
+    struct ec_result*       next;
+} ec_result;
+
+/*
+ * Results indexed by their content, so that equal results are shared. The
+ * table holds a reference to each of its results.
+ */
+typedef struct ec_result_table
+{
+    ec_result**             buckets;
+    size_t                  bucket_count;
+    size_t                  count;
+} ec_result_table;
+
+/*
+ * Set *result to the result of the table with the given properties, adding it
+ * if there is none. The table keeps the reference. Return 0 if successful and
+ * -2 if an OOM occurs.
+ */
+EDITORCONFIG_LOCAL
+int ec_result_table_intern(ec_result_table* table,
+        const ec_conf_property* const* properties, int count,
+        ec_result** result);
+
+/*
+ * Drop the references of the table to its results. The table may be used
+ * again afterwards.
+ */
+EDITORCONFIG_LOCAL
+void ec_result_table_clear(ec_result_table* table);
+
+/*
+ * Drop a reference to result, freeing it if it was the last one.
+ */
+EDITORCONFIG_LOCAL
+void ec_result_unref(ec_result* result);
+
+#endif /* !EC_RESULT_H__ */
@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "global.h"
+
+#ifdef HAVE_SYS_INOTIFY_H
+# include <errno.h>
+# include <sys/inotify.h>
+# include <unistd.h>
+#endif
+
+#include "ec_alloc.h"
+#include "ec_watch.h"
+
+#ifdef HAVE_SYS_INOTIFY_H
+
+/* The events of a directory that tell its EditorConfig file may have changed,
+ * and those that tell the directory itself moved or disappeared */
+#define FILE_EVENTS \
+    (IN_ATTRIB | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MODIFY | \
+     IN_MOVED_FROM | IN_MOVED_TO)
+#define DIR_EVENTS \
+    (IN_DELETE_SELF | IN_MOVE_SELF | IN_UNMOUNT | IN_IGNORED)
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+int ec_watch_open(ec_watch* watch)
+{
+    int             fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if (fd < 0)
+        return -1;
+
+    memset(watch, 0, sizeof(ec_watch));
+    watch->is_enabled = 1;
+    watch->fd = fd;
+
+    return 0;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+void ec_watch_close(ec_watch* watch)
+{
+    size_t          i;
+
+    if (!watch->is_enabled)
+        return;
+
+    for (i = 0; i < watch->bucket_count; ++i) {
+        ec_watch_dir*   dir = watch->buckets[i];
+
+        while (dir != NULL) {
+            ec_watch_dir*   next = dir->next;
+
+            ec_free(dir);
+            dir = next;
+        }
+    }
+    ec_free(watch->buckets);
+
+    /* closing the instance removes its watches */
+    close(watch->fd);
+    memset(watch, 0, sizeof(ec_watch));
+}
+
+/*
+ * Add dir to the hash table, growing it when needed. Return 0 if successful
+ * and -1 if an OOM occurs.
+ */
+static int ec_watch_insert(ec_watch* watch, ec_watch_dir* dir)
+{
+    size_t          bucket;
+
+    if (watch->count >= watch->bucket_count) {
+        ec_watch_dir**  new_buckets;
+        size_t          new_bucket_count;
+        size_t          i;
+
+        new_bucket_count = watch->bucket_count ? watch->bucket_count * 2 : 16;
+        new_buckets = (ec_watch_dir**)ec_calloc(new_bucket_count,
+                sizeof(ec_watch_dir*));
+        if (new_buckets == NULL)
+            return -1;
+
+        for (i = 0; i < watch->bucket_count; ++i) {
+            ec_watch_dir*   d = watch->buckets[i];
+
+            while (d != NULL) {
+                ec_watch_dir*   next = d->next;
+
+                bucket = (size_t)d->wd % new_bucket_count;
+                d->next = new_buckets[bucket];
+                new_buckets[bucket] = d;
+                d = next;
+            }
+        }
+
+        ec_free(watch->buckets);
+        watch->buckets = new_buckets;
+        watch->bucket_count = new_bucket_count;
+    }
+
+    bucket = (size_t)dir->wd % watch->bucket_count;
+    dir->next = watch->buckets[bucket];
+    watch->buckets[bucket] = dir;
+    ++ watch->count;
+
+    return 0;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+int ec_watch_add(ec_watch* watch, const char* path, size_t path_len)
+{
+    ec_watch_dir*   dir;
+    ec_watch_dir*   d;
+
+    dir = (ec_watch_dir*)ec_malloc(sizeof(ec_watch_dir) + path_len + 1);
+    if (dir == NULL)
+        return -2;
+    dir->path = (char*)(dir + 1);
+    memcpy(dir->path, path, path_len);
+    dir->path[path_len] = '\0';
+    dir->path_len = path_len;
+
+    /* the path of the root directory is empty */
+    dir->wd = inotify_add_watch(watch->fd, path_len ? dir->path : "/",
+            FILE_EVENTS | DIR_EVENTS | IN_ONLYDIR);
+    if (dir->wd < 0) {
+        ec_free(dir);
+        return -1;
+    }
+
+    /* a directory watched again, after it was removed from the cache, keeps
+     * its watch descriptor */
+    if (watch->bucket_count > 0) {
+        for (d = watch->buckets[(size_t)dir->wd % watch->bucket_count];
+                d != NULL; d = d->next) {
+            if (d->wd == dir->wd && d->path_len == path_len &&
+                    !memcmp(d->path, path, path_len)) {
+                ec_free(dir);
+                return 0;
+            }
+        }
+    }
+
+    if (ec_watch_insert(watch, dir) != 0) {
+        ec_free(dir);
+        return -2;
+    }
+
+    return 0;
+}
+
+/*
+ * Remove from cache the directories of wd and the directories below them.
+ * Also forget the directories of wd if is_removed is set, since its watch is
+ * gone.
+ */
+static void invalidate(ec_watch* watch, int wd, _Bool is_removed,
+        ec_dir_cache* cache)
+{
+    ec_watch_dir**  link;
+
+    if (watch->bucket_count == 0)
+        return;
+
+    link = &watch->buckets[(size_t)wd % watch->bucket_count];
+    while (*link != NULL) {
+        ec_watch_dir*   dir = *link;
+
+        if (dir->wd != wd) {
+            link = &dir->next;
+            continue;
+        }
+
+        ec_dir_cache_remove_tree(cache, dir->path, dir->path_len);
+        if (is_removed) {
+            *link = dir->next;
+            ec_free(dir);
+            -- watch->count;
+        } else {
+            link = &dir->next;
+        }
+    }
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+int ec_watch_read(ec_watch* watch, const char* conf_file_name,
+        ec_dir_cache* cache)
+{
+    union
+    {
+        struct inotify_event    event;
+        char                    bytes[4096];
+    }               buffer;
+    int             change_count = 0;
+
+    for (;;) {
+        ssize_t         len = read(watch->fd, buffer.bytes,
+                sizeof(buffer.bytes));
+        const char*     p;
+
+        if (len < 0 && errno == EINTR)
+            continue;
+        if (len < 0 && errno == EAGAIN)
+            break;
+        if (len <= 0) {
+            /* the events cannot be read, so nothing can be trusted */
+            ec_dir_cache_clear(cache);
+            return change_count + 1;
+        }
+
+        for (p = buffer.bytes; p < buffer.bytes + len;
+                p += sizeof(struct inotify_event) +
+                ((const struct inotify_event*)p)->len) {
+            const struct inotify_event* event =
+                (const struct inotify_event*)p;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                /* some events were lost */
+                ec_dir_cache_clear(cache);
+                ++ change_count;
+            } else if (event->mask & DIR_EVENTS) {
+                /* the paths below the directory are no longer the same
+                 * files; a directory that moved keeps its watch, which is
+                 * removed so that it is not mistaken for its old path */
+                if (event->mask & IN_MOVE_SELF)
+                    inotify_rm_watch(watch->fd, event->wd);
+                invalidate(watch, event->wd,
+                        (event->mask & IN_IGNORED) != 0, cache);
+                if (!(event->mask & IN_IGNORED))
+                    ++ change_count;
+            } else if (event->len > 0 &&
+                    !strcmp(event->name, conf_file_name)) {
+                invalidate(watch, event->wd, 0, cache);
+                ++ change_count;
+            }
+        }
+    }
+
+    return change_count;
+}
+
+#else /* HAVE_SYS_INOTIFY_H */
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+int ec_watch_open(ec_watch* watch)
+{
+    memset(watch, 0, sizeof(ec_watch));
+    return -1;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+void ec_watch_close(ec_watch* watch)
+{
+    memset(watch, 0, sizeof(ec_watch));
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+int ec_watch_add(ec_watch* watch, const char* path, size_t path_len)
+{
+    (void)watch;
+    (void)path;
+    (void)path_len;
+    return -1;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_LOCAL
+int ec_watch_read(ec_watch* watch, const char* conf_file_name,
+        ec_dir_cache* cache)
+{
+    (void)watch;
+    (void)conf_file_name;
+    (void)cache;
+    return 0;
+}
+
+#endif /* HAVE_SYS_INOTIFY_H */
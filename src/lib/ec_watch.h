@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EC_WATCH_H__
+#define EC_WATCH_H__
+
+#include "global.h"
+
+#include "ec_dir_cache.h"
+
+/*
+ * A directory watched for changes to its EditorConfig file. There is one for
+ * each path, so a directory reached by several paths has several of them with
+ * the same watch descriptor. It is allocated as a single block holding the
+ * path.
+ */
+typedef struct ec_watch_dir
+{
+    int                     wd;
+    /* the path of the directory, without the trailing slash */
+    char*                   path;
+    size_t                  path_len;
+    /* next ec_watch_dir in the same bucket of an ec_watch */
+    struct ec_watch_dir*    next;
+} ec_watch_dir;
+
+/*
+ * The directories of a directory cache watched with inotify, so that the
+ * directories are removed from the cache when their EditorConfig file, or one
+ * of their parents', changes. The directories are indexed by their watch
+ * descriptor.
+ */
+typedef struct ec_watch
+{
+    _Bool                   is_enabled;
+    /* the inotify instance */
+    int                     fd;
+    ec_watch_dir**          buckets;
+    size_t                  bucket_count;
+    size_t                  count;
+} ec_watch;
+
+/*
+ * Create the inotify instance of watch. Return 0 if successful, and -1 if
+ * directories cannot be watched, on this platform or for lack of resources.
+ */
+EDITORCONFIG_LOCAL
+int ec_watch_open(ec_watch* watch);
+
+/*
+ * Stop watching all the directories and close the inotify instance. The
+ * watch may be opened again afterwards.
+ */
+EDITORCONFIG_LOCAL
+void ec_watch_close(ec_watch* watch);
+
+/*
+ * Watch the directory whose path is the first path_len characters of path.
+ * Return 0 if successful, -1 if the directory cannot be watched, in which case
+ * it must not be cached, and -2 if an OOM occurs.
+ */
+EDITORCONFIG_LOCAL
+int ec_watch_add(ec_watch* watch, const char* path, size_t path_len);
+
+/*
+ * Read the pending events of watch, and remove from cache the directories
+ * whose EditorConfig file named conf_file_name, or a parent's, was created,
+ * modified or removed, and the directories moved or removed. Return the
+ * number of such changes.
+ */
+EDITORCONFIG_LOCAL
+int ec_watch_read(ec_watch* watch, const char* conf_file_name,
+        ec_dir_cache* cache);
+
+#endif /* !EC_WATCH_H__ */
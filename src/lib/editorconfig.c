@@ -28,379 +28,526 @@
 #include "editorconfig.h"
 #include "misc.h"
 #include "ini.h"
-#include "ec_glob.h"
+#include "ec_alloc.h"
+#include "ec_arena.h"
+#include "ec_conf.h"
 
-/* could be used to fast locate these properties in an
- * array_editorconfig_name_value */
-typedef struct
+/* the properties looked at by the post-processing */
+enum
 {
-    const editorconfig_name_value*        indent_style;
-    const editorconfig_name_value*        indent_size;
-    const editorconfig_name_value*        tab_width;
-} special_property_name_value_pointers;
+    SPECIAL_INDENT_STYLE,
+    SPECIAL_INDENT_SIZE,
+    SPECIAL_TAB_WIDTH,
+    SPECIAL_COUNT
+};
 
+/*
+ * The resolved properties of a file. Each entry is a pointer to a property of
+ * a parsed EditorConfig file, or to a property made up by the post-processing
+ * in the scratch arena of the handle.
+ */
 typedef struct
 {
-    editorconfig_name_value*                name_values;
-    int                                     current_value_count;
-    int                                     max_value_count;
-    special_property_name_value_pointers    spnvp;
-} array_editorconfig_name_value;
+    /* where the arrays below are allocated */
+    ec_arena*                   arena;
+    /* the last property set for each name, in the order the names were first
+     * set */
+    const ec_conf_property**    properties;
+    int                         current_count;
+    int                         max_count;
+    /* could be used to fast locate the special properties: their indices in
+     * properties, or -1 */
+    int                         special[SPECIAL_COUNT];
+    /* open addressing hash table of the properties by name. Each slot holds
+     * an index in properties plus one, or 0 if the slot is empty. */
+    int*                        index;
+    /* the number of slots, a power of 2 */
+    size_t                      index_size;
+} array_conf_property;
 
 typedef struct
 {
-    char*                           full_filename;
-    char*                           editorconfig_file_dir;
-    array_editorconfig_name_value   array_name_value;
-} handler_first_param;
+    char*                   full_filename;
+    array_conf_property     properties;
+    /* hash of the paths and contents of the EditorConfig files the
+     * properties were resolved from */
+    uint64_t                sources_hash;
+} property_resolver;
 
 /*
- * Set the special pointers for a name
+ * Return the SPECIAL_* index of a property, or -1.
  */
-static void set_special_property_name_value_pointers(
-        const editorconfig_name_value* nv,
-        special_property_name_value_pointers* spnvp)
+static int get_special_index(ec_property_id id)
 {
-    /* set speical pointers */
-    if (!strcmp(nv->name, "indent_style"))
-        spnvp->indent_style = nv;
-    else if (!strcmp(nv->name, "indent_size"))
-        spnvp->indent_size = nv;
-    else if (!strcmp(nv->name, "tab_width"))
-        spnvp->tab_width = nv;
+    switch (id) {
+    case EC_PROPERTY_INDENT_STYLE:
+        return SPECIAL_INDENT_STYLE;
+    case EC_PROPERTY_INDENT_SIZE:
+        return SPECIAL_INDENT_SIZE;
+    case EC_PROPERTY_TAB_WIDTH:
+        return SPECIAL_TAB_WIDTH;
+    default:
+        return -1;
+    }
 }
 
 /*
- * Set the name and value of a editorconfig_name_value structure
+ * Return the special property of acp given by its SPECIAL_* index, or NULL if
+ * it is not set.
  */
-static void set_name_value(editorconfig_name_value* nv, const char* name,
-        const char* value, special_property_name_value_pointers* spnvp)
+static const ec_conf_property* array_conf_property_get_special(
+        const array_conf_property* acp, int special)
 {
-    if (name)
-        nv->name = strdup(name);
-    if (value)
-        nv->value = strdup(value);
-    /* lowercase the value when the name is one of the following */
-    if (!strcmp(nv->name, "end_of_line") ||
-            !strcmp(nv->name, "indent_style") ||
-            !strcmp(nv->name, "indent_size") ||
-            !strcmp(nv->name, "insert_final_newline") ||
-            !strcmp(nv->name, "trim_trailing_whitespace") ||
-            !strcmp(nv->name, "charset"))
-        strlwr(nv->value);
+    if (acp->special[special] < 0)
+        return NULL;
 
-    /* set special pointers */
-    set_special_property_name_value_pointers(nv, spnvp);
+    return acp->properties[acp->special[special]];
 }
 
 /*
- * reset special property name value pointers
+ * Find the slot of the index of acp where the property named name is, or
+ * where it would be added. The index must not be full.
  */
-static void reset_special_property_name_value_pointers(
-        array_editorconfig_name_value* aenv)
+static size_t array_conf_property_find_slot(const array_conf_property* acp,
+        const char* name, uint64_t name_hash)
 {
-    int         i;
-    
-    for (i = 0; i < aenv->current_value_count; ++ i)
-        set_special_property_name_value_pointers(
-                &aenv->name_values[i], &aenv->spnvp);
+    size_t      mask = acp->index_size - 1;
+    size_t      slot = (size_t)name_hash & mask;
+
+    /* linear probing */
+    while (acp->index[slot] != 0) {
+        const ec_conf_property*     p = acp->properties[acp->index[slot] - 1];
+
+        if (p->name_hash == name_hash && !strcmp(p->name, name))
+            break;
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
 }
 
 /*
- * Find the editorconfig_name_value from name in a editorconfig_name_value
- * array.
+ * Resize the index of acp to index_size slots and add all the properties to
+ * it again.
  */
-static int find_name_value_from_name(const editorconfig_name_value* env,
-        int count, const char* name)
+static int array_conf_property_rehash(array_conf_property* acp,
+        size_t index_size)
 {
+    int*        new_index;
     int         i;
 
-    for (i = 0; i < count; ++i)
-        if (!strcmp(env[i].name, name)) /* found */
-            return i;
+    new_index = (int*)ec_arena_alloc(acp->arena, sizeof(int) * index_size);
+    if (new_index == NULL)
+        return -1;
+    memset(new_index, 0, sizeof(int) * index_size);
 
-    return -1;
+    acp->index = new_index;
+    acp->index_size = index_size;
+
+    for (i = 0; i < acp->current_count; ++i)
+        acp->index[array_conf_property_find_slot(acp,
+                acp->properties[i]->name, acp->properties[i]->name_hash)] =
+            i + 1;
+
+    return 0;
 }
 
-/* initialize array_editorconfig_name_value */
-static void array_editorconfig_name_value_init(
-        array_editorconfig_name_value* aenv)
+/* remove all the properties, but keep the memory */
+static void array_conf_property_empty(array_conf_property* acp)
 {
-    memset(aenv, 0, sizeof(array_editorconfig_name_value));
+    int         i;
+
+    acp->current_count = 0;
+    for (i = 0; i < SPECIAL_COUNT; ++i)
+        acp->special[i] = -1;
+    if (acp->index != NULL)
+        memset(acp->index, 0, sizeof(int) * acp->index_size);
+}
+
+/* initialize array_conf_property, allocating from arena */
+static void array_conf_property_init(array_conf_property* acp,
+        ec_arena* arena)
+{
+    memset(acp, 0, sizeof(array_conf_property));
+    acp->arena = arena;
+    array_conf_property_empty(acp);
 }
 
-static int array_editorconfig_name_value_add(
-        array_editorconfig_name_value* aenv,
-        const char* name, const char* value)
+/*
+ * Add a property, or replace the property with the same name. The property is
+ * not copied.
+ */
+static int array_conf_property_add(array_conf_property* acp,
+        const ec_conf_property* property)
 {
-#define VALUE_COUNT_INITIAL      30
-#define VALUE_COUNT_INCREASEMENT 10
-    int         name_value_pos;
-    /* always use name_lwr but not name, since property names are case
-     * insensitive */
-    char        name_lwr[MAX_PROPERTY_NAME+1] = {0};
-    /* For the first time we came here, aenv->name_values is NULL */
-    if (aenv->name_values == NULL) {
-        aenv->name_values = (editorconfig_name_value*)malloc(
-                sizeof(editorconfig_name_value) * VALUE_COUNT_INITIAL);
+#define VALUE_COUNT_INITIAL      32
+#define INDEX_SIZE_INITIAL       64
+    size_t          slot;
+    int             special;
 
-        if (aenv->name_values == NULL)
+    /* For the first time we came here, acp->properties is NULL */
+    if (acp->properties == NULL) {
+        acp->properties = (const ec_conf_property**)ec_arena_alloc(
+                acp->arena, sizeof(ec_conf_property*) * VALUE_COUNT_INITIAL);
+
+        if (acp->properties == NULL)
             return -1;
 
-        aenv->max_value_count = VALUE_COUNT_INITIAL;
-        aenv->current_value_count = 0;
+        acp->max_count = VALUE_COUNT_INITIAL;
+        acp->current_count = 0;
     }
 
+    /* keep the index at most half full */
+    if ((size_t)acp->current_count * 2 >= acp->index_size &&
+            array_conf_property_rehash(acp, acp->index_size ?
+                acp->index_size * 2 : INDEX_SIZE_INITIAL) != 0)
+        return -1;
 
-    /* name_lwr is the lowercase property name */
-    strlwr(strncpy(name_lwr, name, MAX_PROPERTY_NAME));
-
-    name_value_pos = find_name_value_from_name(
-            aenv->name_values, aenv->current_value_count, name_lwr);
+    slot = array_conf_property_find_slot(acp, property->name,
+            property->name_hash);
 
-    if (name_value_pos >= 0) { /* current name has already been used */
-        free(aenv->name_values[name_value_pos].value);
-        set_name_value(&aenv->name_values[name_value_pos],
-                (const char*)NULL, value, &aenv->spnvp);
+    if (acp->index[slot] != 0) { /* current name has already been used */
+        acp->properties[acp->index[slot] - 1] = property;
         return 0;
     }
 
-    /* if the space is not enough, allocate more before add the new name and
-     * value */
-    if (aenv->current_value_count >= aenv->max_value_count) {
+    /* if the space is not enough, allocate more before add the new property.
+     * Grow geometrically so that adding a property stays O(1). The old array
+     * stays in the arena until it is reset. */
+    if (acp->current_count >= acp->max_count) {
 
-        editorconfig_name_value*        new_values;
-        int                             new_max_value_count;
+        const ec_conf_property**    new_properties;
+        int                         new_max_count;
 
-        new_max_value_count = aenv->current_value_count +
-            VALUE_COUNT_INCREASEMENT;
-        new_values = (editorconfig_name_value*)realloc(aenv->name_values,
-                sizeof(editorconfig_name_value) * new_max_value_count);
+        new_max_count = acp->max_count * 2;
+        new_properties = (const ec_conf_property**)ec_arena_alloc(acp->arena,
+                sizeof(ec_conf_property*) * new_max_count);
 
-        if (new_values == NULL) /* error occured */
+        if (new_properties == NULL) /* error occured */
             return -1;
+        memcpy(new_properties, acp->properties,
+                sizeof(ec_conf_property*) * acp->current_count);
 
-        aenv->name_values = new_values;
-        aenv->max_value_count = new_max_value_count;
-
-        /* reset special pointers */
-        reset_special_property_name_value_pointers(aenv);
+        acp->properties = new_properties;
+        acp->max_count = new_max_count;
     }
 
-    set_name_value(&aenv->name_values[aenv->current_value_count],
-            name_lwr, value, &aenv->spnvp);
-    ++ aenv->current_value_count;
+    special = get_special_index(property->id);
+    if (special >= 0)
+        acp->special[special] = acp->current_count;
+
+    acp->properties[acp->current_count] = property;
+    ++ acp->current_count;
+    acp->index[slot] = acp->current_count;
 
     return 0;
 #undef VALUE_COUNT_INITIAL
-#undef VALUE_COUNT_INCREASEMENT
+#undef INDEX_SIZE_INITIAL
 }
 
-static void array_editorconfig_name_value_clear(
-        array_editorconfig_name_value* aenv)
+/*
+ * Add a property made up by the post-processing, allocated from the arena of
+ * acp. name must be lowercased. Errors are ignored, as they were before.
+ */
+static void array_conf_property_add_new(array_conf_property* acp,
+        const char* name, ec_property_id id, const char* value,
+        size_t value_len)
 {
-    int             i;
+    ec_conf_property*       property;
+
+    property = (ec_conf_property*)ec_arena_alloc(acp->arena,
+            sizeof(ec_conf_property));
+    if (property == NULL)
+        return;
+
+    /* the property is only read through acp, so the strings are not copied */
+    property->name = (char*)name;
+    property->name_len = strlen(name);
+    property->name_hash = ec_hash(name, property->name_len);
+    property->id = id;
+    property->value = (char*)value;
+    property->value_len = value_len;
+
+    array_conf_property_add(acp, property);
+}
 
-    for (i = 0; i < aenv->current_value_count; ++i) {
-        free(aenv->name_values[i].name);
-        free(aenv->name_values[i].value);
-    }
+/*
+ * Iterator over the paths of the EditorConfig files in every directory in and
+ * above a file path, from the root directory downwards. All candidates are
+ * built in a single caller-provided buffer by truncating the file path at
+ * successive slashes, so iterating allocates nothing.
+ */
+typedef struct
+{
+    /* the full file path whose ancestors are enumerated */
+    const char*                     path;
+    const char*                     conf_file_name;
+    size_t                          conf_file_name_len;
+    /* holds the current candidate; see ancestor_iterator_buffer_size() */
+    char*                           buffer;
+    /* length of the directory part of the current candidate */
+    size_t                          dir_len;
+    /* the slash that ends the directory of the next candidate */
+    const char*                     next_slash;
+    /* the slash that ends the top directory */
+    const char*                     first_slash;
+} ancestor_iterator;
 
-    free(aenv->name_values);
+/*
+ * Return the size of the buffer needed by an ancestor_iterator.
+ */
+static size_t ancestor_iterator_buffer_size(const char* path,
+        const char* conf_file_name)
+{
+    return strlen(path) + strlen(conf_file_name) + 2;
 }
 
+/* Size of the buffer of an ancestor_iterator kept on the stack, which is
+ * enough for most paths */
+#define ANCESTOR_STACK_BUFFER_SIZE  1024
+
 /*
- * Accept INI property value and store known values in handler_first_param
- * struct.
+ * Return the buffer of an ancestor_iterator over path: stack_buffer, which has
+ * ANCESTOR_STACK_BUFFER_SIZE bytes, if it is large enough, or a buffer taken
+ * from the scratch arena of eh for the longer paths. Return NULL if an OOM
+ * occurs.
  */
-static int ini_handler(void* hfp, const char* section, const char* name,
-        const char* value)
+static char* ancestor_iterator_buffer(struct editorconfig_handle* eh,
+        const char* path, char* stack_buffer)
 {
-    handler_first_param* hfparam = (handler_first_param*)hfp;
-    /* prepend ** to pattern */
-    char*                pattern;
+    size_t              size = ancestor_iterator_buffer_size(path,
+            eh->conf_file_name);
 
-    /* root = true, clear all previous values */
-    if (*section == '\0' && !strcasecmp(name, "root") &&
-            !strcasecmp(value, "true")) {
-        array_editorconfig_name_value_clear(&hfparam->array_name_value);
-        array_editorconfig_name_value_init(&hfparam->array_name_value);
-        return 1;
-    }
+    if (size <= ANCESTOR_STACK_BUFFER_SIZE)
+        return stack_buffer;
 
-    /* Pattern would be: /dir/of/editorconfig/file[double_star]/[section] if
-     * section does not contain '/', or /dir/of/editorconfig/file[section]
-     * if section starts with a '/', or /dir/of/editorconfig/file/[section] if
-     * section contains '/' but does not start with '/'.
-     *
-     * If the dir part has any special characters as defined by ec_glob.c, we
-     * need to escape them.
-     */
-    pattern = (char*)malloc(
-        /* The 2 here is for possible escaping. */
-        strlen(hfparam->editorconfig_file_dir) * sizeof(char) * 2 +
-            sizeof("**/") + strlen(section) * sizeof(char));
-    if (!pattern)
-        return 0;
+    return (char*)ec_arena_alloc(&eh->scratch_arena, size);
+}
 
-    /* Escaping special characters in the directory part. */
-    char* ptr = hfparam->editorconfig_file_dir;
-    char* ptr_prev = ptr;
-    char* ptr_pattern = pattern;
-    for (; (ptr = strpbrk(ptr, ec_special_chars)) != NULL; ++ ptr, ptr_prev = ptr)
-    {
-        ptrdiff_t s = ptr - ptr_prev;
-        memcpy(ptr_pattern, ptr_prev, s * sizeof(char));
-        ptr_pattern += s;
-        *(ptr_pattern ++) = '\\';  /* escaping char */
-        *(ptr_pattern ++) = *ptr;
+static void ancestor_iterator_init(ancestor_iterator* it, const char* path,
+        const char* conf_file_name, char* buffer)
+{
+    it->path = path;
+    it->conf_file_name = conf_file_name;
+    it->conf_file_name_len = strlen(conf_file_name);
+    it->buffer = buffer;
+    it->dir_len = 0;
+    it->next_slash = strchr(path, '/');
+
+#ifdef WIN32
+    /* detect whether file is on an UNC share such as //server/sharename/filename,
+     * in which case the search starts in //server/sharename */
+    if (path[0] == '/' && path[1] == '/') {
+        int i;
+        for (i = 0; i < 3 && it->next_slash != NULL; ++i)
+            it->next_slash = strchr(it->next_slash + 1, '/');
     }
-    strcpy(ptr_pattern, ptr_prev);
+#endif
 
-    if (strchr(section, '/') == NULL) /* No / is found, append '[star][star]/' */
-        strcat(pattern, "**/");
-    else if (*section != '/') /* The first char is not '/' but section contains
-                                 '/', append a '/' */
-        strcat(pattern, "/");
+    it->first_slash = it->next_slash;
+}
 
-    strcat(pattern, section);
+/*
+ * Initialize an ancestor_iterator that goes from the directory of the file
+ * upwards with ancestor_iterator_next_upwards().
+ */
+static void ancestor_iterator_init_upwards(ancestor_iterator* it,
+        const char* path, const char* conf_file_name, char* buffer)
+{
+    ancestor_iterator_init(it, path, conf_file_name, buffer);
+    /* Going upwards, the directory of every candidate is a prefix of the
+     * previous one, so the path only needs to be copied once */
+    strcpy(buffer, path);
+    it->dir_len = strlen(path);
+}
 
-    if (ec_glob(pattern, hfparam->full_filename) == 0) {
-        if (array_editorconfig_name_value_add(&hfparam->array_name_value, name,
-                value)) {
-            free(pattern);
-            return 0;
-        }
-    }
+/*
+ * Return the next config file path, or NULL if all the directories have been
+ * visited. The returned string is only valid until the next call. Its first
+ * it->dir_len characters are the directory the config file is in.
+ */
+static const char* ancestor_iterator_next(ancestor_iterator* it)
+{
+    size_t          dir_len;
+
+    if (it->next_slash == NULL)
+        return NULL;
 
-    free(pattern);
-    return 1;
+    /* Restore the part of the path that the previous config file name was
+     * written over, then append the config file name to the directory */
+    dir_len = (size_t)(it->next_slash - it->path);
+    memcpy(it->buffer + it->dir_len, it->path + it->dir_len,
+            dir_len - it->dir_len);
+    it->dir_len = dir_len;
+    it->buffer[dir_len] = '/';
+    memcpy(it->buffer + dir_len + 1, it->conf_file_name,
+            it->conf_file_name_len + 1);
+
+    it->next_slash = strchr(it->next_slash + 1, '/');
+
+    return it->buffer;
 }
 
 /*
- * Split an absolute file path into directory and filename parts.
- *
- * If absolute_path does not contain a path separator, set directory and
- * filename to NULL pointers.
- *
- * Returns -1 if an OOM error occurs. Otherwise returns 0.
+ * Same as ancestor_iterator_next(), but from the directory of the file
+ * upwards.
  */
-static int split_file_path(char** directory, char** filename,
-        const char* absolute_path)
+static const char* ancestor_iterator_next_upwards(ancestor_iterator* it)
 {
-    const char* path_char = strrchr(absolute_path, '/');
+    const char*     slash;
 
-    if (path_char == NULL) {
-        if (directory)
-            *directory = NULL;
-        if (filename)
-            *filename = NULL;
-        return 0;
-    }
+    if (it->first_slash == NULL)
+        return NULL;
 
-    if (directory != NULL) {
-        *directory = strndup(absolute_path,
-                (size_t)(path_char - absolute_path));
-        if (*directory == NULL)
-            return -1;
-    }
+    slash = it->path + it->dir_len;
+    do {
+        if (slash == it->first_slash)
+            return NULL;
+        -- slash;
+    } while (*slash != '/');
 
-    if (filename != NULL) {
-        *filename = strndup(path_char+1, strlen(path_char)-1);
-        if (*filename == NULL) {
-            if (directory != NULL)
-                free(*directory);
-            return -1;
-        }
-    }
+    it->dir_len = (size_t)(slash - it->path);
+    memcpy(it->buffer + it->dir_len + 1, it->conf_file_name,
+            it->conf_file_name_len + 1);
 
-    return 0;
+    return it->buffer;
 }
 
 /*
- * Return the number of slashes in given filename
+ * Load the EditorConfig file config_file in the cache of eh, through its index
+ * if the file is in the directory tree of the index, or through its persistent
+ * cache if it is enabled. Return the same as ec_conf_cache_load().
  */
-static int count_slashes(const char* filename)
+static int read_conf(struct editorconfig_handle* eh, const char* config_file,
+        ec_conf** conf)
 {
-    int slash_count;
-    for (slash_count = 0; *filename != '\0'; filename++) {
-        if (*filename == '/') {
-            slash_count++;
-        }
-    }
-    return slash_count;
+    ec_disk_cache*      disk_cache = NULL;
+
+    if (eh->index.is_open && ec_disk_cache_covers(&eh->index, config_file))
+        disk_cache = &eh->index;
+    else if (eh->disk_cache.is_open)
+        disk_cache = &eh->disk_cache;
+
+    return ec_conf_cache_load(&eh->conf_cache, disk_cache, config_file, conf);
 }
 
 /*
- * Return an array of full filenames for files in every directory in and above
- * the given path with the name of the relative filename given. Return NULL if
- * failed (OOM).
+ * Set cache to the open cache of eh which the compiled regexes of the sections
+ * are taken from and added to. The index is left out, since it may be written
+ * by anyone.
  */
-static char** get_filenames(const char* path, const char* filename)
+static void get_glob_cache(struct editorconfig_handle* eh,
+        ec_glob_cache* cache)
 {
-    char* currdir = NULL;
-    char** files;
-    int slashes = count_slashes(path);
-    int i;
+    cache->cache = eh->disk_cache.is_open ? &eh->disk_cache : NULL;
+}
 
-#ifdef WIN32
-    /* detect whether file is on an UNC share such as //server/sharename/filename */
-    if (slashes >= 3 && path[0] == '/' && path[1] == '/')
-        slashes -= 3;
-#endif
+/*
+ * Set *dir to the directory of the file at filename, which must be absolute,
+ * from the directory cache of eh, adding it and its parents if needed. If eh
+ * watches the directories, *dir is set to NULL when one of them cannot be
+ * watched, so that its EditorConfig file is read each time. Return 0 if
+ * successful and -2 if an OOM occurs.
+ */
+static int find_dir(struct editorconfig_handle* eh, const char* filename,
+        ec_dir** dir)
+{
+    ancestor_iterator       it;
+    const char*             config_file;
+    char*                   buffer;
+    char                    stack_buffer[ANCESTOR_STACK_BUFFER_SIZE];
+    ec_dir*                 parent = NULL;
+
+    *dir = ec_dir_cache_find(&eh->dir_cache, filename,
+            (size_t)(strrchr(filename, '/') - filename));
+    if (*dir != NULL)
+        return 0;
 
-    files = (char**) calloc(slashes+1, sizeof(char*));
-    if (files == NULL)
-        goto failure_cleanup;
-
-    currdir = strdup(path);
-    if (currdir == NULL)
-        goto failure_cleanup;
-
-    for (i = slashes - 1; i >= 0; --i) {
-        char* currdir1 = currdir;
-        int err_split;
-        err_split = split_file_path(&currdir, NULL, currdir1);
-        free(currdir1);
-        if (err_split == -1)
-            goto failure_cleanup;
-        files[i] = malloc(strlen(currdir) + strlen(filename) + 2);
-        strcpy(files[i], currdir);
-        strcat(files[i], "/");
-        strcat(files[i], filename);
+    buffer = ancestor_iterator_buffer(eh, filename, stack_buffer);
+    if (buffer == NULL)
+        return -2;
+
+    /* Add the missing directories from the top, each from its parent */
+    ancestor_iterator_init(&it, filename, eh->conf_file_name, buffer);
+    while ((config_file = ancestor_iterator_next(&it)) != NULL) {
+        ec_dir*         d = ec_dir_cache_find(&eh->dir_cache, filename,
+                it.dir_len);
+        ec_conf*        conf;
+        int             err_num;
+
+        if (d == NULL) {
+            /* watch the directory before reading its EditorConfig file, so
+             * that no later change is missed */
+            if (eh->watch.is_enabled) {
+                err_num = ec_watch_add(&eh->watch, filename, it.dir_len);
+                if (err_num == -1) {
+                    *dir = NULL;
+                    return 0;
+                } else if (err_num != 0)
+                    return -2;
+            }
+
+            err_num = read_conf(eh, config_file, &conf);
+            if (err_num == -1)
+                conf = NULL;
+            else if (err_num != 0)
+                return -2;
+
+            d = ec_dir_cache_add(&eh->dir_cache, filename, it.dir_len,
+                    parent, conf);
+            if (d == NULL)
+                return -2;
+        }
+        parent = d;
     }
 
-    free(currdir);
-
-    files[slashes] = NULL;
-
-    return files;
+    *dir = parent;
 
-failure_cleanup:
+    return 0;
+}
 
-    free(currdir);
+/*
+ * Set *dir to the directory of the file at filename from the directory cache
+ * of eh, if it is used, or to NULL otherwise. The changes to the watched
+ * directories are applied to the cache first. Return 0 if successful and -2 if
+ * an OOM occurs.
+ */
+static int get_cached_dir(struct editorconfig_handle* eh,
+        const char* filename, ec_dir** dir)
+{
+    *dir = NULL;
 
-    if (files != NULL) {
-        for (i = 0; i < slashes; ++ i)
-            free(files[i]);
-        free(files);
-    }
+    if (eh->watch.is_enabled)
+        eh->watch_change_count += ec_watch_read(&eh->watch,
+                eh->conf_file_name, &eh->dir_cache);
+    else if (!eh->is_dir_cache_enabled)
+        return 0;
 
-    return NULL;
+    return find_dir(eh, filename, dir);
 }
 
 /*
- * Free the memory used by an array of strings that was created by
- * get_filenames().
+ * Set *conf to the EditorConfig file config_file, which is in the directory
+ * made of the first dir_len characters of the parsed file path. If dir is not
+ * NULL, it is the directory of the parsed file, and the file is taken from it
+ * instead of being loaded. Return the same as ec_conf_cache_load().
  */
-static void free_filenames(char **filenames)
+static int load_conf(struct editorconfig_handle* eh, const ec_dir* dir,
+        const char* config_file, size_t dir_len, ec_conf** conf)
 {
-    if (filenames != NULL) {
-        for (char** filename = filenames; *filename != NULL; filename++) {
-            free(*filename);
+    int             i;
+
+    if (dir == NULL)
+        return read_conf(eh, config_file, conf);
+
+    for (i = 0; i < dir->conf_count; ++i) {
+        if (dir->confs[i].dir_len == dir_len) {
+            *conf = dir->confs[i].conf;
+            return 0;
         }
-        free(filenames);
     }
+
+    return -1;
 }
 
 /*
@@ -452,19 +599,12 @@ const char* editorconfig_get_error_msg(int err_num)
 }
 
 /*
- * See the header file for the use of this function
+ * Check the version the handle should act as, setting it to the current
+ * version if it is 0.0.0.
  */
-EDITORCONFIG_EXPORT
-int editorconfig_parse(const char* full_filename, editorconfig_handle h)
+static int editorconfig_check_version(struct editorconfig_handle* eh)
 {
-    handler_first_param                 hfp;
-    char**                              config_file;
-    char**                              config_files = NULL;
-    int                                 err_num = 0;
-    int                                 i;
-    struct editorconfig_handle*         eh = (struct editorconfig_handle*)h;
     struct editorconfig_version         cur_ver;
-    struct editorconfig_version         tmp_ver;
 
     /* get current version */
     editorconfig_get_version(&cur_ver.major, &cur_ver.minor,
@@ -479,8 +619,28 @@ int editorconfig_parse(const char* full_filename, editorconfig_handle h)
     if (editorconfig_compare_version(&eh->ver, &cur_ver) > 0)
         return EDITORCONFIG_PARSE_VERSION_TOO_NEW;
 
+    return 0;
+}
+
+/*
+ * Reset the error and the scratch arena of the previous parsing, and set
+ * *filename to a copy of full_filename with slashes as directory separators,
+ * allocated from the scratch arena. Return 0 or an editorconfig_parse() error.
+ */
+static int editorconfig_begin_parse(struct editorconfig_handle* eh,
+        const char* full_filename, char** filename)
+{
+    ec_arena_reset(&eh->scratch_arena);
+
+    /* the previous parsing no longer borrows from the EditorConfig files, so
+     * only those of the directory cache are still used */
+    if (ec_conf_cache_needs_sweep(&eh->conf_cache)) {
+        ec_dir_cache_mark_confs(&eh->dir_cache, eh->conf_cache.generation);
+        ec_conf_cache_sweep(&eh->conf_cache);
+    }
+
     if (eh->err_file) {
-        free(eh->err_file);
+        ec_free(eh->err_file);
         eh->err_file = NULL;
     }
 
@@ -489,64 +649,117 @@ int editorconfig_parse(const char* full_filename, editorconfig_handle h)
     if (!eh->conf_file_name)
         eh->conf_file_name = ".editorconfig";
 
-    if (eh->name_values) {
-        /* free name_values */
-        for (i = 0; i < eh->name_value_count; ++i) {
-            free(eh->name_values[i].name);
-            free(eh->name_values[i].value);
-        }
-        free(eh->name_values);
-
-        eh->name_values = NULL;
-        eh->name_value_count = 0;
-    }
-    memset(&hfp, 0, sizeof(hfp));
-
-    hfp.full_filename = strdup(full_filename);
-    if (hfp.full_filename == NULL) {
-        err_num = EDITORCONFIG_PARSE_MEMORY_ERROR;
-        goto cleanup;
-    }
+    *filename = ec_arena_strndup(&eh->scratch_arena, full_filename,
+            strlen(full_filename));
+    if (*filename == NULL)
+        return EDITORCONFIG_PARSE_MEMORY_ERROR;
 
     /* return an error if file path is not absolute */
-    if (!is_file_path_absolute(full_filename)) {
-        err_num = EDITORCONFIG_PARSE_NOT_FULL_PATH;
-        goto cleanup;
-    }
+    if (!is_file_path_absolute(full_filename))
+        return EDITORCONFIG_PARSE_NOT_FULL_PATH;
 
 #ifdef WIN32
     /* replace all backslashes with slashes on Windows */
-    str_replace(hfp.full_filename, '\\', '/');
+    str_replace(*filename, '\\', '/');
 #endif
 
-    array_editorconfig_name_value_init(&hfp.array_name_value);
+    return 0;
+}
 
-    config_files = get_filenames(hfp.full_filename, eh->conf_file_name);
-    if (config_files == NULL) {
-        err_num = EDITORCONFIG_PARSE_MEMORY_ERROR;
-        goto cleanup;
-    }
-    for (config_file = config_files; *config_file != NULL; config_file++) {
-        int ini_err_num;
-        err_num = split_file_path(&hfp.editorconfig_file_dir, NULL, *config_file);
+/*
+ * Find the EditorConfig files for full_filename and resolve the properties
+ * that apply to it into pr->properties, which borrow from the EditorConfig
+ * files cached in eh and from its scratch arena. Return 0 or an
+ * editorconfig_parse() error.
+ */
+static int resolve_properties(const char* full_filename,
+        struct editorconfig_handle* eh, property_resolver* pr)
+{
+    array_conf_property*                acp = &pr->properties;
+    ancestor_iterator                   config_files;
+    const char*                         config_file;
+    char*                               config_file_buffer;
+    char                                stack_buffer[ANCESTOR_STACK_BUFFER_SIZE];
+    const ec_conf_property*             indent_style;
+    const ec_conf_property*             indent_size;
+    const ec_conf_property*             tab_width;
+    ec_dir*                             dir = NULL;
+    ec_glob_cache                       glob_cache;
+    int                                 err_num = 0;
+    int                                 i;
+    struct editorconfig_version         tmp_ver;
+
+    array_conf_property_init(acp, &eh->scratch_arena);
+    pr->sources_hash = EC_HASH_INIT;
+    get_glob_cache(eh, &glob_cache);
+
+    err_num = editorconfig_begin_parse(eh, full_filename, &pr->full_filename);
+    if (err_num != 0)
+        return err_num;
+
+    if (get_cached_dir(eh, pr->full_filename, &dir) != 0)
+        return EDITORCONFIG_PARSE_MEMORY_ERROR;
+
+    config_file_buffer = ancestor_iterator_buffer(eh, pr->full_filename,
+            stack_buffer);
+    if (config_file_buffer == NULL)
+        return EDITORCONFIG_PARSE_MEMORY_ERROR;
+    ancestor_iterator_init(&config_files, pr->full_filename,
+            eh->conf_file_name, config_file_buffer);
+    while ((config_file = ancestor_iterator_next(&config_files)) != NULL) {
+        ec_conf*            conf;
+        const char*         relative_filename;
+        /* the content hash, little endian so that the hash is portable */
+        unsigned char       content_hash[8];
+        int                 j;
+
+        err_num = load_conf(eh, dir, config_file, config_files.dir_len,
+                &conf);
+        /* ignore error caused by I/O, maybe caused by non exist file */
         if (err_num == -1) {
-          err_num = EDITORCONFIG_PARSE_MEMORY_ERROR;
-          goto cleanup;
+            err_num = 0;
+            continue;
         }
+        if (err_num != 0)
+            return EDITORCONFIG_PARSE_MEMORY_ERROR;
 
-        if ((ini_err_num = ini_parse(*config_file, ini_handler, &hfp)) != 0 &&
-                /* ignore error caused by I/O, maybe caused by non exist file */
-                ini_err_num != -1) {
+        if (conf->error_line != 0) {
             /* No need to specifically deal with the return value of the strdup
                of this line. If any error occurs for this strdup call,
                eh->err_file would simply be NULL.*/
-            eh->err_file = strdup(*config_file);
-            err_num = ini_err_num;
-            goto cleanup;
+            eh->err_file = ec_strdup(config_file);
+            return conf->error_line;
         }
 
-        free(hfp.editorconfig_file_dir);
-        hfp.editorconfig_file_dir = NULL;
+        /* root = true, clear all previous values */
+        if (conf->is_root) {
+            array_conf_property_empty(acp);
+            pr->sources_hash = EC_HASH_INIT;
+        }
+
+        /* every file from the root down contributes, even without a matching
+         * section, since editing it may change the result */
+        pr->sources_hash = ec_hash_update(pr->sources_hash, config_file,
+                strlen(config_file) + 1);
+        for (i = 0; i < 8; ++i)
+            content_hash[i] = (unsigned char)(conf->hash >> (8 * i));
+        pr->sources_hash = ec_hash_update(pr->sources_hash, content_hash,
+                sizeof(content_hash));
+
+        /* Sections are matched against the path relative to the directory of
+         * the config file, which starts with a '/' */
+        relative_filename = pr->full_filename + config_files.dir_len;
+        for (i = 0; i < conf->section_count; ++i) {
+            ec_conf_section*        section = &conf->sections[i];
+
+            if (ec_conf_section_match(section, &glob_cache,
+                        relative_filename) != 0)
+                continue;
+
+            for (j = 0; j < section->property_count; ++j)
+                if (array_conf_property_add(acp, &section->properties[j]))
+                    return EDITORCONFIG_PARSE_MEMORY_ERROR;
+        }
     }
 
     /* value proprocessing */
@@ -556,51 +769,372 @@ int editorconfig_parse(const char* full_filename, editorconfig_handle h)
     if (editorconfig_compare_version(&eh->ver, &tmp_ver) >= 0) {
     /* Set indent_size to "tab" if indent_size is not specified and
      * indent_style is set to "tab". Only should be done after v0.9 */
-        if (hfp.array_name_value.spnvp.indent_style &&
-                !hfp.array_name_value.spnvp.indent_size &&
-                !strcmp(hfp.array_name_value.spnvp.indent_style->value, "tab"))
-            array_editorconfig_name_value_add(&hfp.array_name_value,
-                    "indent_size", "tab");
+        indent_style = array_conf_property_get_special(acp,
+                SPECIAL_INDENT_STYLE);
+        indent_size = array_conf_property_get_special(acp,
+                SPECIAL_INDENT_SIZE);
+        if (indent_style && !indent_size &&
+                !strcmp(indent_style->value, "tab"))
+            array_conf_property_add_new(acp, "indent_size",
+                    EC_PROPERTY_INDENT_SIZE, "tab", 3);
     /* Set indent_size to tab_width if indent_size is "tab" and tab_width is
-     * specified. This behavior is specified for v0.9 and up. */
-        if (hfp.array_name_value.spnvp.indent_size &&
-            hfp.array_name_value.spnvp.tab_width &&
-            !strcmp(hfp.array_name_value.spnvp.indent_size->value, "tab"))
-        array_editorconfig_name_value_add(&hfp.array_name_value, "indent_size",
-                hfp.array_name_value.spnvp.tab_width->value);
+     * specified. This behavior is specified for v0.9 and up. The value of
+     * indent_size is case insensitive, so tab_width is lowercased. */
+        indent_size = array_conf_property_get_special(acp,
+                SPECIAL_INDENT_SIZE);
+        tab_width = array_conf_property_get_special(acp, SPECIAL_TAB_WIDTH);
+        if (indent_size && tab_width && !strcmp(indent_size->value, "tab")) {
+            char*       value = ec_arena_strndup(&eh->scratch_arena,
+                    tab_width->value, tab_width->value_len);
+
+            if (value != NULL)
+                array_conf_property_add_new(acp, "indent_size",
+                        EC_PROPERTY_INDENT_SIZE, strlwr(value),
+                        tab_width->value_len);
+        }
     }
 
     /* Set tab_width to indent_size if indent_size is specified. If version is
      * not less than 0.9.0, we also need to check when the indent_size is set
      * to "tab", we should not duplicate the value to tab_width */
-    if (hfp.array_name_value.spnvp.indent_size &&
-            !hfp.array_name_value.spnvp.tab_width &&
+    indent_size = array_conf_property_get_special(acp, SPECIAL_INDENT_SIZE);
+    tab_width = array_conf_property_get_special(acp, SPECIAL_TAB_WIDTH);
+    if (indent_size && !tab_width &&
             (editorconfig_compare_version(&eh->ver, &tmp_ver) < 0 ||
-             strcmp(hfp.array_name_value.spnvp.indent_size->value, "tab")))
-        array_editorconfig_name_value_add(&hfp.array_name_value, "tab_width",
-                hfp.array_name_value.spnvp.indent_size->value);
+             strcmp(indent_size->value, "tab")))
+        array_conf_property_add_new(acp, "tab_width", EC_PROPERTY_TAB_WIDTH,
+                indent_size->value, indent_size->value_len);
+
+    return 0;
+}
+
+/*
+ * See the header file for the use of this function
+ */
+EDITORCONFIG_EXPORT
+int editorconfig_parse(const char* full_filename, editorconfig_handle h)
+{
+    property_resolver                   pr;
+    int                                 err_num;
+    struct editorconfig_handle*         eh = (struct editorconfig_handle*)h;
+
+    err_num = editorconfig_check_version(eh);
+    if (err_num != 0)
+        return err_num;
+
+    /* drop the result of the previous parsing, but keep the memory */
+    editorconfig_handle_reset(h);
+
+    err_num = resolve_properties(full_filename, eh, &pr);
+    if (err_num != 0)
+        return err_num;
+
+    /* the properties are only valid until the handle is used again, so keep
+     * them in a result, shared with the other files with the same
+     * properties */
+    if (ec_result_table_intern(&eh->results, pr.properties.properties,
+                pr.properties.current_count, &eh->result) != 0)
+        return EDITORCONFIG_PARSE_MEMORY_ERROR;
+    eh->sources_hash = pr.sources_hash;
+
+    return 0;
+}
+
+/*
+ * See the header file for the use of this function
+ */
+EDITORCONFIG_EXPORT
+int editorconfig_parse_cb(const char* full_filename, editorconfig_handle h,
+        editorconfig_property_cb callback, void* user)
+{
+    property_resolver                   pr;
+    int                                 err_num;
+    int                                 i;
+    struct editorconfig_handle*         eh = (struct editorconfig_handle*)h;
+
+    err_num = editorconfig_check_version(eh);
+    if (err_num != 0)
+        return err_num;
+
+    err_num = resolve_properties(full_filename, eh, &pr);
+    if (err_num != 0)
+        return err_num;
+
+    for (i = 0; i < pr.properties.current_count; ++i) {
+        const ec_conf_property*     p = pr.properties.properties[i];
+
+        if (callback(p->name, p->name_len, p->value, p->value_len,
+                    user) != 0)
+            break;
+    }
+
+    return 0;
+}
+
+/* the most keys the value of a single property depends on */
+#define QUERY_KEY_MAX       3
+
+/*
+ * The raw values of the properties a single property is computed from, as
+ * found in the EditorConfig files.
+ */
+typedef struct
+{
+    const char*     names[QUERY_KEY_MAX];
+    /* the value of each name, NULL until found */
+    const char*     values[QUERY_KEY_MAX];
+    int             key_count;
+    int             found_count;
+} property_query;
+
+static void property_query_add_key(property_query* pq, const char* name)
+{
+    pq->names[pq->key_count] = name;
+    pq->values[pq->key_count] = NULL;
+    ++ pq->key_count;
+}
+
+/*
+ * Return the index of name in the keys of pq whose value has not been found
+ * yet, or -1.
+ */
+static int property_query_find_missing(const property_query* pq,
+        const char* name)
+{
+    int         i;
+
+    for (i = 0; i < pq->key_count; ++i)
+        if (pq->values[i] == NULL && !strcmp(pq->names[i], name))
+            return i;
+
+    return -1;
+}
+
+/*
+ * Return the raw value of name, which must be one of the keys of pq.
+ */
+static const char* property_query_get(const property_query* pq,
+        const char* name)
+{
+    int         i;
+
+    for (i = 0; i < pq->key_count; ++i)
+        if (!strcmp(pq->names[i], name))
+            return pq->values[i];
+
+    return NULL;
+}
+
+/*
+ * Look for the keys of pq in the sections of conf that match
+ * relative_filename, the last section first, compiling their patterns through
+ * glob_cache.
+ */
+static void property_query_search(property_query* pq, ec_conf* conf,
+        const ec_glob_cache* glob_cache, const char* relative_filename)
+{
+    int         i;
+    int         j;
+
+    for (i = conf->section_count - 1;
+            i >= 0 && pq->found_count < pq->key_count; --i) {
+        ec_conf_section*        section = &conf->sections[i];
+
+        /* Only match the sections that set a missing key */
+        for (j = 0; j < section->property_count; ++j)
+            if (property_query_find_missing(pq,
+                        section->properties[j].name) >= 0)
+                break;
+        if (j == section->property_count ||
+                ec_conf_section_match(section, glob_cache,
+                    relative_filename) != 0)
+            continue;
+
+        /* The last value of a key in the section wins */
+        for (j = section->property_count - 1; j >= 0; --j) {
+            int     key = property_query_find_missing(pq,
+                    section->properties[j].name);
+
+            if (key >= 0) {
+                pq->values[key] = section->properties[j].value;
+                ++ pq->found_count;
+            }
+        }
+    }
+}
+
+/*
+ * See the header file for the use of this function
+ */
+EDITORCONFIG_EXPORT
+int editorconfig_get_property(const char* full_filename, editorconfig_handle h,
+        const char* name, const char** value)
+{
+    property_query                      pq;
+    ancestor_iterator                   config_files;
+    const char*                         config_file;
+    char*                               config_file_buffer;
+    char                                stack_buffer[ANCESTOR_STACK_BUFFER_SIZE];
+    char*                               filename;
+    char                                name_lwr[MAX_PROPERTY_NAME + 1];
+    const char*                         indent_style;
+    const char*                         indent_size;
+    const char*                         tab_width;
+    ec_dir*                             dir = NULL;
+    ec_glob_cache                       glob_cache;
+    int                                 err_num;
+    _Bool                               is_v09;
+    struct editorconfig_handle*         eh = (struct editorconfig_handle*)h;
+    struct editorconfig_version         tmp_ver;
+
+    *value = NULL;
+
+    err_num = editorconfig_check_version(eh);
+    if (err_num != 0)
+        return err_num;
 
-    eh->name_value_count = hfp.array_name_value.current_value_count;
+    err_num = editorconfig_begin_parse(eh, full_filename, &filename);
+    if (err_num != 0)
+        return err_num;
 
-    if (eh->name_value_count == 0) {  /* no value is set, just return 0. */
-        free(hfp.full_filename);
-        free_filenames(config_files);
+    if (get_cached_dir(eh, filename, &dir) != 0)
+        return EDITORCONFIG_PARSE_MEMORY_ERROR;
+
+    get_glob_cache(eh, &glob_cache);
+
+    /* no property can have a longer name */
+    if (strlen(name) > MAX_PROPERTY_NAME)
         return 0;
+    strlwr(strcpy(name_lwr, name));
+
+    SET_EDITORCONFIG_VERSION(&tmp_ver, 0, 9, 0);
+    is_v09 = editorconfig_compare_version(&eh->ver, &tmp_ver) >= 0;
+
+    /* indent_size and tab_width are computed from each other, and from
+     * indent_style for v0.9 and up; see resolve_properties() */
+    memset(&pq, 0, sizeof(pq));
+    property_query_add_key(&pq, name_lwr);
+    if (!strcmp(name_lwr, "indent_size")) {
+        property_query_add_key(&pq, "tab_width");
+        if (is_v09)
+            property_query_add_key(&pq, "indent_style");
+    } else if (!strcmp(name_lwr, "tab_width"))
+        property_query_add_key(&pq, "indent_size");
+
+    config_file_buffer = ancestor_iterator_buffer(eh, filename,
+            stack_buffer);
+    if (config_file_buffer == NULL)
+        return EDITORCONFIG_PARSE_MEMORY_ERROR;
+
+    /* The nearest EditorConfig files have the last word, so stop as soon as
+     * all the keys are found */
+    ancestor_iterator_init_upwards(&config_files, filename,
+            eh->conf_file_name, config_file_buffer);
+    while (pq.found_count < pq.key_count &&
+            (config_file = ancestor_iterator_next_upwards(&config_files))
+            != NULL) {
+        ec_conf*            conf;
+
+        err_num = load_conf(eh, dir, config_file, config_files.dir_len, &conf);
+        /* ignore error caused by I/O, maybe caused by non exist file */
+        if (err_num == -1) {
+            err_num = 0;
+            continue;
+        }
+        if (err_num != 0)
+            return EDITORCONFIG_PARSE_MEMORY_ERROR;
+
+        if (conf->error_line != 0) {
+            eh->err_file = ec_strdup(config_file);
+            return conf->error_line;
+        }
+
+        property_query_search(&pq, conf, &glob_cache,
+                filename + config_files.dir_len);
+
+        /* root = true, the files above do not apply */
+        if (conf->is_root)
+            break;
+    }
+
+    /* Same post-processing as resolve_properties() */
+    indent_size = property_query_get(&pq, "indent_size");
+    tab_width = property_query_get(&pq, "tab_width");
+    if (is_v09 && !indent_size) {
+        indent_style = property_query_get(&pq, "indent_style");
+        if (indent_style && !strcmp(indent_style, "tab"))
+            indent_size = "tab";
     }
-    eh->name_values = hfp.array_name_value.name_values;
-    eh->name_values = realloc(      /* realloc to truncate the unused spaces */
-            eh->name_values,
-            sizeof(editorconfig_name_value) * eh->name_value_count);
-    if (eh->name_values == NULL) {
-        free(hfp.full_filename);
-        free_filenames(config_files);
+
+    if (!strcmp(name_lwr, "indent_size")) {
+        if (is_v09 && indent_size && tab_width &&
+                !strcmp(indent_size, "tab")) {
+            /* indent_size is lowercased, but tab_width is not */
+            char*       lowercased = ec_arena_strndup(&eh->scratch_arena,
+                    tab_width, strlen(tab_width));
+
+            if (lowercased == NULL)
+                return EDITORCONFIG_PARSE_MEMORY_ERROR;
+            indent_size = strlwr(lowercased);
+        }
+        *value = indent_size;
+    } else if (!strcmp(name_lwr, "tab_width")) {
+        if (!tab_width && indent_size &&
+                (!is_v09 || strcmp(indent_size, "tab")))
+            tab_width = indent_size;
+        *value = tab_width;
+    } else
+        *value = pq.values[0];
+
+    return 0;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_EXPORT
+int editorconfig_write_index(const char* path, const char* const* conf_files,
+        int count)
+{
+    ec_disk_cache       index;
+    ec_conf_cache       conf_cache;
+    ec_conf*            conf;
+    int                 err_num;
+    int                 i;
+
+    memset(&index, 0, sizeof(index));
+    memset(&conf_cache, 0, sizeof(conf_cache));
+
+    err_num = ec_disk_cache_open_index(&index, path, 1);
+    if (err_num == -2)
         return EDITORCONFIG_PARSE_MEMORY_ERROR;
+    if (err_num != 0)
+        return -1;
+
+    for (i = 0; i < count; ++i) {
+        if (!ec_disk_cache_covers(&index, conf_files[i])) {
+            err_num = i + 1;
+            break;
+        }
+
+        err_num = ec_conf_cache_load(&conf_cache, &index, conf_files[i],
+                &conf);
+        if (err_num == -1) {
+            err_num = i + 1;
+            break;
+        }
+        if (err_num != 0) {
+            err_num = EDITORCONFIG_PARSE_MEMORY_ERROR;
+            break;
+        }
     }
 
- cleanup:
-    free_filenames(config_files);
-    free(hfp.full_filename);
-    free(hfp.editorconfig_file_dir);
+    /* nothing is written if a file is missing */
+    if (err_num != 0)
+        ec_disk_cache_discard(&index);
+    if (ec_disk_cache_close(&index) != 0 && err_num == 0)
+        err_num = -1;
+    ec_conf_cache_clear(&conf_cache);
 
     return err_num;
 }
@@ -31,7 +31,5 @@
 
 #include "editorconfig_handle.h"
 
-typedef struct editorconfig_name_value editorconfig_name_value;
-
 #endif /* !EDITORCONFIG_H__ */
 
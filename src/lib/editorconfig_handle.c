@@ -24,7 +24,9 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include "editorconfig_handle.h"
+#include "global.h"
+#include "editorconfig.h"
+#include "ec_alloc.h"
 
 /*
  * See header file
@@ -34,7 +36,7 @@ editorconfig_handle editorconfig_handle_init(void)
 {
     editorconfig_handle     h;
     
-    h = (editorconfig_handle)malloc(sizeof(struct editorconfig_handle));
+    h = (editorconfig_handle)ec_malloc(sizeof(struct editorconfig_handle));
 
     if (!h)
         return (editorconfig_handle)NULL;
@@ -50,30 +52,51 @@ editorconfig_handle editorconfig_handle_init(void)
 EDITORCONFIG_EXPORT
 int editorconfig_handle_destroy(editorconfig_handle h)
 {
-    int                             i;
     struct editorconfig_handle*     eh = (struct editorconfig_handle*)h;
 
 
     if (h == NULL)
         return 0;
 
-    /* free name_values */
-    for (i = 0; i < eh->name_value_count; ++i) {
-        free(eh->name_values[i].name);
-        free(eh->name_values[i].value);
-    }
-    free(eh->name_values);
+    /* free the results, unless they are still referenced, and everything
+     * allocated while parsing */
+    ec_result_table_clear(&eh->results);
+    ec_arena_free(&eh->scratch_arena);
 
     /* free err_file */
     if (eh->err_file)
-        free(eh->err_file);
+        ec_free(eh->err_file);
+
+    /* free the parsed EditorConfig files, and the directories they apply
+     * to */
+    ec_watch_close(&eh->watch);
+    ec_dir_cache_clear(&eh->dir_cache);
+    ec_disk_cache_close(&eh->disk_cache);
+    ec_disk_cache_close(&eh->index);
+    ec_conf_cache_clear(&eh->conf_cache);
 
     /* free eh itself */
-    free(eh);
+    ec_free(eh);
 
     return 0;
 }
 
+/*
+ * See header file
+ */
+EDITORCONFIG_EXPORT
+void editorconfig_handle_reset(editorconfig_handle h)
+{
+    struct editorconfig_handle*     eh = (struct editorconfig_handle*)h;
+
+    ec_arena_reset(&eh->scratch_arena);
+    eh->result = NULL;
+    eh->sources_hash = 0;
+
+    ec_free(eh->err_file);
+    eh->err_file = NULL;
+}
+
 /*
  * See header file
  */
@@ -122,7 +145,123 @@ EDITORCONFIG_EXPORT
 void editorconfig_handle_set_conf_file_name(editorconfig_handle h,
         const char* conf_file_name)
 {
-    ((struct editorconfig_handle*)h)->conf_file_name = conf_file_name;
+    struct editorconfig_handle*     eh = (struct editorconfig_handle*)h;
+
+    eh->conf_file_name = conf_file_name;
+
+    /* the directories have other EditorConfig files now */
+    ec_dir_cache_clear(&eh->dir_cache);
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_EXPORT
+void editorconfig_handle_set_directory_cache(editorconfig_handle h,
+        int enabled)
+{
+    struct editorconfig_handle*     eh = (struct editorconfig_handle*)h;
+
+    eh->is_dir_cache_enabled = enabled != 0;
+    if (!enabled)
+        ec_dir_cache_clear(&eh->dir_cache);
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_EXPORT
+int editorconfig_handle_set_watch(editorconfig_handle h, int enabled)
+{
+    struct editorconfig_handle*     eh = (struct editorconfig_handle*)h;
+
+    if (!enabled == !eh->watch.is_enabled)
+        return 0;
+
+    /* the directories cached so far are not watched, and those cached from
+     * now on will not be */
+    ec_dir_cache_clear(&eh->dir_cache);
+    eh->watch_change_count = 0;
+
+    if (!enabled) {
+        ec_watch_close(&eh->watch);
+        return 0;
+    }
+
+    return ec_watch_open(&eh->watch);
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_EXPORT
+int editorconfig_handle_get_watch_fd(const editorconfig_handle h)
+{
+    const struct editorconfig_handle*   eh =
+        (const struct editorconfig_handle*)h;
+
+    return eh->watch.is_enabled ? eh->watch.fd : -1;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_EXPORT
+int editorconfig_handle_process_watch_events(editorconfig_handle h)
+{
+    struct editorconfig_handle*     eh = (struct editorconfig_handle*)h;
+    int                             change_count;
+
+    if (!eh->watch.is_enabled)
+        return 0;
+
+    change_count = eh->watch_change_count + ec_watch_read(&eh->watch,
+            eh->conf_file_name ? eh->conf_file_name : ".editorconfig",
+            &eh->dir_cache);
+    eh->watch_change_count = 0;
+
+    return change_count;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_EXPORT
+int editorconfig_handle_set_persistent_cache(editorconfig_handle h,
+        int enabled, const char* path)
+{
+    struct editorconfig_handle*     eh = (struct editorconfig_handle*)h;
+    int                             err_num;
+
+    ec_disk_cache_close(&eh->disk_cache);
+    if (!enabled)
+        return 0;
+
+    err_num = ec_disk_cache_open(&eh->disk_cache, path);
+    if (err_num == -2)
+        return EDITORCONFIG_PARSE_MEMORY_ERROR;
+
+    return err_num;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_EXPORT
+int editorconfig_handle_set_index(editorconfig_handle h, const char* path)
+{
+    struct editorconfig_handle*     eh = (struct editorconfig_handle*)h;
+    int                             err_num;
+
+    ec_disk_cache_close(&eh->index);
+    if (path == NULL)
+        return 0;
+
+    err_num = ec_disk_cache_open_index(&eh->index, path, 0);
+    if (err_num == -2)
+        return EDITORCONFIG_PARSE_MEMORY_ERROR;
+
+    return err_num;
 }
 
 /*
@@ -138,18 +277,121 @@ EDITORCONFIG_EXPORT
 void editorconfig_handle_get_name_value(const editorconfig_handle h, int n,
         const char** name, const char** value)
 {
-    struct editorconfig_name_value* name_value = &((
-                const struct editorconfig_handle*)h)->name_values[n];
+    editorconfig_result_get_name_value(
+            ((const struct editorconfig_handle*)h)->result, n, name, value);
+}
+
+EDITORCONFIG_EXPORT
+int editorconfig_handle_get_name_value_count(const editorconfig_handle h)
+{
+    return editorconfig_result_get_name_value_count(
+            ((const struct editorconfig_handle*)h)->result);
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_EXPORT
+editorconfig_result editorconfig_handle_get_result(const editorconfig_handle h)
+{
+    return editorconfig_result_ref(
+            ((const struct editorconfig_handle*)h)->result);
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_EXPORT
+editorconfig_result editorconfig_result_ref(editorconfig_result r)
+{
+    if (r != NULL)
+        ++ ((ec_result*)r)->refcount;
+
+    return r;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_EXPORT
+void editorconfig_result_unref(editorconfig_result r)
+{
+    if (r != NULL)
+        ec_result_unref((ec_result*)r);
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_EXPORT
+void editorconfig_result_get_name_value(const editorconfig_result r, int n,
+        const char** name, const char** value)
+{
+    const ec_result*    result = (const ec_result*)r;
 
     if (name)
-        *name = name_value->name;
+        *name = result->strings + result->offsets[2 * n];
 
     if (value)
-        *value = name_value->value;
+        *value = result->strings + result->offsets[2 * n + 1];
 }
 
+/*
+ * See header file
+ */
 EDITORCONFIG_EXPORT
-int editorconfig_handle_get_name_value_count(const editorconfig_handle h)
+int editorconfig_result_get_name_value_count(const editorconfig_result r)
+{
+    if (r == NULL)
+        return 0;
+
+    return ((const ec_result*)r)->count;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_EXPORT
+int editorconfig_handle_get_fingerprint(const editorconfig_handle h,
+        uint64_t* properties_hash, uint64_t* sources_hash)
+{
+    const struct editorconfig_handle*   eh =
+        (const struct editorconfig_handle*)h;
+
+    if (eh->result == NULL)
+        return -1;
+
+    if (properties_hash)
+        *properties_hash = eh->result->hash;
+
+    if (sources_hash)
+        *sources_hash = eh->sources_hash;
+
+    return 0;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_EXPORT
+const editorconfig_properties* editorconfig_result_get_properties(
+        const editorconfig_result r)
+{
+    static const editorconfig_properties    unset_properties;
+
+    if (r == NULL)
+        return &unset_properties;
+
+    return &((const ec_result*)r)->properties;
+}
+
+/*
+ * See header file
+ */
+EDITORCONFIG_EXPORT
+const editorconfig_properties* editorconfig_handle_get_properties(
+        const editorconfig_handle h)
 {
-    return ((const struct editorconfig_handle*)h)->name_value_count;
+    return editorconfig_result_get_properties(
+            ((const struct editorconfig_handle*)h)->result);
 }
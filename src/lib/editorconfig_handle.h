@@ -30,17 +30,12 @@
 #include "global.h"
 #include <editorconfig/editorconfig_handle.h>
 
-/*!
- * @brief A structure containing a name and its corresponding value.
- * @author EditorConfig Team
- */
-struct editorconfig_name_value
-{
-    /*! EditorConfig config item's name. */ 
-    char*       name;
-    /*! EditorConfig config item's value. */ 
-    char*       value;
-};
+#include "ec_arena.h"
+#include "ec_conf.h"
+#include "ec_dir_cache.h"
+#include "ec_disk_cache.h"
+#include "ec_result.h"
+#include "ec_watch.h"
 
 /*!
  * @brief A structure that descripts version number.
@@ -76,13 +71,49 @@ struct editorconfig_handle
      */
     struct editorconfig_version         ver;
 
-    /*! Pointer to a list of editorconfig_name_value structures containing
-     * names and values of the parsed result */
-    struct editorconfig_name_value*     name_values;
+    /*! The parsed result, owned by results, or NULL */
+    ec_result*                          result;
+
+    /*! Hash of the EditorConfig files result was resolved from */
+    uint64_t                            sources_hash;
+
+    /*! EditorConfig files parsed by this handle, shared between the files
+     * with the same content */
+    ec_conf_cache                       conf_cache;
+
+    /*! Whether the EditorConfig files that apply to each directory are kept
+     * in dir_cache */
+    _Bool                               is_dir_cache_enabled;
+
+    /*! The EditorConfig files that apply to the directories seen so far, if
+     * is_dir_cache_enabled is set */
+    ec_dir_cache                        dir_cache;
+
+    /*! The directories of dir_cache watched for changes, if it is enabled,
+     * in which case dir_cache is used even if is_dir_cache_enabled is not
+     * set */
+    ec_watch                            watch;
+
+    /*! The changes seen by watch since the last call to
+     * editorconfig_handle_process_watch_events() */
+    int                                 watch_change_count;
+
+    /*! The cache of the parsed EditorConfig files kept across processes, if
+     * it is open */
+    ec_disk_cache                       disk_cache;
+
+    /*! The index the parsed EditorConfig files of its directory tree are taken
+     * from, if it is open */
+    ec_disk_cache                       index;
+
+    /*! All the distinct results of editorconfig_parse() with this handle,
+     * so that the files with the same properties share them */
+    ec_result_table                     results;
 
-    /*! The total count of name_values structures pointed by name_values
-     * pointer */
-    int                                 name_value_count;
+    /*! Memory used while parsing, which results of editorconfig_parse_cb()
+     * and editorconfig_get_property() may point to. Reset at the beginning of
+     * each parsing. */
+    ec_arena                            scratch_arena;
 };
 
 #endif /* !EDITORCONFIG_HANDLE_H__ */
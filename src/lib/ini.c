@@ -99,10 +99,10 @@ static char* strncpy0(char* dest, const char* src, size_t size)
 
 /* See documentation in header file. */
 EDITORCONFIG_LOCAL
-int ini_parse_file(FILE* file,
-                   int (*handler)(void*, const char*, const char*,
-                                  const char*),
-                   void* user)
+int ini_parse_stream(ini_reader reader, void* stream,
+                     int (*handler)(void*, const char*, const char*,
+                                    const char*),
+                     void* user)
 {
     /* Uses a fair bit of stack (use heap instead if you need to) */
     char line[MAX_LINE];
@@ -116,8 +116,8 @@ int ini_parse_file(FILE* file,
     int lineno = 0;
     int error = 0;
 
-    /* Scan through file line by line */
-    while (fgets(line, sizeof(line), file) != NULL) {
+    /* Scan through stream line by line */
+    while (reader(line, (int)sizeof(line), stream) != NULL) {
         lineno++;
 
         start = line;
@@ -192,6 +192,141 @@ int ini_parse_file(FILE* file,
     return error;
 }
 
+/* An ini_reader function to read the next line from a FILE*. */
+static char* ini_reader_file(char* str, int num, void* stream)
+{
+    return fgets(str, num, (FILE*)stream);
+}
+
+/* See documentation in header file. */
+EDITORCONFIG_LOCAL
+int ini_parse_file(FILE* file,
+                   int (*handler)(void*, const char*, const char*,
+                                  const char*),
+                   void* user)
+{
+    return ini_parse_stream(ini_reader_file, file, handler, user);
+}
+
+/* Stream of an in-memory string, used by ini_parse_string(). */
+typedef struct {
+    const char* ptr;
+    size_t num_left;
+} ini_parse_string_ctx;
+
+/* An ini_reader function to read the next line from a string, with the same
+   semantics as fgets(). */
+static char* ini_reader_string(char* str, int num, void* stream)
+{
+    ini_parse_string_ctx* ctx = (ini_parse_string_ctx*)stream;
+    const char* ctx_ptr = ctx->ptr;
+    size_t ctx_num_left = ctx->num_left;
+    char* strp = str;
+    char c;
+
+    if (ctx_num_left == 0 || num < 2)
+        return NULL;
+
+    while (num > 1 && ctx_num_left != 0) {
+        c = *ctx_ptr++;
+        ctx_num_left--;
+        *strp++ = c;
+        if (c == '\n')
+            break;
+        num--;
+    }
+
+    *strp = '\0';
+    ctx->ptr = ctx_ptr;
+    ctx->num_left = ctx_num_left;
+    return str;
+}
+
+/* See documentation in header file. */
+EDITORCONFIG_LOCAL
+int ini_parse_string(const char* string, size_t length,
+                     int (*handler)(void*, const char*, const char*,
+                                    const char*),
+                     void* user)
+{
+    ini_parse_string_ctx ctx;
+
+    ctx.ptr = string;
+    ctx.num_left = length;
+    return ini_parse_stream(ini_reader_string, &ctx, handler, user);
+}
+
+/* Whether the given line, as read by a reader, is a valid "[section]" line
+   that ini_parse_stream() would start a new section at. Modifies line. */
+static int is_section_line(char* line)
+{
+    char* start = lskip(rstrip(line));
+    char* end;
+
+    if (*start != '[')
+        return 0;
+    end = find_last_char_or_comment(start + 1, ']');
+    return *end == ']' && end - start - 1 <= MAX_SECTION_NAME;
+}
+
+/* See documentation in header file. */
+EDITORCONFIG_LOCAL
+size_t ini_find_section_line(const char* string, size_t length, size_t offset)
+{
+    char line[MAX_LINE];
+    const char* newline;
+    size_t line_length;
+
+    /* Move to the beginning of the first line at or after offset */
+    if (offset > 0) {
+        newline = (const char*)memchr(string + offset - 1, '\n',
+                                      length - offset + 1);
+        if (newline == NULL)
+            return length;
+        offset = (size_t)(newline - string) + 1;
+    }
+
+    while (offset < length) {
+        newline = (const char*)memchr(string + offset, '\n', length - offset);
+        line_length = newline ? (size_t)(newline - string) + 1 - offset :
+                                length - offset;
+
+        /* Only the first part of a long line is looked at, like a reader
+           would do */
+        strncpy0(line, string + offset,
+                 (line_length < sizeof(line) ? line_length : sizeof(line) - 1)
+                 + 1);
+        if (is_section_line(line))
+            return offset;
+
+        offset += line_length;
+    }
+
+    return length;
+}
+
+/* See documentation in header file. */
+EDITORCONFIG_LOCAL
+int ini_count_lines(const char* string, size_t length)
+{
+    const char* newline;
+    size_t line_length;
+    int count = 0;
+
+    while (length > 0) {
+        line_length = length < MAX_LINE - 1 ? length : MAX_LINE - 1;
+        newline = (const char*)memchr(string, '\n', line_length);
+        if (newline != NULL)
+            line_length = (size_t)(newline - string) + 1;
+
+        string += line_length;
+        length -= line_length;
+        ++count;
+    }
+
+    return count;
+}
+
 /* See documentation in header file. */
 EDITORCONFIG_LOCAL
 int ini_parse(const char* filename,
@@ -44,6 +44,9 @@ extern "C" {
 
 #include <stdio.h>
 
+/* Typedef for prototype of fgets-style reader function. */
+typedef char* (*ini_reader)(char* str, int num, void* stream);
+
 /* Parse given INI-style file. May have [section]s, name=value pairs
    (whitespace stripped), and comments starting with ';' (semicolon). Section
    is "" if name=value pair parsed before any section heading. name:value
@@ -70,6 +73,36 @@ int ini_parse_file(FILE* file,
                                   const char* name, const char* value),
                    void* user);
 
+/* Same as ini_parse(), but takes an ini_reader function pointer instead of
+   filename. Used for implementing custom or string-based I/O. */
+EDITORCONFIG_LOCAL
+int ini_parse_stream(ini_reader reader, void* stream,
+                     int (*handler)(void* user, const char* section,
+                                    const char* name, const char* value),
+                     void* user);
+
+/* Same as ini_parse(), but takes the content of the INI file as a string of
+   the given length instead of filename. The string may contain null
+   characters and does not need to be null terminated. */
+EDITORCONFIG_LOCAL
+int ini_parse_string(const char* string, size_t length,
+                     int (*handler)(void* user, const char* section,
+                                    const char* name, const char* value),
+                     void* user);
+
+/* Return the offset in string of the first line at or after offset that is a
+   "[section]" line, or length if there is none. ini_parse_string() run on the
+   string from that line on starts in the same state as when it reaches that
+   line, apart from the line number, so a large string may be split there and
+   parsed in pieces. */
+EDITORCONFIG_LOCAL
+size_t ini_find_section_line(const char* string, size_t length, size_t offset);
+
+/* Return the number of lines ini_parse_string() reads from string, which is
+   what its line numbers are based on. */
+EDITORCONFIG_LOCAL
+int ini_count_lines(const char* string, size_t length);
+
 /* Nonzero to allow multi-line value parsing, in the style of Python's
    ConfigParser. If allowed, ini_parse() will call the handler with the same
    name for each subsequent line parsed. */
@@ -26,6 +26,7 @@
 
 
 #include "misc.h"
+#include "ec_alloc.h"
 
 #ifdef WIN32
 # include <shlwapi.h>
@@ -82,7 +83,6 @@ int ec_strcasecmp(const char *s1, const char *s2)
 }
 #endif /* !HAVE_STRCASECMP && !HAVE_STRICMP */
 
-#ifndef HAVE_STRDUP
 /*
  * strdup function from FreeBSD
  *
@@ -125,16 +125,13 @@ char* ec_strdup(const char *str)
     char*       copy;
 
     len = strlen(str) + 1;
-    if ((copy = malloc(len)) == NULL)
+    if ((copy = ec_malloc(len)) == NULL)
         return (NULL);
     memcpy(copy, str, len);
     return (copy);
 }
 
-#endif /* !HAVE_STRDUP */
 
-
-#ifndef HAVE_STRNDUP
 /*
  * strndup function from NetBSD
  *
@@ -183,15 +180,13 @@ char* ec_strndup(const char* str, size_t n)
     for (len = 0; len < n && str[len]; len++)
         continue;
 
-    if ((copy = malloc(len + 1)) == NULL)
+    if ((copy = ec_malloc(len + 1)) == NULL)
         return (NULL);
     memcpy(copy, str, len);
     copy[len] = '\0';
     return (copy);
 }
 
-#endif /* HAVE_STRNDUP */
-
 /*
  * replace oldc with newc in the string str
  */
@@ -248,3 +243,29 @@ _Bool is_file_path_absolute(const char* path)
 # error "Either UNIX or WIN32 must be defined."
 #endif
 }
+
+/*
+ * 64-bit FNV-1a hash of size bytes pointed by data
+ */
+EDITORCONFIG_LOCAL
+uint64_t ec_hash(const void* data, size_t size)
+{
+    return ec_hash_update(EC_HASH_INIT, data, size);
+}
+
+/*
+ * Continue a 64-bit FNV-1a hash with size more bytes pointed by data
+ */
+EDITORCONFIG_LOCAL
+uint64_t ec_hash_update(uint64_t hash, const void* data, size_t size)
+{
+    const unsigned char*    p = (const unsigned char*)data;
+    size_t                  i;
+
+    for (i = 0; i < size; ++i) {
+        hash ^= p[i];
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
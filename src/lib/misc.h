@@ -30,6 +30,7 @@
 #include "global.h"
 
 #include <stddef.h>
+#include <stdint.h>
 
 #ifndef HAVE_STRCASECMP
 # ifdef HAVE_STRICMP
@@ -40,16 +41,11 @@ int ec_strcasecmp(const char *s1, const char *s2);
 # define strcasecmp ec_strcasecmp
 # endif /* HAVE_STRICMP */
 #endif /* !HAVE_STRCASECMP */
-#ifndef HAVE_STRDUP
+/* strdup() and strndup() allocating with ec_malloc() */
 EDITORCONFIG_LOCAL
 char* ec_strdup(const char *str);
-# define strdup ec_strdup
-#endif
-#ifndef HAVE_STRNDUP
 EDITORCONFIG_LOCAL
 char* ec_strndup(const char* str, size_t n);
-# define strndup ec_strndup
-#endif
 EDITORCONFIG_LOCAL
 char* str_replace(char* str, char oldc, char newc);
 #ifndef HAVE_STRLWR
@@ -59,5 +55,11 @@ char* ec_strlwr(char* str);
 #endif
 EDITORCONFIG_LOCAL
 _Bool is_file_path_absolute(const char* path);
+EDITORCONFIG_LOCAL
+uint64_t ec_hash(const void* data, size_t size);
+/* the hash of no data, to start hashing with ec_hash_update() */
+#define EC_HASH_INIT    0xcbf29ce484222325ULL
+EDITORCONFIG_LOCAL
+uint64_t ec_hash_update(uint64_t hash, const void* data, size_t size);
 
 #endif /* !MISC_H__ */
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Benchmarks the accumulation of the resolved properties. For each number of
+ * keys, an EditorConfig file setting each key in two sections is written to
+ * the directory given as the argument, and a file matching both sections is
+ * parsed repeatedly. The properties must keep the value of the last section
+ * and the order in which they were first set, and the time per property line
+ * must stay flat up to thousands of keys.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <editorconfig/editorconfig.h>
+
+#define MAX_PATH_LEN        4096
+
+/* The property lines parsed in each timed batch, and the batches of which the
+ * fastest is kept */
+#define LINES_PER_BATCH     (200 * 1000)
+#define BATCH_COUNT         5
+
+/* The time per line of the larger files may be this much longer than that of
+ * REFERENCE_KEY_COUNT keys, below which the fixed cost of a parse dominates */
+#define MAX_SLOWDOWN        3.0
+#define REFERENCE_KEY_COUNT 100
+
+static const int        key_counts[] = { 10, 100, 1000, 4000 };
+
+#define KEY_COUNT_COUNT     (sizeof(key_counts) / sizeof(key_counts[0]))
+
+/* The fixed memory build allocates nothing until it is given an allocator */
+static void* test_malloc(size_t size, void* user)
+{
+    (void)user;
+    return malloc(size);
+}
+
+static void* test_realloc(void* ptr, size_t size, void* user)
+{
+    (void)user;
+    return realloc(ptr, size);
+}
+
+static void test_free(void* ptr, void* user)
+{
+    (void)user;
+    free(ptr);
+}
+
+/*
+ * Write the EditorConfig file of key_count keys to path. Return 0 on success.
+ */
+static int write_conf_file(const char* path, int key_count)
+{
+    FILE*               f = fopen(path, "w");
+    int                 i;
+
+    if (f == NULL)
+        return -1;
+    fprintf(f, "root = true\n\n[*]\n");
+    for (i = 0; i < key_count; ++i)
+        fprintf(f, "key%d = first\n", i);
+    fprintf(f, "\n[*.c]\n");
+    for (i = 0; i < key_count; ++i)
+        fprintf(f, "key%d = last\n", i);
+
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+/*
+ * Return 0 if the properties of the last file parsed with h are the
+ * key_count keys, in order, with the values of the last section.
+ */
+static int check_properties(editorconfig_handle h, int key_count)
+{
+    char                expected_name[32];
+    int                 i;
+
+    if (editorconfig_handle_get_name_value_count(h) != key_count)
+        return -1;
+    for (i = 0; i < key_count; ++i) {
+        const char*     name;
+        const char*     value;
+
+        editorconfig_handle_get_name_value(h, i, &name, &value);
+        sprintf(expected_name, "key%d", i);
+        if (strcmp(name, expected_name) != 0 || strcmp(value, "last") != 0)
+            return -1;
+    }
+
+    return 0;
+}
+
+/*
+ * Return the CPU time of the fastest of BATCH_COUNT batches of parsings of
+ * path with h, divided by the number of property lines they went through.
+ */
+static double time_per_line(editorconfig_handle h, const char* path,
+        int key_count)
+{
+    int                 count = LINES_PER_BATCH / (2 * key_count);
+    double              best = -1;
+    int                 batch;
+    int                 i;
+
+    for (batch = 0; batch < BATCH_COUNT; ++batch) {
+        clock_t         start = clock();
+        double          elapsed;
+
+        for (i = 0; i < count; ++i)
+            editorconfig_parse(path, h);
+        elapsed = (double)(clock() - start);
+        if (best < 0 || elapsed < best)
+            best = elapsed;
+    }
+
+    return best / (count * 2.0 * key_count);
+}
+
+int main(int argc, const char* argv[])
+{
+    static const editorconfig_allocator allocator = {
+        test_malloc, test_realloc, test_free, NULL
+    };
+    char                conf_path[MAX_PATH_LEN];
+    char                file_path[MAX_PATH_LEN];
+    double              times[KEY_COUNT_COUNT];
+    double              reference_time = 0;
+    int                 failure_count = 0;
+    size_t              i;
+
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s WORK_DIR\n", argv[0]);
+        return 2;
+    }
+
+    if (editorconfig_set_allocator(&allocator) != 0) {
+        fprintf(stderr, "Failed to set the allocator.\n");
+        return 1;
+    }
+
+    printf("   keys    ns per property line\n");
+    for (i = 0; i < KEY_COUNT_COUNT; ++i) {
+        editorconfig_handle h;
+        char            conf_name[32];
+        int             len;
+        int             err_num;
+
+        /* one file name per size, so that they share the directory */
+        sprintf(conf_name, ".editorconfig-%d", key_counts[i]);
+        len = snprintf(conf_path, MAX_PATH_LEN, "%s/%s", argv[1], conf_name);
+        if (len < 0 || len >= MAX_PATH_LEN ||
+                snprintf(file_path, MAX_PATH_LEN, "%s/file.c", argv[1]) >=
+                MAX_PATH_LEN) {
+            fprintf(stderr, "The work directory path is too long.\n");
+            return 2;
+        }
+        if (write_conf_file(conf_path, key_counts[i]) != 0) {
+            fprintf(stderr, "Failed to write \"%s\".\n", conf_path);
+            return 2;
+        }
+
+        h = editorconfig_handle_init();
+        if (h == NULL) {
+            fprintf(stderr, "Failed to create the handle.\n");
+            return 1;
+        }
+        editorconfig_handle_set_conf_file_name(h, conf_name);
+
+        err_num = editorconfig_parse(file_path, h);
+        if (err_num != 0) {
+            fprintf(stderr, "%d keys: editorconfig_parse() returned %d\n",
+                    key_counts[i], err_num);
+            ++ failure_count;
+        } else if (check_properties(h, key_counts[i]) != 0) {
+            fprintf(stderr, "%d keys: wrong properties\n", key_counts[i]);
+            ++ failure_count;
+        }
+
+        times[i] = time_per_line(h, file_path, key_counts[i]) * 1e9 /
+            CLOCKS_PER_SEC;
+        printf("%7d %10.0f\n", key_counts[i], times[i]);
+        if (key_counts[i] == REFERENCE_KEY_COUNT)
+            reference_time = times[i];
+
+        editorconfig_handle_destroy(h);
+        remove(conf_path);
+    }
+
+    for (i = 0; i < KEY_COUNT_COUNT; ++i) {
+        if (key_counts[i] > REFERENCE_KEY_COUNT &&
+                times[i] > reference_time * MAX_SLOWDOWN) {
+            fprintf(stderr, "%d keys take %.3g times longer per line than "
+                    "%d keys.\n", key_counts[i], times[i] / reference_time,
+                    REFERENCE_KEY_COUNT);
+            ++ failure_count;
+        }
+    }
+
+    return failure_count == 0 ? 0 : 1;
+}
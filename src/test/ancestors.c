@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Checks that looking up the EditorConfig files of a path costs the same
+ * number of allocations whatever its depth, and a time linear in its depth.
+ * Paths of depth 64, 256 and 1024 under a directory that does not exist are
+ * parsed with one handle, counting the calls to the allocator given to
+ * editorconfig_set_allocator().
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <editorconfig/editorconfig.h>
+
+/* Not created, so that no EditorConfig file is found in the path */
+#define ROOT                "/editorconfig-ancestors-test"
+
+#define FILE_NAME           "/file.c"
+
+/* The length of the paths that fit in the buffer the iterator keeps on the
+ * stack, which must be taken from the allocator for the longer ones */
+#define STACK_PATH_LEN      1000
+
+/* The parent directories looked up in each timed batch, and the batches of
+ * which the fastest is kept */
+#define LEVELS_PER_BATCH    (64 * 1024)
+#define BATCH_COUNT         5
+
+/* The time per level may vary this much between the depths */
+#define MAX_SLOWDOWN        2.0
+
+static const int        depths[] = { 64, 256, 1024 };
+
+#define DEPTH_COUNT         (sizeof(depths) / sizeof(depths[0]))
+
+static unsigned long    allocation_count;
+
+static void* counting_malloc(size_t size, void* user)
+{
+    (void)user;
+    ++ allocation_count;
+    return malloc(size);
+}
+
+static void* counting_realloc(void* ptr, size_t size, void* user)
+{
+    (void)user;
+    ++ allocation_count;
+    return realloc(ptr, size);
+}
+
+static void counting_free(void* ptr, void* user)
+{
+    (void)user;
+    free(ptr);
+}
+
+/*
+ * Return a path of the given depth under ROOT, which must be freed.
+ */
+static char* make_path(int depth)
+{
+    char*               path = (char*)malloc(sizeof(ROOT) + 2 * depth +
+            sizeof(FILE_NAME));
+    char*               p;
+    int                 i;
+
+    if (path == NULL) {
+        perror("Unable to allocate memory");
+        exit(2);
+    }
+    strcpy(path, ROOT);
+    p = path + strlen(path);
+    for (i = 0; i < depth; ++i) {
+        *p++ = '/';
+        *p++ = 'd';
+    }
+    strcpy(p, FILE_NAME);
+
+    return path;
+}
+
+/*
+ * Return the CPU time of the fastest of BATCH_COUNT batches of lookups of
+ * path with h, divided by the number of levels they went through.
+ */
+static double time_per_level(editorconfig_handle h, const char* path,
+        int depth)
+{
+    int                 count = LEVELS_PER_BATCH / depth;
+    double              best = -1;
+    int                 batch;
+    int                 i;
+
+    for (batch = 0; batch < BATCH_COUNT; ++batch) {
+        clock_t         start = clock();
+        double          elapsed;
+
+        for (i = 0; i < count; ++i)
+            editorconfig_parse(path, h);
+        elapsed = (double)(clock() - start);
+        if (best < 0 || elapsed < best)
+            best = elapsed;
+    }
+
+    return best / LEVELS_PER_BATCH;
+}
+
+int main(void)
+{
+    static const editorconfig_allocator allocator = {
+        counting_malloc, counting_realloc, counting_free, NULL
+    };
+    double              times[DEPTH_COUNT];
+    int                 failure_count = 0;
+    size_t              i;
+
+    if (editorconfig_set_allocator(&allocator) != 0) {
+        fprintf(stderr, "Failed to set the allocator.\n");
+        return 1;
+    }
+
+    for (i = 0; i < DEPTH_COUNT; ++i) {
+        editorconfig_handle h = editorconfig_handle_init();
+        char*           path = make_path(depths[i]);
+        unsigned long   lookup_count;
+        unsigned long   expected_count;
+        int             err_num;
+
+        if (h == NULL) {
+            fprintf(stderr, "Failed to create the handle.\n");
+            return 1;
+        }
+
+        /* the first lookup sets up the memory the handle keeps */
+        err_num = editorconfig_parse(path, h);
+        allocation_count = 0;
+        if (err_num == 0)
+            err_num = editorconfig_parse(path, h);
+        lookup_count = allocation_count;
+        expected_count = strlen(path) > STACK_PATH_LEN ? 1 : 0;
+        if (err_num != 0) {
+            fprintf(stderr, "Depth %d: editorconfig_parse() returned %d\n",
+                    depths[i], err_num);
+            ++ failure_count;
+        } else if (lookup_count > expected_count) {
+            fprintf(stderr, "Depth %d: the lookup allocated memory %lu "
+                    "times instead of at most %lu.\n", depths[i],
+                    lookup_count, expected_count);
+            ++ failure_count;
+        }
+
+        times[i] = time_per_level(h, path, depths[i]);
+        printf("Depth %d: %lu allocations, %.3g clock ticks per level\n",
+                depths[i], lookup_count, times[i]);
+
+        editorconfig_handle_destroy(h);
+        free(path);
+    }
+
+    for (i = 1; i < DEPTH_COUNT; ++i) {
+        if (times[i] > times[0] * MAX_SLOWDOWN) {
+            fprintf(stderr, "Depth %d takes %.3g times longer per level "
+                    "than depth %d.\n", depths[i], times[i] / times[0],
+                    depths[0]);
+            ++ failure_count;
+        }
+    }
+
+    return failure_count == 0 ? 0 : 1;
+}
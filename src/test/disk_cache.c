@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Checks that a damaged or stale ec_disk_cache file is a miss, never a wrong
+ * value. A cache is written to the directory given as the argument, and then
+ * truncated, extended, corrupted one byte at a time, or stamped with another
+ * library version, and its entries are looked up with their own stamps and
+ * with changed ones.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <editorconfig/editorconfig.h>
+
+#include "ec_disk_cache.h"
+
+#define MAX_PATH_LEN        4096
+#define CACHE_NAME          "disk_cache-test.cache"
+
+typedef struct
+{
+    const char*         key;
+    size_t              value_size;
+} test_entry;
+
+/* keys which are paths and keys which are not, with values of several sizes */
+static const test_entry entries[] = {
+    { "/editorconfig-disk-cache-test/.editorconfig", 200 },
+    { "/editorconfig-disk-cache-test/sub/.editorconfig", 7 },
+    { "[*.{c,h}]", 64 },
+    { "[Makefile]", 1 },
+};
+
+#define ENTRY_COUNT         ((int)(sizeof(entries) / sizeof(entries[0])))
+
+/* The stamps are made up, since the cache ignores the files changed in the
+ * last few seconds */
+static const ec_file_stamp stamp = { 1, 2, 3, 1000000000, 4, 1000000000, 5 };
+
+/* The fixed memory build allocates nothing until it is given an allocator */
+static void* test_malloc(size_t size, void* user)
+{
+    (void)user;
+    return malloc(size);
+}
+
+static void* test_realloc(void* ptr, size_t size, void* user)
+{
+    (void)user;
+    return realloc(ptr, size);
+}
+
+static void test_free(void* ptr, void* user)
+{
+    (void)user;
+    free(ptr);
+}
+
+static char             cache_path[MAX_PATH_LEN];
+
+/*
+ * Fill value with the value_size bytes of the value of entry n.
+ */
+static void make_value(unsigned char* value, int n)
+{
+    size_t              i;
+
+    for (i = 0; i < entries[n].value_size; ++i)
+        value[i] = (unsigned char)(n * 31 + i * 7 + 1);
+}
+
+/*
+ * Write a cache holding the entries, with stamp. Return 0 if successful.
+ */
+static int write_cache(void)
+{
+    unsigned char       value[256];
+    ec_disk_cache       cache;
+    int                 i;
+
+    remove(cache_path);
+    if (ec_disk_cache_open(&cache, cache_path) != 0)
+        return -1;
+    for (i = 0; i < ENTRY_COUNT; ++i) {
+        make_value(value, i);
+        if (ec_disk_cache_add(&cache, entries[i].key, &stamp, value,
+                    entries[i].value_size) != 0) {
+            ec_disk_cache_close(&cache);
+            return -1;
+        }
+    }
+
+    return ec_disk_cache_close(&cache);
+}
+
+/*
+ * Replace the cache file with the size bytes of data. Exit if it fails.
+ */
+static void write_bytes(const unsigned char* data, size_t size)
+{
+    FILE*               f = fopen(cache_path, "wb");
+
+    if (f == NULL || fwrite(data, 1, size, f) != size || fclose(f) != 0) {
+        fprintf(stderr, "Failed to write \"%s\".\n", cache_path);
+        exit(2);
+    }
+}
+
+/*
+ * Read the cache file into *data, which must be freed. Return its size, and
+ * exit if it fails.
+ */
+static size_t read_bytes(unsigned char** data)
+{
+    FILE*               f = fopen(cache_path, "rb");
+    long                size;
+
+    if (f == NULL || fseek(f, 0, SEEK_END) != 0 || (size = ftell(f)) <= 0 ||
+            fseek(f, 0, SEEK_SET) != 0 ||
+            (*data = (unsigned char*)malloc((size_t)size)) == NULL ||
+            fread(*data, 1, (size_t)size, f) != (size_t)size) {
+        fprintf(stderr, "Failed to read \"%s\".\n", cache_path);
+        exit(2);
+    }
+    fclose(f);
+
+    return (size_t)size;
+}
+
+/*
+ * Look up the entries in the cache file with key_stamp. Return the number of
+ * entries found, or -1 if one of them has a wrong value.
+ */
+static int count_hits(const ec_file_stamp* key_stamp, const char* label)
+{
+    unsigned char       expected[256];
+    ec_disk_cache       cache;
+    int                 hit_count = 0;
+    int                 i;
+
+    if (ec_disk_cache_open(&cache, cache_path) != 0) {
+        fprintf(stderr, "%s: failed to open the cache\n", label);
+        exit(1);
+    }
+    for (i = 0; i < ENTRY_COUNT; ++i) {
+        const void*     value;
+        size_t          value_size;
+
+        if (ec_disk_cache_find(&cache, entries[i].key, key_stamp, &value,
+                    &value_size) != 0)
+            continue;
+
+        make_value(expected, i);
+        if (value_size != entries[i].value_size ||
+                memcmp(value, expected, value_size)) {
+            fprintf(stderr, "%s: wrong value for \"%s\"\n", label,
+                    entries[i].key);
+            hit_count = -1;
+            break;
+        }
+        ++ hit_count;
+    }
+    ec_disk_cache_close(&cache);
+
+    return hit_count;
+}
+
+/*
+ * Check that no entry of the cache file is found, and that none is wrong.
+ */
+static int check_misses(const ec_file_stamp* key_stamp, const char* label)
+{
+    int                 hit_count = count_hits(key_stamp, label);
+
+    if (hit_count > 0)
+        fprintf(stderr, "%s: %d entries found\n", label, hit_count);
+
+    return hit_count != 0;
+}
+
+/*
+ * Return the offset of the library version in the cache file, or -1 if it is
+ * not in its header.
+ */
+static long find_version(const unsigned char* data, size_t size)
+{
+    const uint32_t      version[3] = {
+        EC_VERSION_MAJOR, EC_VERSION_MINOR, EC_VERSION_PATCH
+    };
+    size_t              offset;
+
+    for (offset = 0; offset < 64 && offset + sizeof(version) <= size;
+            offset += 4)
+        if (!memcmp(data + offset, version, sizeof(version)))
+            return (long)offset;
+
+    return -1;
+}
+
+int main(int argc, const char* argv[])
+{
+    static const editorconfig_allocator allocator = {
+        test_malloc, test_realloc, test_free, NULL
+    };
+    unsigned char*      data;
+    size_t              size;
+    size_t              offset;
+    ec_file_stamp       changed;
+    char                label[64];
+    long                version;
+    int                 failure_count = 0;
+    int                 field;
+    int                 i;
+
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s WORK_DIR\n", argv[0]);
+        return 2;
+    }
+    if (snprintf(cache_path, MAX_PATH_LEN, "%s/" CACHE_NAME, argv[1]) >=
+            MAX_PATH_LEN) {
+        fprintf(stderr, "The work directory path is too long.\n");
+        return 2;
+    }
+    if (editorconfig_set_allocator(&allocator) != 0) {
+        fprintf(stderr, "Failed to set the allocator.\n");
+        return 1;
+    }
+
+    if (write_cache() != 0) {
+        fprintf(stderr, "Failed to write the cache.\n");
+        return 1;
+    }
+    size = read_bytes(&data);
+    if (count_hits(&stamp, "intact") != ENTRY_COUNT) {
+        fprintf(stderr, "The entries of the intact cache are not found.\n");
+        ++ failure_count;
+    }
+
+    /* each field of the stamp, as if the file had changed */
+    for (field = 0; field < 7; ++field) {
+        changed = stamp;
+        switch (field) {
+        case 0: ++ changed.dev; break;
+        case 1: ++ changed.ino; break;
+        case 2: ++ changed.size; break;
+        case 3: ++ changed.mtime_sec; break;
+        case 4: ++ changed.mtime_nsec; break;
+        case 5: ++ changed.ctime_sec; break;
+        case 6: ++ changed.ctime_nsec; break;
+        }
+        snprintf(label, sizeof(label), "stamp field %d changed", field);
+        failure_count += check_misses(&changed, label);
+    }
+
+    /* truncated at the end of each block of 8 bytes and at the last byte */
+    for (offset = 0; offset < size; offset += 8) {
+        write_bytes(data, offset);
+        snprintf(label, sizeof(label), "truncated to %lu bytes",
+                (unsigned long)offset);
+        failure_count += check_misses(&stamp, label);
+    }
+    write_bytes(data, size - 1);
+    failure_count += check_misses(&stamp, "truncated by one byte");
+
+    data = (unsigned char*)realloc(data, size + 8);
+    memset(data + size, 0, 8);
+    write_bytes(data, size + 8);
+    failure_count += check_misses(&stamp, "extended");
+
+    /* another version of the library */
+    version = find_version(data, size);
+    if (version < 0) {
+        fprintf(stderr, "The library version is not in the header.\n");
+        ++ failure_count;
+    } else {
+        for (i = 0; i < 3; ++i) {
+            uint32_t*   part = (uint32_t*)(data + version) + i;
+
+            ++ *part;
+            write_bytes(data, size);
+            snprintf(label, sizeof(label), "version part %d changed", i);
+            failure_count += check_misses(&stamp, label);
+            -- *part;
+        }
+    }
+
+    /* a damaged byte may leave the entry intact, but never changes it */
+    for (offset = 0; offset < size; ++offset) {
+        data[offset] ^= 0xff;
+        write_bytes(data, size);
+        snprintf(label, sizeof(label), "byte %lu corrupted",
+                (unsigned long)offset);
+        if (count_hits(&stamp, label) < 0)
+            ++ failure_count;
+        data[offset] ^= 0xff;
+    }
+
+    free(data);
+    remove(cache_path);
+
+    return failure_count == 0 ? 0 : 1;
+}
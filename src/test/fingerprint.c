@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Checks the hashes of editorconfig_handle_get_fingerprint(). EditorConfig
+ * files are written to the directory given as the argument, each with its own
+ * name set with editorconfig_handle_set_conf_file_name(). properties_hash
+ * must only depend on the properties, and sources_hash must change when an
+ * EditorConfig file the properties come from changes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <editorconfig/editorconfig.h>
+
+#define MAX_PATH_LEN        4096
+
+/* Two EditorConfig files giving the same properties to the .c files */
+#define FIRST_CONF_NAME     ".editorconfig-fingerprint-1"
+#define FIRST_CONF          "root = true\n\n[*.c]\nindent_style = space\n" \
+    "indent_size = 4\n\n[*.h]\nindent_size = 2\n"
+#define SECOND_CONF_NAME    ".editorconfig-fingerprint-2"
+#define SECOND_CONF         "root = true\n\n[*]\nindent_style = space\n" \
+    "indent_size = 4\n"
+
+/* Added to the first EditorConfig file, without changing the properties */
+#define COMMENT             "# a comment\n"
+
+typedef struct
+{
+    uint64_t            properties_hash;
+    uint64_t            sources_hash;
+} fingerprint;
+
+/* The fixed memory build allocates nothing until it is given an allocator */
+static void* test_malloc(size_t size, void* user)
+{
+    (void)user;
+    return malloc(size);
+}
+
+static void* test_realloc(void* ptr, size_t size, void* user)
+{
+    (void)user;
+    return realloc(ptr, size);
+}
+
+static void test_free(void* ptr, void* user)
+{
+    (void)user;
+    free(ptr);
+}
+
+static const char*      work_dir;
+
+/*
+ * Write the path of name in the work directory to path, and exit if it is too
+ * long.
+ */
+static void make_path(char* path, const char* name)
+{
+    int                 len = snprintf(path, MAX_PATH_LEN, "%s/%s", work_dir,
+            name);
+
+    if (len < 0 || len >= MAX_PATH_LEN) {
+        fprintf(stderr, "The work directory path is too long.\n");
+        exit(2);
+    }
+}
+
+static void write_file(const char* name, const char* content)
+{
+    char                path[MAX_PATH_LEN];
+    FILE*               f;
+
+    make_path(path, name);
+    f = fopen(path, "w");
+    if (f == NULL || fputs(content, f) == EOF || fclose(f) != 0) {
+        fprintf(stderr, "Failed to write \"%s\".\n", path);
+        exit(2);
+    }
+}
+
+static void remove_file(const char* name)
+{
+    char                path[MAX_PATH_LEN];
+
+    make_path(path, name);
+    remove(path);
+}
+
+/*
+ * Parse the file name of the work directory with h, whose EditorConfig files
+ * are named conf_name, and return its fingerprint. Exit if it fails.
+ */
+static fingerprint get_fingerprint(editorconfig_handle h,
+        const char* conf_name, const char* name)
+{
+    char                path[MAX_PATH_LEN];
+    fingerprint         fp;
+    int                 err_num;
+
+    make_path(path, name);
+    editorconfig_handle_set_conf_file_name(h, conf_name);
+    err_num = editorconfig_parse(path, h);
+    if (err_num != 0) {
+        fprintf(stderr, "%s: editorconfig_parse() returned %d\n", name,
+                err_num);
+        exit(1);
+    }
+    if (editorconfig_handle_get_fingerprint(h, &fp.properties_hash,
+                &fp.sources_hash) != 0) {
+        fprintf(stderr, "%s: no fingerprint\n", name);
+        exit(1);
+    }
+
+    return fp;
+}
+
+/*
+ * Return the 64-bit FNV-1a hash of the names and values of the last file
+ * parsed with h, each followed by a null character, as documented.
+ */
+static uint64_t hash_properties(editorconfig_handle h)
+{
+    int                 count = editorconfig_handle_get_name_value_count(h);
+    uint64_t            hash = 0xcbf29ce484222325ULL;
+    int                 i;
+
+    for (i = 0; i < count; ++i) {
+        const char*     strings[2];
+        int             j;
+
+        editorconfig_handle_get_name_value(h, i, &strings[0], &strings[1]);
+        for (j = 0; j < 2; ++j) {
+            const char* p = strings[j];
+
+            do {
+                hash ^= (unsigned char)*p;
+                hash *= 0x100000001b3ULL;
+            } while (*p++ != '\0');
+        }
+    }
+
+    return hash;
+}
+
+static int check(int condition, const char* message)
+{
+    if (!condition)
+        fprintf(stderr, "%s\n", message);
+
+    return !condition;
+}
+
+int main(int argc, const char* argv[])
+{
+    static const editorconfig_allocator allocator = {
+        test_malloc, test_realloc, test_free, NULL
+    };
+    editorconfig_handle h;
+    editorconfig_handle other;
+    fingerprint         c_file;
+    fingerprint         other_c_file;
+    fingerprint         h_file;
+    fingerprint         second_conf;
+    fingerprint         other_handle;
+    fingerprint         edited;
+    uint64_t            properties_hash;
+    int                 failure_count = 0;
+
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s WORK_DIR\n", argv[0]);
+        return 2;
+    }
+    work_dir = argv[1];
+    if (editorconfig_set_allocator(&allocator) != 0) {
+        fprintf(stderr, "Failed to set the allocator.\n");
+        return 1;
+    }
+
+    write_file(FIRST_CONF_NAME, FIRST_CONF);
+    write_file(SECOND_CONF_NAME, SECOND_CONF);
+    h = editorconfig_handle_init();
+    other = editorconfig_handle_init();
+    if (h == NULL || other == NULL) {
+        fprintf(stderr, "Failed to create the handles.\n");
+        return 1;
+    }
+
+    failure_count += check(editorconfig_handle_get_fingerprint(h,
+                &properties_hash, NULL) == -1,
+            "A fingerprint was returned before any parsing.");
+
+    c_file = get_fingerprint(h, FIRST_CONF_NAME, "a.c");
+    failure_count += check(c_file.properties_hash == hash_properties(h),
+            "properties_hash is not the hash of the properties.");
+    other_c_file = get_fingerprint(h, FIRST_CONF_NAME, "b.c");
+    h_file = get_fingerprint(h, FIRST_CONF_NAME, "a.h");
+    second_conf = get_fingerprint(h, SECOND_CONF_NAME, "a.c");
+    other_handle = get_fingerprint(other, FIRST_CONF_NAME, "a.c");
+
+    failure_count += check(
+            other_c_file.properties_hash == c_file.properties_hash &&
+            other_c_file.sources_hash == c_file.sources_hash,
+            "Two files of the same section have different fingerprints.");
+    failure_count += check(h_file.properties_hash != c_file.properties_hash &&
+            h_file.sources_hash == c_file.sources_hash,
+            "Files with other properties have the same properties_hash.");
+    failure_count += check(
+            second_conf.properties_hash == c_file.properties_hash,
+            "The same properties from another EditorConfig file have "
+            "another properties_hash.");
+    failure_count += check(second_conf.sources_hash != c_file.sources_hash,
+            "Another EditorConfig file has the same sources_hash.");
+    failure_count += check(
+            other_handle.properties_hash == c_file.properties_hash &&
+            other_handle.sources_hash == c_file.sources_hash,
+            "Another handle gives another fingerprint.");
+
+    /* only the EditorConfig file changes, not the properties */
+    write_file(FIRST_CONF_NAME, FIRST_CONF COMMENT);
+    edited = get_fingerprint(h, FIRST_CONF_NAME, "a.c");
+    failure_count += check(edited.properties_hash == c_file.properties_hash,
+            "Editing a comment changed properties_hash.");
+    failure_count += check(edited.sources_hash != c_file.sources_hash,
+            "Editing the EditorConfig file did not change sources_hash.");
+    edited = get_fingerprint(h, SECOND_CONF_NAME, "a.c");
+    failure_count += check(edited.sources_hash == second_conf.sources_hash,
+            "Editing an unrelated EditorConfig file changed sources_hash.");
+
+    editorconfig_handle_destroy(h);
+    editorconfig_handle_destroy(other);
+    remove_file(FIRST_CONF_NAME);
+    remove_file(SECOND_CONF_NAME);
+
+    return failure_count == 0 ? 0 : 1;
+}
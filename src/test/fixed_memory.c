@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Checks that the static library built with BUILD_FIXED_MEMORY_STATIC_LIB
+ * never calls malloc(). The allocation functions of the C library are
+ * replaced by ones that count their calls while the library is used, and
+ * serve the other calls from a static block. The properties of the files of
+ * the fixture tree given as the argument are then checked.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <editorconfig/editorconfig.h>
+
+/* The memory of the replaced allocation functions, which is never freed */
+#define POOL_SIZE           (1024 * 1024)
+
+/* The memory given to editorconfig_set_memory() */
+#define MEMORY_SIZE         (64 * 1024)
+
+#define MAX_PATH_LEN        4096
+
+#define ALIGNMENT           16
+
+typedef struct
+{
+    const char*         path;
+    /* the properties, as printed by the editorconfig command */
+    const char*         properties;
+} test_case;
+
+static const test_case  cases[] = {
+    { "a.c", "end_of_line=lf\nindent_style=space\nindent_size=4\n"
+        "tab_width=4\n" },
+    { "file2.txt", "end_of_line=lf\ncharset=utf-8\n" },
+    { "file4.txt", "end_of_line=lf\n" },
+    { "Makefile", "end_of_line=lf\nindent_style=tab\nindent_size=tab\n" },
+    { "sub/b.c", "end_of_line=lf\nindent_style=space\nindent_size=2\n"
+        "tab_width=2\n" },
+    { "sub/test/x/y.py", "end_of_line=lf\nindent_style=space\n" },
+};
+
+#define CASE_COUNT          (sizeof(cases) / sizeof(cases[0]))
+
+static unsigned char    pool[POOL_SIZE];
+static size_t           pool_used;
+
+static int              is_counting;
+static unsigned long    allocation_count;
+
+/*
+ * Return size bytes of the pool, preceded by their size, or NULL if the pool
+ * is exhausted.
+ */
+static void* pool_alloc(size_t size)
+{
+    unsigned char*      p;
+
+    if (size > POOL_SIZE - pool_used - ALIGNMENT)
+        return NULL;
+
+    p = pool + pool_used;
+    memcpy(p, &size, sizeof(size));
+    pool_used += ALIGNMENT + (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+    return p + ALIGNMENT;
+}
+
+void* malloc(size_t size)
+{
+    if (is_counting)
+        ++ allocation_count;
+    return pool_alloc(size);
+}
+
+void* calloc(size_t count, size_t size)
+{
+    if (is_counting)
+        ++ allocation_count;
+    if (size != 0 && count > (size_t)-1 / size)
+        return NULL;
+    /* the pool is never reused, so it is still zeroed */
+    return pool_alloc(count * size);
+}
+
+void* realloc(void* ptr, size_t size)
+{
+    void*               p;
+    size_t              old_size;
+
+    if (is_counting)
+        ++ allocation_count;
+    p = pool_alloc(size);
+    if (p != NULL && ptr != NULL) {
+        memcpy(&old_size, (unsigned char*)ptr - ALIGNMENT, sizeof(old_size));
+        memcpy(p, ptr, old_size < size ? old_size : size);
+    }
+
+    return p;
+}
+
+void free(void* ptr)
+{
+    (void)ptr;
+}
+
+/*
+ * Write the properties of the last file parsed with h to buffer, as printed
+ * by the editorconfig command.
+ */
+static void get_properties(editorconfig_handle h, char* buffer, size_t size)
+{
+    int                 count = editorconfig_handle_get_name_value_count(h);
+    size_t              len = 0;
+    int                 i;
+
+    buffer[0] = '\0';
+    for (i = 0; i < count; ++i) {
+        const char*     name;
+        const char*     value;
+        int             written;
+
+        editorconfig_handle_get_name_value(h, i, &name, &value);
+        written = snprintf(buffer + len, size - len, "%s=%s\n", name, value);
+        if (written < 0 || (size_t)written >= size - len)
+            return;
+        len += (size_t)written;
+    }
+}
+
+int main(int argc, const char* argv[])
+{
+    static char         memory[MEMORY_SIZE];
+    static char         paths[CASE_COUNT][MAX_PATH_LEN];
+    static char         properties[CASE_COUNT][256];
+    int                 errors[CASE_COUNT];
+    editorconfig_handle h;
+    int                 failure_count = 0;
+    int                 pass;
+    size_t              i;
+
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s FIXTURE_DIR\n", argv[0]);
+        return 2;
+    }
+
+    for (i = 0; i < CASE_COUNT; ++i) {
+        int             len = snprintf(paths[i], MAX_PATH_LEN, "%s/%s",
+                argv[1], cases[i].path);
+
+        if (len < 0 || len >= MAX_PATH_LEN) {
+            fprintf(stderr, "The fixture directory path is too long.\n");
+            return 2;
+        }
+    }
+
+    /* stdout allocates its buffer when it is first used */
+    printf("Parsing %d files twice\n", (int)CASE_COUNT);
+    fflush(stdout);
+
+    is_counting = 1;
+    if (editorconfig_set_memory(memory, sizeof(memory)) != 0) {
+        is_counting = 0;
+        fprintf(stderr, "The memory block is too small.\n");
+        return 1;
+    }
+    h = editorconfig_handle_init();
+    if (h != NULL) {
+        /* the second pass takes the files from the directory cache */
+        editorconfig_handle_set_directory_cache(h, 1);
+        for (pass = 0; pass < 2; ++pass) {
+            for (i = 0; i < CASE_COUNT; ++i) {
+                errors[i] = editorconfig_parse(paths[i], h);
+                if (errors[i] == 0)
+                    get_properties(h, properties[i],
+                            sizeof(properties[i]));
+            }
+        }
+        editorconfig_handle_destroy(h);
+    }
+    is_counting = 0;
+
+    if (h == NULL) {
+        fprintf(stderr, "Failed to create the handle.\n");
+        return 1;
+    }
+    for (i = 0; i < CASE_COUNT; ++i) {
+        if (errors[i] != 0) {
+            fprintf(stderr, "%s: editorconfig_parse() returned %d\n",
+                    cases[i].path, errors[i]);
+            ++ failure_count;
+        } else if (strcmp(properties[i], cases[i].properties) != 0) {
+            fprintf(stderr, "%s: expected\n%sgot\n%s", cases[i].path,
+                    cases[i].properties, properties[i]);
+            ++ failure_count;
+        }
+    }
+    if (allocation_count != 0) {
+        fprintf(stderr, "The library allocated memory %lu times.\n",
+                allocation_count);
+        ++ failure_count;
+    }
+
+    return failure_count == 0 ? 0 : 1;
+}
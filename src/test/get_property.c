@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Checks the values returned by editorconfig_get_property() for the files of
+ * the fixture tree given as the argument: the values of tab_width and
+ * indent_size derived from each other, indent_size=tab, the search stopping
+ * at root=true, and the same value as editorconfig_parse() in every case.
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <editorconfig/editorconfig.h>
+
+#define MAX_PATH_LEN        4096
+
+typedef struct
+{
+    const char*         path;
+    /* the version set with editorconfig_handle_set_version(), or 0.0.0 for
+     * the current one */
+    int                 major;
+    int                 minor;
+    int                 patch;
+    const char*         name;
+    /* NULL if the property is not set */
+    const char*         value;
+} test_case;
+
+static const test_case  cases[] = {
+    /* tab_width from indent_size */
+    { "size.c", 0, 0, 0, "indent_size", "4" },
+    { "size.c", 0, 0, 0, "tab_width", "4" },
+    { "size_width.c", 0, 0, 0, "tab_width", "8" },
+    { "width.c", 0, 0, 0, "indent_size", NULL },
+    /* indent_size from indent_style and tab_width */
+    { "style_tab.c", 0, 0, 0, "indent_size", "tab" },
+    { "style_tab.c", 0, 8, 0, "indent_size", NULL },
+    { "style_tab.c", 0, 0, 0, "tab_width", NULL },
+    { "style_tab_width.c", 0, 0, 0, "indent_size", "8" },
+    { "style_tab_width.c", 0, 8, 0, "indent_size", NULL },
+    /* indent_size=tab */
+    { "size_tab.c", 0, 0, 0, "indent_size", "tab" },
+    { "size_tab.c", 0, 0, 0, "tab_width", NULL },
+    { "size_tab.c", 0, 8, 0, "tab_width", "tab" },
+    { "size_tab_width.c", 0, 0, 0, "indent_size", "3" },
+    { "size_tab_width.c", 0, 8, 0, "indent_size", "tab" },
+    /* the names are case insensitive, the special values lowercased */
+    { "mixed_case.c", 0, 0, 0, "INDENT_STYLE", "space" },
+    { "mixed_case.c", 0, 0, 0, "end_of_line", "crlf" },
+    { "overridden.c", 0, 0, 0, "indent_size", "3" },
+    { "overridden.c", 0, 0, 0, "not_set", NULL },
+    /* the parent EditorConfig file is read, unless root=true */
+    { "sub/file.c", 0, 0, 0, "indent_size", "8" },
+    { "sub/file.c", 0, 0, 0, "tab_width", "8" },
+    { "sub/file.c", 0, 0, 0, "charset", "utf-8" },
+    { "rooted/file.c", 0, 0, 0, "indent_size", "2" },
+    { "rooted/file.c", 0, 0, 0, "charset", NULL },
+};
+
+#define CASE_COUNT          (sizeof(cases) / sizeof(cases[0]))
+
+/* The fixed memory build allocates nothing until it is given an allocator */
+static void* test_malloc(size_t size, void* user)
+{
+    (void)user;
+    return malloc(size);
+}
+
+static void* test_realloc(void* ptr, size_t size, void* user)
+{
+    (void)user;
+    return realloc(ptr, size);
+}
+
+static void test_free(void* ptr, void* user)
+{
+    (void)user;
+    free(ptr);
+}
+
+/*
+ * Return the value of name after the last editorconfig_parse() with h, or
+ * NULL if it is not set. name is compared case insensitively.
+ */
+static const char* find_parsed_value(editorconfig_handle h, const char* name)
+{
+    int                 count = editorconfig_handle_get_name_value_count(h);
+    int                 i;
+
+    for (i = 0; i < count; ++i) {
+        const char*     parsed_name;
+        const char*     value;
+        size_t          j;
+
+        editorconfig_handle_get_name_value(h, i, &parsed_name, &value);
+        for (j = 0; name[j] != '\0' && parsed_name[j] != '\0'; ++j)
+            if (tolower((unsigned char)name[j]) != parsed_name[j])
+                break;
+        if (name[j] == '\0' && parsed_name[j] == '\0')
+            return value;
+    }
+
+    return NULL;
+}
+
+static const char* show(const char* value)
+{
+    return value != NULL ? value : "(not set)";
+}
+
+int main(int argc, const char* argv[])
+{
+    static const editorconfig_allocator allocator = {
+        test_malloc, test_realloc, test_free, NULL
+    };
+    static char         path[MAX_PATH_LEN];
+    int                 failure_count = 0;
+    size_t              i;
+
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s FIXTURE_DIR\n", argv[0]);
+        return 2;
+    }
+    if (editorconfig_set_allocator(&allocator) != 0) {
+        fprintf(stderr, "Failed to set the allocator.\n");
+        return 1;
+    }
+
+    for (i = 0; i < CASE_COUNT; ++i) {
+        const test_case*    tc = &cases[i];
+        editorconfig_handle h = editorconfig_handle_init();
+        const char*     value;
+        const char*     parsed_value;
+        int             len;
+        int             err_num;
+
+        if (h == NULL) {
+            fprintf(stderr, "Failed to create the handle.\n");
+            return 1;
+        }
+        len = snprintf(path, MAX_PATH_LEN, "%s/%s", argv[1], tc->path);
+        if (len < 0 || len >= MAX_PATH_LEN) {
+            fprintf(stderr, "The fixture directory path is too long.\n");
+            return 2;
+        }
+        editorconfig_handle_set_version(h, tc->major, tc->minor, tc->patch);
+
+        err_num = editorconfig_get_property(path, h, tc->name, &value);
+        if (err_num != 0) {
+            fprintf(stderr, "%s %s %d.%d.%d: editorconfig_get_property() "
+                    "returned %d\n", tc->path, tc->name, tc->major,
+                    tc->minor, tc->patch, err_num);
+            ++ failure_count;
+        } else if (value == NULL ? tc->value != NULL :
+                tc->value == NULL || strcmp(value, tc->value) != 0) {
+            fprintf(stderr, "%s %s %d.%d.%d: expected %s, got %s\n",
+                    tc->path, tc->name, tc->major, tc->minor, tc->patch,
+                    show(tc->value), show(value));
+            ++ failure_count;
+        }
+
+        err_num = editorconfig_parse(path, h);
+        parsed_value = err_num == 0 ? find_parsed_value(h, tc->name) : NULL;
+        if (err_num != 0 || (parsed_value == NULL ? tc->value != NULL :
+                    tc->value == NULL || strcmp(parsed_value, tc->value))) {
+            fprintf(stderr, "%s %s %d.%d.%d: editorconfig_parse() returned "
+                    "%d and %s\n", tc->path, tc->name, tc->major, tc->minor,
+                    tc->patch, err_num, show(parsed_value));
+            ++ failure_count;
+        }
+
+        editorconfig_handle_destroy(h);
+    }
+
+    return failure_count == 0 ? 0 : 1;
+}
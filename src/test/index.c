@@ -0,0 +1,409 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Checks editorconfig_write_index() and editorconfig_handle_set_index(). A
+ * tree of EditorConfig files is written to the directory given as the
+ * argument, with an index. The index must give the properties of its tree, go
+ * on doing so when the tree and the index are copied elsewhere with their
+ * modification times, and never give wrong properties when it is damaged.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <utime.h>
+#include <sys/stat.h>
+#include <editorconfig/editorconfig.h>
+
+#define MAX_PATH_LEN        4096
+#define MAX_OUTPUT_LEN      4096
+#define TREE_NAME           "index-test"
+#define INDEX_NAME          ".editorconfig.idx"
+
+/* the number of damaged indexes checked */
+#define DAMAGED_COUNT       300
+
+/* the modification time of the EditorConfig files */
+#define CONF_MTIME          1000000000
+
+typedef struct
+{
+    const char*         path;
+    const char*         content;
+    /* the same content with other properties, of the same size */
+    const char*         edited_content;
+} conf_file;
+
+static const conf_file conf_files[] = {
+    { ".editorconfig",
+        "root = true\n\n[*]\nindent_size = 4\n\n[*.c]\nindent_style = tab\n",
+        "root = true\n\n[*]\nindent_size = 6\n\n[*.c]\nindent_style = tab\n" },
+    { "sub/.editorconfig",
+        "[*.c]\nindent_size = 8\ntab_width = 8\n",
+        "[*.c]\nindent_size = 2\ntab_width = 3\n" },
+};
+
+#define CONF_FILE_COUNT     ((int)(sizeof(conf_files) / sizeof(conf_files[0])))
+
+/* the files whose properties are checked */
+static const char* const files[] = {
+    "a.c", "a.h", "sub/b.c", "sub/b.txt", "sub/dir/c.c",
+};
+
+#define FILE_COUNT          ((int)(sizeof(files) / sizeof(files[0])))
+
+/* The fixed memory build allocates nothing until it is given an allocator */
+static void* test_malloc(size_t size, void* user)
+{
+    (void)user;
+    return malloc(size);
+}
+
+static void* test_realloc(void* ptr, size_t size, void* user)
+{
+    (void)user;
+    return realloc(ptr, size);
+}
+
+static void test_free(void* ptr, void* user)
+{
+    (void)user;
+    free(ptr);
+}
+
+/*
+ * Write to path the path of name in the directory dir, and exit if it is too
+ * long.
+ */
+static void make_path(char* path, const char* dir, const char* name)
+{
+    int                 len = snprintf(path, MAX_PATH_LEN, "%s/%s", dir, name);
+
+    if (len < 0 || len >= MAX_PATH_LEN) {
+        fprintf(stderr, "The work directory path is too long.\n");
+        exit(2);
+    }
+}
+
+/*
+ * Write size bytes of content to the file name of dir, with the modification
+ * time of the EditorConfig files. Exit if it fails.
+ */
+static void write_file(const char* dir, const char* name,
+        const void* content, size_t size)
+{
+    char                path[MAX_PATH_LEN];
+    struct utimbuf      times;
+    FILE*               f;
+
+    make_path(path, dir, name);
+    f = fopen(path, "wb");
+    times.actime = CONF_MTIME;
+    times.modtime = CONF_MTIME;
+    if (f == NULL || fwrite(content, 1, size, f) != size || fclose(f) != 0 ||
+            utime(path, &times) != 0) {
+        fprintf(stderr, "Failed to write \"%s\".\n", path);
+        exit(2);
+    }
+}
+
+/*
+ * Write the EditorConfig files to the tree dir, with their edited contents if
+ * is_edited is set.
+ */
+static void write_tree(const char* dir, int is_edited)
+{
+    char                path[MAX_PATH_LEN];
+    int                 i;
+
+    mkdir(dir, 0755);
+    make_path(path, dir, "sub");
+    mkdir(path, 0755);
+    for (i = 0; i < CONF_FILE_COUNT; ++i) {
+        const char*     content = is_edited ? conf_files[i].edited_content :
+            conf_files[i].content;
+
+        write_file(dir, conf_files[i].path, content, strlen(content));
+    }
+}
+
+static void remove_tree(const char* dir)
+{
+    char                path[MAX_PATH_LEN];
+    int                 i;
+
+    for (i = 0; i < CONF_FILE_COUNT; ++i) {
+        make_path(path, dir, conf_files[i].path);
+        remove(path);
+    }
+    make_path(path, dir, INDEX_NAME);
+    remove(path);
+    make_path(path, dir, "sub");
+    rmdir(path);
+    rmdir(dir);
+}
+
+/*
+ * Write the index of the tree dir. Return 0 if successful.
+ */
+static int write_index(const char* dir)
+{
+    char                paths[CONF_FILE_COUNT][MAX_PATH_LEN];
+    const char*         path_list[CONF_FILE_COUNT];
+    char                index_path[MAX_PATH_LEN];
+    int                 i;
+
+    for (i = 0; i < CONF_FILE_COUNT; ++i) {
+        make_path(paths[i], dir, conf_files[i].path);
+        path_list[i] = paths[i];
+    }
+    make_path(index_path, dir, INDEX_NAME);
+
+    return editorconfig_write_index(index_path, path_list, CONF_FILE_COUNT);
+}
+
+/*
+ * Read the file at path into *data, which must be freed. Return its size, and
+ * exit if it fails.
+ */
+static size_t read_file(const char* path, unsigned char** data)
+{
+    FILE*               f = fopen(path, "rb");
+    long                size;
+
+    if (f == NULL || fseek(f, 0, SEEK_END) != 0 || (size = ftell(f)) <= 0 ||
+            fseek(f, 0, SEEK_SET) != 0 ||
+            (*data = (unsigned char*)malloc((size_t)size)) == NULL ||
+            fread(*data, 1, (size_t)size, f) != (size_t)size) {
+        fprintf(stderr, "Failed to read \"%s\".\n", path);
+        exit(2);
+    }
+    fclose(f);
+
+    return (size_t)size;
+}
+
+/*
+ * Parse the files of the tree dir with a new handle, using its index if
+ * use_index is set, and write their properties to output. Return 0 if
+ * successful, and the error of the first file that fails otherwise.
+ */
+static int parse_files(const char* dir, int use_index, char* output)
+{
+    char                path[MAX_PATH_LEN];
+    editorconfig_handle h = editorconfig_handle_init();
+    size_t              len = 0;
+    int                 err_num = 0;
+    int                 i;
+    int                 j;
+
+    if (h == NULL)
+        return EDITORCONFIG_PARSE_MEMORY_ERROR;
+    if (use_index) {
+        make_path(path, dir, INDEX_NAME);
+        err_num = editorconfig_handle_set_index(h, path);
+    }
+
+    output[0] = '\0';
+    for (i = 0; err_num == 0 && i < FILE_COUNT; ++i) {
+        make_path(path, dir, files[i]);
+        err_num = editorconfig_parse(path, h);
+        for (j = 0; err_num == 0 &&
+                j < editorconfig_handle_get_name_value_count(h); ++j) {
+            const char* name;
+            const char* value;
+
+            editorconfig_handle_get_name_value(h, j, &name, &value);
+            len += (size_t)snprintf(output + len, MAX_OUTPUT_LEN - len,
+                    "%s: %s=%s\n", files[i], name, value);
+            if (len >= MAX_OUTPUT_LEN) {
+                fprintf(stderr, "The output is too long.\n");
+                exit(2);
+            }
+        }
+    }
+
+    editorconfig_handle_destroy(h);
+
+    return err_num;
+}
+
+/*
+ * Check that the files of the tree dir have the properties expected, as a
+ * label case, and return the number of failures.
+ */
+static int check_files(const char* dir, int use_index, const char* expected,
+        const char* label)
+{
+    char                output[MAX_OUTPUT_LEN];
+    int                 err_num = parse_files(dir, use_index, output);
+
+    if (err_num != 0) {
+        fprintf(stderr, "%s: editorconfig_parse() returned %d\n", label,
+                err_num);
+        return 1;
+    }
+    if (strcmp(output, expected)) {
+        fprintf(stderr, "%s: got\n%sexpected\n%s", label, output, expected);
+        return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * A linear congruential generator, so that the damaged indexes are the same
+ * on every run.
+ */
+static unsigned int next_random(unsigned int* state)
+{
+    *state = *state * 1103515245u + 12345u;
+    return (*state >> 16) & 0x7fff;
+}
+
+int main(int argc, const char* argv[])
+{
+    static const editorconfig_allocator allocator = {
+        test_malloc, test_realloc, test_free, NULL
+    };
+    char                tree_dir[MAX_PATH_LEN];
+    char                dir[MAX_PATH_LEN];
+    char                copy_dir[MAX_PATH_LEN];
+    char                index_path[MAX_PATH_LEN];
+    char                original[MAX_OUTPUT_LEN];
+    char                edited[MAX_OUTPUT_LEN];
+    char                label[64];
+    unsigned char*      index;
+    unsigned char*      damaged;
+    size_t              index_size;
+    unsigned int        state = 1;
+    int                 failure_count = 0;
+    int                 err_num;
+    int                 i;
+
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s WORK_DIR\n", argv[0]);
+        return 2;
+    }
+    make_path(tree_dir, argv[1], TREE_NAME);
+    make_path(dir, tree_dir, "tree");
+    make_path(copy_dir, tree_dir, "copy");
+    make_path(index_path, dir, INDEX_NAME);
+    if (editorconfig_set_allocator(&allocator) != 0) {
+        fprintf(stderr, "Failed to set the allocator.\n");
+        return 1;
+    }
+
+    /* the properties without an index, before and after the edits */
+    mkdir(tree_dir, 0755);
+    write_tree(dir, 1);
+    if (parse_files(dir, 0, edited) != 0) {
+        fprintf(stderr, "Failed to parse the edited tree.\n");
+        return 1;
+    }
+    write_tree(dir, 0);
+    if (parse_files(dir, 0, original) != 0) {
+        fprintf(stderr, "Failed to parse the tree.\n");
+        return 1;
+    }
+    if (!strcmp(original, edited)) {
+        fprintf(stderr, "The edits do not change the properties.\n");
+        return 1;
+    }
+
+    err_num = write_index(dir);
+    if (err_num != 0) {
+        fprintf(stderr, "editorconfig_write_index() returned %d\n", err_num);
+        return 1;
+    }
+    failure_count += check_files(dir, 1, original, "index");
+
+    /* The files of an index are only checked by size and modification time,
+     * so the edited files keep the indexed properties, which shows that the
+     * index is used */
+    write_tree(dir, 1);
+    failure_count += check_files(dir, 1, original, "edited tree");
+    failure_count += check_files(dir, 0, edited, "edited tree, no index");
+
+    /* the index still applies to a copy of the tree with its times, as made
+     * by cp -a */
+    index_size = read_file(index_path, &index);
+    write_tree(copy_dir, 1);
+    write_file(copy_dir, INDEX_NAME, index, index_size);
+    failure_count += check_files(copy_dir, 1, original, "copied tree");
+
+    /* a file of another size is parsed again, the others still come from
+     * the index */
+    write_file(copy_dir, conf_files[1].path, "[*.c]\n", 6);
+    failure_count += check_files(copy_dir, 1,
+            "a.c: indent_size=4\na.c: indent_style=tab\n"
+            "a.c: tab_width=4\n"
+            "a.h: indent_size=4\na.h: tab_width=4\n"
+            "sub/b.c: indent_size=4\nsub/b.c: indent_style=tab\n"
+            "sub/b.c: tab_width=4\n"
+            "sub/b.txt: indent_size=4\nsub/b.txt: tab_width=4\n"
+            "sub/dir/c.c: indent_size=4\nsub/dir/c.c: indent_style=tab\n"
+            "sub/dir/c.c: tab_width=4\n",
+            "resized file");
+    write_tree(copy_dir, 0);
+    failure_count += check_files(copy_dir, 1, original, "restored copy");
+
+    write_tree(dir, 0);
+
+    /* damaged indexes, truncated or with a few bytes changed, which may be
+     * ignored, but must never change the properties */
+    damaged = (unsigned char*)malloc(index_size);
+    if (damaged == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        return 1;
+    }
+    for (i = 0; i < DAMAGED_COUNT; ++i) {
+        size_t          size = index_size;
+        int             j;
+
+        memcpy(damaged, index, index_size);
+        if (i % 4 == 0) {
+            size = next_random(&state) % index_size;
+        } else {
+            for (j = 1 + i % 4; j > 0; --j)
+                damaged[next_random(&state) % index_size] ^=
+                    (unsigned char)(1 + next_random(&state) % 255);
+        }
+        write_file(dir, INDEX_NAME, damaged, size);
+        snprintf(label, sizeof(label), "damaged index %d", i);
+        failure_count += check_files(dir, 1, original, label);
+    }
+
+    free(damaged);
+    free(index);
+    remove_tree(dir);
+    remove_tree(copy_dir);
+    rmdir(tree_dir);
+
+    return failure_count == 0 ? 0 : 1;
+}
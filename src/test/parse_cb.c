@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Checks that editorconfig_parse_cb() gives the callback the same properties,
+ * in the same order, as editorconfig_parse() gives through the handle,
+ * including the ones added from indent_size, indent_style and tab_width, for
+ * the current version and for a version before 0.9. The calls to the
+ * allocator given to editorconfig_set_allocator() are counted to check that
+ * the properties are not allocated one by one.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <editorconfig/editorconfig.h>
+
+#define MAX_PATH_LEN        4096
+
+#define MAX_PROPERTIES_LEN  1024
+
+typedef struct
+{
+    const char*         path;
+    /* the version set with editorconfig_handle_set_version(), or 0.0.0 for
+     * the current one */
+    int                 major;
+    int                 minor;
+    int                 patch;
+    /* the properties, as printed by the editorconfig command */
+    const char*         properties;
+} test_case;
+
+static const test_case  cases[] = {
+    { "size.c", 0, 0, 0,
+        "charset=utf-8\nindent_size=4\ntab_width=4\n" },
+    { "size.c", 0, 8, 0,
+        "charset=utf-8\nindent_size=4\ntab_width=4\n" },
+    { "width.c", 0, 0, 0, "charset=utf-8\ntab_width=2\n" },
+    { "style_tab.c", 0, 0, 0,
+        "charset=utf-8\nindent_style=tab\nindent_size=tab\n" },
+    { "style_tab.c", 0, 8, 0, "charset=utf-8\nindent_style=tab\n" },
+    { "style_tab_width.c", 0, 0, 0,
+        "charset=utf-8\nindent_style=tab\ntab_width=8\nindent_size=8\n" },
+    { "style_tab_width.c", 0, 8, 0,
+        "charset=utf-8\nindent_style=tab\ntab_width=8\n" },
+    { "size_tab.c", 0, 0, 0, "charset=utf-8\nindent_size=tab\n" },
+    { "size_tab.c", 0, 8, 0,
+        "charset=utf-8\nindent_size=tab\ntab_width=tab\n" },
+    { "size_tab_width.c", 0, 0, 0,
+        "charset=utf-8\nindent_size=3\ntab_width=3\n" },
+    { "size_tab_width.c", 0, 8, 0,
+        "charset=utf-8\nindent_size=tab\ntab_width=3\n" },
+    { "size_width.c", 0, 0, 0,
+        "charset=utf-8\nindent_size=4\ntab_width=8\n" },
+    { "mixed_case.c", 0, 0, 0,
+        "charset=utf-8\nindent_style=space\nindent_size=2\n"
+        "end_of_line=crlf\ntab_width=2\n" },
+    { "overridden.c", 0, 0, 0,
+        "charset=utf-8\nindent_size=3\nend_of_line=lf\ntab_width=3\n" },
+};
+
+#define CASE_COUNT          (sizeof(cases) / sizeof(cases[0]))
+
+/* Files of the same EditorConfig file with few and many properties */
+#define FEW_PROPERTIES_PATH "size.c"
+#define MANY_PROPERTIES_PATH "many.c"
+
+/* The properties after which the callback stops in the early stop check */
+#define STOP_AFTER          2
+
+static unsigned long    allocation_count;
+
+static void* counting_malloc(size_t size, void* user)
+{
+    (void)user;
+    ++ allocation_count;
+    return malloc(size);
+}
+
+static void* counting_realloc(void* ptr, size_t size, void* user)
+{
+    (void)user;
+    ++ allocation_count;
+    return realloc(ptr, size);
+}
+
+static void counting_free(void* ptr, void* user)
+{
+    (void)user;
+    free(ptr);
+}
+
+/*
+ * The properties given to the callback, as printed by the editorconfig
+ * command.
+ */
+typedef struct
+{
+    char                text[MAX_PROPERTIES_LEN];
+    size_t              len;
+    int                 count;
+    /* the count after which the callback stops, or 0 */
+    int                 stop_count;
+    _Bool               is_bad_len;
+} collector;
+
+static int collect_property(const char* name, size_t name_len,
+        const char* value, size_t value_len, void* user)
+{
+    collector*          c = (collector*)user;
+    int                 written;
+
+    if (strlen(name) != name_len || strlen(value) != value_len)
+        c->is_bad_len = 1;
+    written = snprintf(c->text + c->len, sizeof(c->text) - c->len, "%s=%s\n",
+            name, value);
+    if (written > 0 && (size_t)written < sizeof(c->text) - c->len)
+        c->len += (size_t)written;
+    ++ c->count;
+
+    return c->stop_count != 0 && c->count == c->stop_count;
+}
+
+/*
+ * Write the properties of the last file parsed with h to buffer, as printed
+ * by the editorconfig command.
+ */
+static void get_properties(editorconfig_handle h, char* buffer, size_t size)
+{
+    int                 count = editorconfig_handle_get_name_value_count(h);
+    size_t              len = 0;
+    int                 i;
+
+    buffer[0] = '\0';
+    for (i = 0; i < count; ++i) {
+        const char*     name;
+        const char*     value;
+        int             written;
+
+        editorconfig_handle_get_name_value(h, i, &name, &value);
+        written = snprintf(buffer + len, size - len, "%s=%s\n", name, value);
+        if (written < 0 || (size_t)written >= size - len)
+            return;
+        len += (size_t)written;
+    }
+}
+
+/*
+ * Write the path of the fixture file name to path. Return 0 on success.
+ */
+static int make_path(char* path, const char* dir, const char* name)
+{
+    int                 len = snprintf(path, MAX_PATH_LEN, "%s/%s", dir, name);
+
+    return len < 0 || len >= MAX_PATH_LEN ? -1 : 0;
+}
+
+/*
+ * Check the properties of the case with a handle of its version. Return 1 if
+ * they are wrong, 0 otherwise.
+ */
+static int check_case(const test_case* tc, const char* dir)
+{
+    static char         path[MAX_PATH_LEN];
+    static char         properties[MAX_PROPERTIES_LEN];
+    static collector    c;
+    editorconfig_handle h;
+    int                 err_num;
+    int                 failure = 0;
+
+    if (make_path(path, dir, tc->path) != 0) {
+        fprintf(stderr, "The fixture directory path is too long.\n");
+        exit(2);
+    }
+    h = editorconfig_handle_init();
+    if (h == NULL) {
+        fprintf(stderr, "Failed to create the handle.\n");
+        exit(1);
+    }
+    editorconfig_handle_set_version(h, tc->major, tc->minor, tc->patch);
+
+    memset(&c, 0, sizeof(c));
+    err_num = editorconfig_parse_cb(path, h, collect_property, &c);
+    if (err_num != 0) {
+        fprintf(stderr, "%s %d.%d.%d: editorconfig_parse_cb() returned %d\n",
+                tc->path, tc->major, tc->minor, tc->patch, err_num);
+        failure = 1;
+    } else if (strcmp(c.text, tc->properties) != 0 || c.is_bad_len) {
+        fprintf(stderr, "%s %d.%d.%d: the callback expected\n%sgot\n%s",
+                tc->path, tc->major, tc->minor, tc->patch, tc->properties,
+                c.text);
+        failure = 1;
+    }
+
+    err_num = editorconfig_parse(path, h);
+    if (err_num != 0) {
+        fprintf(stderr, "%s %d.%d.%d: editorconfig_parse() returned %d\n",
+                tc->path, tc->major, tc->minor, tc->patch, err_num);
+        failure = 1;
+    } else {
+        get_properties(h, properties, sizeof(properties));
+        if (strcmp(properties, c.text) != 0) {
+            fprintf(stderr, "%s %d.%d.%d: editorconfig_parse() gave\n%s"
+                    "and the callback\n%s", tc->path, tc->major, tc->minor,
+                    tc->patch, properties, c.text);
+            failure = 1;
+        }
+    }
+
+    editorconfig_handle_destroy(h);
+
+    return failure;
+}
+
+/*
+ * Write the calls to the allocator made by the first and second parsings of
+ * the fixture file name with a new handle to counts[0] and counts[1]. Return
+ * the number of its properties, or -1 if the parsing fails.
+ */
+static int count_allocations(const char* dir, const char* name,
+        unsigned long counts[2])
+{
+    static char         path[MAX_PATH_LEN];
+    static collector    c;
+    editorconfig_handle h;
+    int                 i;
+
+    if (make_path(path, dir, name) != 0) {
+        fprintf(stderr, "The fixture directory path is too long.\n");
+        exit(2);
+    }
+    h = editorconfig_handle_init();
+    if (h == NULL) {
+        fprintf(stderr, "Failed to create the handle.\n");
+        exit(1);
+    }
+
+    for (i = 0; i < 2; ++i) {
+        memset(&c, 0, sizeof(c));
+        allocation_count = 0;
+        if (editorconfig_parse_cb(path, h, collect_property, &c) != 0)
+            c.count = -1;
+        counts[i] = allocation_count;
+    }
+
+    editorconfig_handle_destroy(h);
+
+    return c.count;
+}
+
+int main(int argc, const char* argv[])
+{
+    static const editorconfig_allocator allocator = {
+        counting_malloc, counting_realloc, counting_free, NULL
+    };
+    static char         path[MAX_PATH_LEN];
+    static collector    c;
+    unsigned long       few_counts[2];
+    unsigned long       many_counts[2];
+    int                 few_count;
+    int                 many_count;
+    editorconfig_handle h;
+    int                 failure_count = 0;
+    size_t              i;
+
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s FIXTURE_DIR\n", argv[0]);
+        return 2;
+    }
+    if (editorconfig_set_allocator(&allocator) != 0) {
+        fprintf(stderr, "Failed to set the allocator.\n");
+        return 1;
+    }
+
+    for (i = 0; i < CASE_COUNT; ++i)
+        failure_count += check_case(&cases[i], argv[1]);
+
+    /* stopping early is not an error */
+    if (make_path(path, argv[1], MANY_PROPERTIES_PATH) != 0) {
+        fprintf(stderr, "The fixture directory path is too long.\n");
+        return 2;
+    }
+    h = editorconfig_handle_init();
+    if (h == NULL) {
+        fprintf(stderr, "Failed to create the handle.\n");
+        return 1;
+    }
+    c.stop_count = STOP_AFTER;
+    if (editorconfig_parse_cb(path, h, collect_property, &c) != 0 ||
+            c.count != STOP_AFTER) {
+        fprintf(stderr, "The callback was called %d times instead of %d.\n",
+                c.count, STOP_AFTER);
+        ++ failure_count;
+    }
+    editorconfig_handle_destroy(h);
+
+    /* the same EditorConfig file is parsed for both files, so that only the
+     * number of properties differs */
+    few_count = count_allocations(argv[1], FEW_PROPERTIES_PATH, few_counts);
+    many_count = count_allocations(argv[1], MANY_PROPERTIES_PATH,
+            many_counts);
+    printf("%d properties: %lu then %lu allocations\n", few_count,
+            few_counts[0], few_counts[1]);
+    printf("%d properties: %lu then %lu allocations\n", many_count,
+            many_counts[0], many_counts[1]);
+    if (few_count < 0 || many_count <= few_count) {
+        fprintf(stderr, "Failed to parse the files of the allocation "
+                "check.\n");
+        ++ failure_count;
+    } else if (many_counts[0] != few_counts[0] || few_counts[1] != 0 ||
+            many_counts[1] != 0) {
+        fprintf(stderr, "The properties were allocated one by one.\n");
+        ++ failure_count;
+    }
+
+    return failure_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Checks the typed values of editorconfig_handle_get_properties() against a
+ * table of EditorConfig sections. The sections are written to an EditorConfig
+ * file in the directory given as the argument, one file name per case.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <editorconfig/editorconfig.h>
+
+#define MAX_PATH_LEN        4096
+#define CONF_NAME           ".editorconfig-properties"
+
+typedef struct
+{
+    /* the lines of the section of the case */
+    const char*         lines;
+    /* the property to check, and its expected value */
+    const char*         name;
+    int                 value;
+} test_case;
+
+#define UNSET               EDITORCONFIG_VALUE_UNSET
+
+static const test_case cases[] = {
+    /* integers */
+    { "indent_size = 4\n", "indent_size", 4 },
+    { "indent_size = 1\n", "indent_size", 1 },
+    { "indent_size = 2147483647\n", "indent_size", 2147483647 },
+    { "indent_size = 2147483648\n", "indent_size", UNSET },
+    { "indent_size = 0\n", "indent_size", UNSET },
+    { "tab_width = 00\n", "tab_width", UNSET },
+    { "indent_size = -2\n", "indent_size", UNSET },
+    { "indent_size = +2\n", "indent_size", UNSET },
+    { "indent_size = 2.5\n", "indent_size", UNSET },
+    { "indent_size = 4x\n", "indent_size", UNSET },
+    { "indent_size = four\n", "indent_size", UNSET },
+    { "indent_size = tab\n", "indent_size", EDITORCONFIG_VALUE_TAB },
+    { "indent_size = TAB\n", "indent_size", EDITORCONFIG_VALUE_TAB },
+    { "indent_size = tab\ntab_width = 3\n", "indent_size", 3 },
+    { "indent_size = unset\n", "indent_size", UNSET },
+    { "indent_size = 4\nindent_size = unset\n", "indent_size", UNSET },
+    { "tab_width = 8\n", "tab_width", 8 },
+    { "tab_width = tab\n", "tab_width", UNSET },
+    { "tab_width = unset\n", "tab_width", UNSET },
+    { "indent_size = 5\n", "tab_width", 5 },
+    { "indent_size = tab\n", "tab_width", UNSET },
+    { "max_line_length = 80\n", "max_line_length", 80 },
+    { "max_line_length = off\n", "max_line_length", EDITORCONFIG_VALUE_OFF },
+    { "max_line_length = OFF\n", "max_line_length", EDITORCONFIG_VALUE_OFF },
+    { "max_line_length = none\n", "max_line_length", UNSET },
+    { "max_line_length = unset\n", "max_line_length", UNSET },
+    /* enumerations */
+    { "indent_style = tab\n", "indent_style", EDITORCONFIG_INDENT_STYLE_TAB },
+    { "indent_style = Tab\n", "indent_style", EDITORCONFIG_INDENT_STYLE_TAB },
+    { "indent_style = space\n", "indent_style",
+        EDITORCONFIG_INDENT_STYLE_SPACE },
+    { "indent_style = spaces\n", "indent_style",
+        EDITORCONFIG_INDENT_STYLE_UNSET },
+    { "indent_style = unset\n", "indent_style",
+        EDITORCONFIG_INDENT_STYLE_UNSET },
+    { "indent_style = tab\nindent_style = unset\n", "indent_style",
+        EDITORCONFIG_INDENT_STYLE_UNSET },
+    { "end_of_line = lf\n", "end_of_line", EDITORCONFIG_END_OF_LINE_LF },
+    { "end_of_line = CRLF\n", "end_of_line", EDITORCONFIG_END_OF_LINE_CRLF },
+    { "end_of_line = cr\n", "end_of_line", EDITORCONFIG_END_OF_LINE_CR },
+    { "end_of_line = lfcr\n", "end_of_line", EDITORCONFIG_END_OF_LINE_UNSET },
+    { "end_of_line = unset\n", "end_of_line",
+        EDITORCONFIG_END_OF_LINE_UNSET },
+    { "charset = latin1\n", "charset", EDITORCONFIG_CHARSET_LATIN1 },
+    { "charset = utf-8\n", "charset", EDITORCONFIG_CHARSET_UTF_8 },
+    { "charset = UTF-8\n", "charset", EDITORCONFIG_CHARSET_UTF_8 },
+    { "charset = utf-8-bom\n", "charset", EDITORCONFIG_CHARSET_UTF_8_BOM },
+    { "charset = utf-16be\n", "charset", EDITORCONFIG_CHARSET_UTF_16BE },
+    { "charset = utf-16le\n", "charset", EDITORCONFIG_CHARSET_UTF_16LE },
+    { "charset = utf8\n", "charset", EDITORCONFIG_CHARSET_UNSET },
+    { "charset = unset\n", "charset", EDITORCONFIG_CHARSET_UNSET },
+    /* tristates */
+    { "trim_trailing_whitespace = true\n", "trim_trailing_whitespace",
+        EDITORCONFIG_BOOL_TRUE },
+    { "trim_trailing_whitespace = FALSE\n", "trim_trailing_whitespace",
+        EDITORCONFIG_BOOL_FALSE },
+    { "trim_trailing_whitespace = yes\n", "trim_trailing_whitespace",
+        EDITORCONFIG_BOOL_UNSET },
+    { "trim_trailing_whitespace = unset\n", "trim_trailing_whitespace",
+        EDITORCONFIG_BOOL_UNSET },
+    { "insert_final_newline = false\n", "insert_final_newline",
+        EDITORCONFIG_BOOL_FALSE },
+    { "insert_final_newline = True\n", "insert_final_newline",
+        EDITORCONFIG_BOOL_TRUE },
+    { "insert_final_newline = 1\n", "insert_final_newline",
+        EDITORCONFIG_BOOL_UNSET },
+    { "insert_final_newline = true\ninsert_final_newline = unset\n",
+        "insert_final_newline", EDITORCONFIG_BOOL_UNSET },
+    /* properties that are not set */
+    { "charset = utf-8\n", "indent_style", EDITORCONFIG_INDENT_STYLE_UNSET },
+    { "charset = utf-8\n", "indent_size", UNSET },
+    { "charset = utf-8\n", "max_line_length", UNSET },
+    { "charset = utf-8\n", "insert_final_newline", EDITORCONFIG_BOOL_UNSET },
+};
+
+#define CASE_COUNT          ((int)(sizeof(cases) / sizeof(cases[0])))
+
+/* The fixed memory build allocates nothing until it is given an allocator */
+static void* test_malloc(size_t size, void* user)
+{
+    (void)user;
+    return malloc(size);
+}
+
+static void* test_realloc(void* ptr, size_t size, void* user)
+{
+    (void)user;
+    return realloc(ptr, size);
+}
+
+static void test_free(void* ptr, void* user)
+{
+    (void)user;
+    free(ptr);
+}
+
+/*
+ * Return the typed value of the property name of properties, an enumeration
+ * value as an int.
+ */
+static int get_value(const editorconfig_properties* properties,
+        const char* name)
+{
+    if (!strcmp(name, "indent_style"))
+        return (int)properties->indent_style;
+    if (!strcmp(name, "indent_size"))
+        return properties->indent_size;
+    if (!strcmp(name, "tab_width"))
+        return properties->tab_width;
+    if (!strcmp(name, "end_of_line"))
+        return (int)properties->end_of_line;
+    if (!strcmp(name, "charset"))
+        return (int)properties->charset;
+    if (!strcmp(name, "trim_trailing_whitespace"))
+        return (int)properties->trim_trailing_whitespace;
+    if (!strcmp(name, "insert_final_newline"))
+        return (int)properties->insert_final_newline;
+    if (!strcmp(name, "max_line_length"))
+        return properties->max_line_length;
+
+    fprintf(stderr, "Unknown property \"%s\".\n", name);
+    exit(2);
+}
+
+/*
+ * Return nonzero if all the properties of properties are unset.
+ */
+static int all_unset(const editorconfig_properties* properties)
+{
+    return properties->indent_style == EDITORCONFIG_INDENT_STYLE_UNSET &&
+        properties->indent_size == UNSET &&
+        properties->tab_width == UNSET &&
+        properties->end_of_line == EDITORCONFIG_END_OF_LINE_UNSET &&
+        properties->charset == EDITORCONFIG_CHARSET_UNSET &&
+        properties->trim_trailing_whitespace == EDITORCONFIG_BOOL_UNSET &&
+        properties->insert_final_newline == EDITORCONFIG_BOOL_UNSET &&
+        properties->max_line_length == UNSET;
+}
+
+/*
+ * Write the EditorConfig file of the cases to conf_path, with a section for
+ * the file "<index>.c" of each case.
+ */
+static int write_conf_file(const char* conf_path)
+{
+    FILE*               f = fopen(conf_path, "w");
+    int                 i;
+
+    if (f == NULL)
+        return -1;
+
+    fputs("root = true\n", f);
+    for (i = 0; i < CASE_COUNT; ++i)
+        fprintf(f, "\n[%d.c]\n%s", i, cases[i].lines);
+
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+int main(int argc, const char* argv[])
+{
+    static const editorconfig_allocator allocator = {
+        test_malloc, test_realloc, test_free, NULL
+    };
+    char                conf_path[MAX_PATH_LEN];
+    char                path[MAX_PATH_LEN];
+    editorconfig_handle h;
+    int                 failure_count = 0;
+    int                 i;
+
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s WORK_DIR\n", argv[0]);
+        return 2;
+    }
+    if (snprintf(conf_path, MAX_PATH_LEN, "%s/" CONF_NAME, argv[1]) >=
+            MAX_PATH_LEN) {
+        fprintf(stderr, "The work directory path is too long.\n");
+        return 2;
+    }
+    if (write_conf_file(conf_path) != 0) {
+        fprintf(stderr, "Failed to write \"%s\".\n", conf_path);
+        return 2;
+    }
+    if (editorconfig_set_allocator(&allocator) != 0) {
+        fprintf(stderr, "Failed to set the allocator.\n");
+        return 1;
+    }
+
+    h = editorconfig_handle_init();
+    if (h == NULL) {
+        fprintf(stderr, "Failed to create the handle.\n");
+        return 1;
+    }
+    editorconfig_handle_set_conf_file_name(h, CONF_NAME);
+
+    if (!all_unset(editorconfig_handle_get_properties(h))) {
+        fprintf(stderr, "Properties are set before any parsing.\n");
+        ++ failure_count;
+    }
+    if (!all_unset(editorconfig_result_get_properties(NULL))) {
+        fprintf(stderr, "Properties of no result are set.\n");
+        ++ failure_count;
+    }
+
+    for (i = 0; i < CASE_COUNT; ++i) {
+        const test_case*    tc = &cases[i];
+        int                 err_num;
+        int                 value;
+
+        snprintf(path, MAX_PATH_LEN, "%s/%d.c", argv[1], i);
+        err_num = editorconfig_parse(path, h);
+        if (err_num != 0) {
+            fprintf(stderr, "case %d: editorconfig_parse() returned %d\n",
+                    i, err_num);
+            ++ failure_count;
+            continue;
+        }
+
+        value = get_value(editorconfig_handle_get_properties(h), tc->name);
+        if (value != tc->value) {
+            fprintf(stderr, "case %d: %s is %d, expected %d, from:\n%s",
+                    i, tc->name, value, tc->value, tc->lines);
+            ++ failure_count;
+        }
+        if (get_value(editorconfig_result_get_properties(
+                        editorconfig_handle_get_result(h)), tc->name) !=
+                value) {
+            fprintf(stderr, "case %d: the result has another %s\n",
+                    i, tc->name);
+            ++ failure_count;
+        }
+    }
+
+    editorconfig_handle_destroy(h);
+    remove(conf_path);
+
+    return failure_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2026 EditorConfig Team
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Checks that the compiled regexes of the glob patterns, once decoded from the
+ * persistent cache with pcre2_serialize_decode(), match exactly like freshly
+ * compiled ones, and that they are only decoded from a cache of the same
+ * PCRE2 version owned by the user. The cache is written to the directory
+ * given as the argument.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <editorconfig/editorconfig.h>
+
+/* global.h sets the code unit width of PCRE2 */
+#include "global.h"
+
+#include <pcre2.h>
+
+#include "ec_glob.h"
+
+#define MAX_PATH_LEN        4096
+#define CACHE_NAME          "regex_cache-test.cache"
+
+/* The patterns whose regexes are cached, which are the longer ones, and a
+ * short one which is always compiled */
+static const char* const patterns[] = {
+    "/editorconfig-regex-cache-test/**/{*.c,*.h,*.cpp,*.hpp,*.cc,*.hh}",
+    "/editorconfig-regex-cache-test/src/**/test_{1..12}/[a-m]*.{js,ts}",
+    "/editorconfig-regex-cache-test/**/[!.]*{-min,-debug}.{css,scss}",
+    "/editorconfig-regex-cache-test/{lib,bin}/**/?akefile{,.in,.am}",
+    "/editorconfig-regex-cache-test/**/\\{braces\\}/*.{c,{-3..3}}",
+    "*.c",
+};
+
+#define PATTERN_COUNT       ((int)(sizeof(patterns) / sizeof(patterns[0])))
+
+/* the strings each pattern is matched against */
+static const char* const strings[] = {
+    "/editorconfig-regex-cache-test/a.c",
+    "/editorconfig-regex-cache-test/x/y/z.hh",
+    "/editorconfig-regex-cache-test/a.cxx",
+    "/editorconfig-regex-cache-test/src/test_7/app.ts",
+    "/editorconfig-regex-cache-test/src/a/test_12/main.js",
+    "/editorconfig-regex-cache-test/src/test_13/app.js",
+    "/editorconfig-regex-cache-test/src/test_1/zoo.js",
+    "/editorconfig-regex-cache-test/www/site-min.css",
+    "/editorconfig-regex-cache-test/www/.site-min.css",
+    "/editorconfig-regex-cache-test/site-debug.scss",
+    "/editorconfig-regex-cache-test/lib/Makefile.am",
+    "/editorconfig-regex-cache-test/bin/x/makefile",
+    "/editorconfig-regex-cache-test/src/Makefile",
+    "/editorconfig-regex-cache-test/{braces}/x.-3",
+    "/editorconfig-regex-cache-test/{braces}/x.4",
+    "/editorconfig-regex-cache-test/braces/x.c",
+    "/other/a.c",
+    "",
+};
+
+#define STRING_COUNT        ((int)(sizeof(strings) / sizeof(strings[0])))
+
+/* The fixed memory build allocates nothing until it is given an allocator */
+static void* test_malloc(size_t size, void* user)
+{
+    (void)user;
+    return malloc(size);
+}
+
+static void* test_realloc(void* ptr, size_t size, void* user)
+{
+    (void)user;
+    return realloc(ptr, size);
+}
+
+static void test_free(void* ptr, void* user)
+{
+    (void)user;
+    free(ptr);
+}
+
+static char             cache_path[MAX_PATH_LEN];
+
+/* the results of matching each string with each freshly compiled pattern */
+static int              expected[PATTERN_COUNT][STRING_COUNT];
+
+/*
+ * Compile the patterns, with the cache file if use_cache is set, and match
+ * each string with them. Set *expected to the results if is_expected is set,
+ * and compare them to *expected otherwise. Return the number of failures, and
+ * set *added_count to the number of regexes added to the cache.
+ */
+static int match_patterns(int use_cache, int is_expected, size_t* added_count,
+        const char* label)
+{
+    ec_disk_cache       disk_cache;
+    ec_glob_cache       cache;
+    int                 failure_count = 0;
+    int                 i;
+    int                 j;
+
+    cache.cache = &disk_cache;
+    if (use_cache && ec_disk_cache_open(&disk_cache, cache_path) != 0) {
+        fprintf(stderr, "%s: failed to open the cache\n", label);
+        exit(1);
+    }
+
+    for (i = 0; i < PATTERN_COUNT; ++i) {
+        ec_glob_pattern*    glob;
+
+        if (ec_glob_compile(patterns[i], use_cache ? &cache : NULL,
+                    &glob) != 0) {
+            fprintf(stderr, "%s: failed to compile \"%s\"\n", label,
+                    patterns[i]);
+            exit(1);
+        }
+        for (j = 0; j < STRING_COUNT; ++j) {
+            int         rc = ec_glob_match(glob, strings[j]);
+
+            if (is_expected) {
+                expected[i][j] = rc;
+            } else if (rc != expected[i][j]) {
+                fprintf(stderr, "%s: \"%s\" with \"%s\" gives %d instead of "
+                        "%d\n", label, strings[j], patterns[i], rc,
+                        expected[i][j]);
+                ++ failure_count;
+            }
+        }
+        ec_glob_free(glob);
+    }
+
+    *added_count = use_cache ? disk_cache.count : 0;
+    if (use_cache)
+        ec_disk_cache_close(&disk_cache);
+
+    return failure_count;
+}
+
+/*
+ * Change the PCRE2 version in the keys of the cache file, as if it had been
+ * written with another version. Return the number of keys changed.
+ */
+static int change_version(void)
+{
+    char                version[64];
+    char                prefix[80];
+    unsigned char*      data;
+    FILE*               f;
+    long                size;
+    size_t              prefix_len;
+    size_t              offset;
+    int                 count = 0;
+
+    pcre2_config(PCRE2_CONFIG_VERSION, version);
+    snprintf(prefix, sizeof(prefix), "pcre2 %s\n", version);
+    prefix_len = strlen(prefix);
+
+    f = fopen(cache_path, "r+b");
+    if (f == NULL || fseek(f, 0, SEEK_END) != 0 || (size = ftell(f)) <= 0 ||
+            fseek(f, 0, SEEK_SET) != 0 ||
+            (data = (unsigned char*)malloc((size_t)size)) == NULL ||
+            fread(data, 1, (size_t)size, f) != (size_t)size) {
+        fprintf(stderr, "Failed to read \"%s\".\n", cache_path);
+        exit(2);
+    }
+
+    for (offset = 0; offset + prefix_len <= (size_t)size; ++offset) {
+        if (memcmp(data + offset, prefix, prefix_len))
+            continue;
+        /* the last character of the version */
+        data[offset + prefix_len - 2] ^= 0x01;
+        ++ count;
+    }
+
+    if (fseek(f, 0, SEEK_SET) != 0 ||
+            fwrite(data, 1, (size_t)size, f) != (size_t)size ||
+            fclose(f) != 0) {
+        fprintf(stderr, "Failed to write \"%s\".\n", cache_path);
+        exit(2);
+    }
+    free(data);
+
+    return count;
+}
+
+/*
+ * Check that the regexes are decoded from the cache file, or that they are not
+ * if is_ignored is set, and that they match like freshly compiled ones. Return
+ * the number of failures.
+ */
+static int check_cache(int is_ignored, const char* label)
+{
+    size_t              added_count;
+    int                 failure_count = match_patterns(1, 0, &added_count,
+            label);
+
+    if (is_ignored && added_count == 0) {
+        fprintf(stderr, "%s: the regexes were decoded\n", label);
+        ++ failure_count;
+    } else if (!is_ignored && added_count != 0) {
+        fprintf(stderr, "%s: %lu regexes were not decoded\n", label,
+                (unsigned long)added_count);
+        ++ failure_count;
+    }
+
+    return failure_count;
+}
+
+int main(int argc, const char* argv[])
+{
+    static const editorconfig_allocator allocator = {
+        test_malloc, test_realloc, test_free, NULL
+    };
+    size_t              added_count;
+    int                 failure_count = 0;
+
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s WORK_DIR\n", argv[0]);
+        return 2;
+    }
+    if (snprintf(cache_path, MAX_PATH_LEN, "%s/" CACHE_NAME, argv[1]) >=
+            MAX_PATH_LEN) {
+        fprintf(stderr, "The work directory path is too long.\n");
+        return 2;
+    }
+    if (editorconfig_set_allocator(&allocator) != 0) {
+        fprintf(stderr, "Failed to set the allocator.\n");
+        return 1;
+    }
+
+    match_patterns(0, 1, &added_count, "fresh");
+
+    /* the regexes are compiled and added to the new cache */
+    remove(cache_path);
+    failure_count += match_patterns(1, 0, &added_count, "new cache");
+    if (added_count == 0) {
+        fprintf(stderr, "No regex was added to the cache.\n");
+        ++ failure_count;
+    }
+
+    failure_count += check_cache(0, "decoded");
+
+    /* the cache, and the regexes it now holds again, are ignored */
+    if (change_version() == 0) {
+        fprintf(stderr, "The PCRE2 version is not in the cache keys.\n");
+        ++ failure_count;
+    }
+    failure_count += check_cache(1, "other PCRE2 version");
+    failure_count += check_cache(0, "decoded again");
+
+    chmod(cache_path, 0622);
+    failure_count += check_cache(1, "writable by others");
+    failure_count += check_cache(0, "rewritten");
+
+    /* only root can give the cache to another user */
+    if (getuid() == 0) {
+        if (chown(cache_path, 1, (gid_t)-1) != 0) {
+            fprintf(stderr, "Failed to change the owner of the cache.\n");
+            ++ failure_count;
+        }
+        failure_count += check_cache(1, "other owner");
+    }
+
+    remove(cache_path);
+
+    return failure_count == 0 ? 0 : 1;
+}